@@ -16,6 +16,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#ifndef __RDKCONFIG_MOCK__
+#define __RDKCONFIG_MOCK__
+
 #define RDKCONFIG_OK 0
 #define RDKCONFIG_FAIL 1
 
@@ -28,5 +31,18 @@ int rdkconfig_free( uint8_t **sbuff, size_t sbuffsz );
 int rdkconfig_freeStr( char **sbuff, size_t sbuffsz );
 
 int rdkconfig_getStr( char **sbuff, size_t *sbuffsz, const char *refname );
+
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len );
+
+typedef struct rdkconfig_buf_s {
+  uint8_t *buf;
+  size_t len;
+  int status;
+} rdkconfig_buf_t;
+
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] );
+
+int rdkconfig_freeMany( rdkconfig_buf_t out[], size_t n );
 #define memset_s( b,z1,v,z2 ) memset( b,v,z2)
 
+#endif // __RDKCONFIG_MOCK__
@@ -55,7 +55,7 @@ class CertLocatorTest : public ::testing::Test {
   }
 
   void TearDown() override {
-    free(tstcl);
+    rdkcertlocator_free(&tstcl);
   }
 
   rdkcertlocator_h tstcl;
@@ -116,6 +116,43 @@ TEST_F(CertLocatorTest, ValidCases) {
   EXPECT_EQ(certloc_locateCert(tstcl, "MISNG"), certlocatorFileNotFound);
 }
 
+TEST_F(CertLocatorTest, RefIndex) {
+  const char *cfg = UTDIR "/tst1refindex.cfg";
+  FILE *fp = fopen(cfg, "w");
+  ASSERT_NE(fp, nullptr);
+  fprintf(fp, "GRP1,FRST,TMP,file://%s,pc1\n", UTCERT1);
+  fprintf(fp, "GRP2\n");
+  fprintf(fp, "GRP2,FRST,TMP,file://%s,pc2\n", UTCERT2);
+  fprintf(fp, "GRP3,THRD,TMP,file://%s,pc3\n", UTCERT3);
+  fclose(fp);
+
+  ut_initcl(tstcl);
+  strncpy(tstcl->certSelPath, cfg, PATH_MAX);
+  EXPECT_EQ(certloc_locateCert(tstcl, "THRD"), certlocatorOk);
+  ASSERT_NE(tstcl->certSnap, nullptr);
+  EXPECT_NE(tstcl->certSnap->refIndex, nullptr);
+  EXPECT_STREQ(tstcl->certCredRef, "pc3");
+
+  // first row with the ref wins
+  EXPECT_EQ(certloc_locateCert(tstcl, "FRST"), certlocatorOk);
+  EXPECT_STREQ(tstcl->certUri, FILESCHEME UTCERT1);
+  EXPECT_STREQ(tstcl->certCredRef, "pc1");
+  EXPECT_EQ(certloc_locateCert(tstcl, "GRP2"), certlocatorFileNotFound);
+  EXPECT_EQ(certloc_locateCert(tstcl, "FRS"), certlocatorFileNotFound);
+
+  // config changed, new image gets a new index
+  rdkcertcfgSnap_t *snap = tstcl->certSnap;
+  fp = fopen(cfg, "w");
+  ASSERT_NE(fp, nullptr);
+  fprintf(fp, "GRP2,FRST,TMP,file://%s,pc2\n", UTCERT2);
+  fclose(fp);
+  EXPECT_EQ(certloc_locateCert(tstcl, "FRST"), certlocatorOk);
+  EXPECT_NE(tstcl->certSnap, snap);
+  EXPECT_STREQ(tstcl->certCredRef, "pc2");
+  EXPECT_EQ(certloc_locateCert(tstcl, "THRD"), certlocatorFileNotFound);
+  remove(cfg);
+}
+
 class CertLocatorNewTest : public ::testing::Test {
 };
 
@@ -325,3 +362,70 @@ TEST_F(CertLocateCertTest, ValidCases) {
 
   rdkcertlocator_free(&tstcl1);
 }
+
+TEST_F(CertLocateCertTest, LocateCerts) {
+  const char *refs[] = { "FRST", "SCND", "NOREF", "THRD", "NOPC", "FRST", "ALPHA" };
+  size_t refCnt = sizeof(refs)/sizeof(refs[0]);
+  rdkcertlocatorResult_t results[sizeof(refs)/sizeof(refs[0])];
+
+  EXPECT_EQ(rdkcertlocator_locateCerts(NULL, refs, refCnt, results), certlocatorBadPointer);
+  rdkcertlocator_h tstcl1 = rdkcertlocator_new(certsel_path, DEFAULT_HROT);
+  EXPECT_EQ(rdkcertlocator_locateCerts(tstcl1, refs, refCnt, NULL), certlocatorBadArgument);
+  EXPECT_EQ(rdkcertlocator_locateCerts(tstcl1, NULL, 0, NULL), certlocatorOk);
+
+  // one credential fetch per distinct credential reference
+  ut_getStrCnt = 0;
+  ut_getManyCnt = 0;
+  EXPECT_EQ(rdkcertlocator_locateCerts(tstcl1, refs, refCnt, results), certlocatorFileNotFound);
+  EXPECT_EQ(ut_getStrCnt, 5);
+  EXPECT_EQ(ut_getManyCnt, 1);  // together in one call
+  EXPECT_EQ(results[0].status, certlocatorOk);
+  EXPECT_STREQ(results[0].certUri, "file://./ut/tst1first.tmp");
+  EXPECT_STREQ(results[0].certPass, "pc1pass");
+  EXPECT_EQ(results[1].status, certlocatorOk);
+  EXPECT_STREQ(results[1].certUri, "file://./ut/tst1second.tmp");
+  EXPECT_STREQ(results[1].certPass, "pc2pass");
+  EXPECT_EQ(results[2].status, certlocatorFileNotFound);
+  EXPECT_EQ(results[3].status, certlocatorOk);
+  EXPECT_STREQ(results[3].certPass, "pc3pass");
+  EXPECT_EQ(results[4].status, certlocatorFileError);
+  EXPECT_EQ(results[5].status, certlocatorOk);
+  EXPECT_STREQ(results[5].certPass, "pc1pass");
+  EXPECT_EQ(results[6].status, certlocatorOk);
+  EXPECT_STREQ(results[6].certCredRef, "pcalpha");
+
+  // a missing cert file only fails the refs that use it
+  UT_SYSTEM0("mv " UTCERT2 " ./ut/tstXsecond.tmp");
+  const char *refs2[] = { "SCND", "THRD" };
+  EXPECT_EQ(rdkcertlocator_locateCerts(tstcl1, refs2, 2, results), certlocatorFileNotFound);
+  EXPECT_EQ(results[0].status, certlocatorFileNotFound);
+  EXPECT_EQ(results[1].status, certlocatorOk);
+  UT_SYSTEM0("mv ./ut/tstXsecond.tmp " UTCERT2);
+
+  rdkcertlocator_wipeResults(results, refCnt);
+  EXPECT_STREQ(results[0].certPass, "");
+  rdkcertlocator_free(&tstcl1);
+}
+
+TEST_F(CertLocateCertTest, AutoReload) {
+  EXPECT_EQ(rdkcertlocator_enableAutoReload(NULL), certlocatorBadPointer);
+  rdkcertlocator_h tstcl1 = rdkcertlocator_new(certsel_path, HROT_PROP);
+  EXPECT_EQ(rdkcertlocator_enableAutoReload(tstcl1), certlocatorOk);
+  EXPECT_STREQ(rdkcertlocator_getEngine(tstcl1), "e4tst1");
+
+  char *certUri = NULL;
+  char *certPass = NULL;
+  EXPECT_EQ(rdkcertlocator_locateCert(tstcl1, "SCND", &certUri, &certPass), certlocatorOk);
+  EXPECT_STREQ(certUri, "file://./ut/tst1second.tmp");
+  EXPECT_STREQ(certPass, "pc2pass");
+
+  // config and cert metadata are reused, no file syscalls
+  rdkcertlocatorCounters_t before, after;
+  rdkcertlocator_getCounters(&before);
+  EXPECT_EQ(rdkcertlocator_locateCert(tstcl1, "SCND", &certUri, &certPass), certlocatorOk);
+  rdkcertlocator_getCounters(&after);
+  EXPECT_EQ(after.statCalls - before.statCalls, 0u);
+  EXPECT_EQ(after.openCalls - before.openCalls, 0u);
+  EXPECT_EQ(after.metaHits - before.metaHits, 1u);
+  rdkcertlocator_free(&tstcl1);
+}
@@ -21,8 +21,14 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/pkcs12.h>
+#include <openssl/x509.h>
 #include "./mock/mock.cpp"
 #include "./mock/mock.h"
 #include "./../src/rdkcertselector.c"
@@ -173,7 +179,7 @@ protected:
     }
 
     void TearDown() override {
-        free(tstcs);
+        rdkcertselector_free(&tstcs);
     }
 };
 
@@ -251,6 +257,929 @@ TEST_F(CertSelFindCertTest, ValidIndexTests) {
     EXPECT_EQ(certsel_findCert(tstcs), certselectorFileNotFound);
 }
 
+TEST_F(CertSelFindCertTest, ConfigTableTests) {
+    const char *cfg = UTDIR "/tst1table.cfg";
+    FILE *fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "TSTGRP1,FRST,TMP,file://%s,pc1\n", UTCERT1);
+    fclose(fp);
+
+    ut_initcs(tstcs);
+    strncpy(tstcs->certSelPath, cfg, PATH_MAX);
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    ASSERT_NE(tstcs->certTable, nullptr);
+    EXPECT_EQ(tstcs->certTable->candCnt, 1);
+    const rdkcertcfgRow_t *cand = &tstcs->certTable->snap->rows[tstcs->certTable->cand[0]];
+    EXPECT_TRUE(rdkcertcfg_fieldIs(tstcs->certTable->snap, cand, CERTCFG_FLD_LABEL, "FRST"));
+    EXPECT_TRUE(rdkcertcfg_fieldIs(tstcs->certTable->snap, cand, CERTCFG_FLD_TYPE, "TMP"));
+    EXPECT_FALSE(rdkcertcfg_fieldIs(tstcs->certTable->snap, cand, CERTCFG_FLD_TYPE, "TM"));
+
+    // unchanged config, image is reused
+    rdkcertcfgSnap_t *snap = tstcs->certTable->snap;
+    tstcs->certIndx = 1;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorFileNotFound);
+    EXPECT_EQ(tstcs->certTable->snap, snap);
+    EXPECT_EQ(tstcs->certTable->candCnt, 1);
+
+    // a second handle on the same config shares the image
+    rdkcertselector_h tstcs2 = ut_newcs();
+    strncpy(tstcs2->certSelPath, cfg, PATH_MAX);
+    EXPECT_EQ(certsel_findCert(tstcs2), certselectorOk);
+    EXPECT_EQ(tstcs2->certTable->cfg, tstcs->certTable->cfg);
+    EXPECT_EQ(tstcs2->certTable->snap, snap);
+    EXPECT_EQ(snap->refCnt, 3u); // entry and two handles
+    rdkcertselector_free(&tstcs2);
+    EXPECT_EQ(snap->refCnt, 2u);
+
+    // config changed, image and table are rebuilt
+    fp = fopen(cfg, "a");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "TSTGRP1,SCND,TMP,file://%s,pc2\n", UTCERT2);
+    fclose(fp);
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    EXPECT_EQ(tstcs->certTable->candCnt, 2);
+    EXPECT_STREQ(tstcs->certUri, FILESCHEME UTCERT2);
+    EXPECT_STREQ(tstcs->certCredRef, "pc2");
+
+    // different group, table is rebuilt
+    strncpy(tstcs->certGroup, GRP3, PARAM_MAX);
+    tstcs->certIndx = 0;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorFileNotFound);
+    EXPECT_EQ(tstcs->certTable->candCnt, 0);
+
+    // config removed
+    remove(cfg);
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorFileNotFound);
+}
+
+TEST_F(CertSelFindCertTest, ParseFileTests) {
+    const char *cfg = UTDIR "/tst1parse.cfg";
+    const int maxline = 1024;  // maxline of the parser
+    char line[maxline + 1];
+    char uri[PATH_MAX + 1], credref[PARAM_MAX + 1];
+    FILE *fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, ",,TSTGRP1,,FRST,TMP,,file://%s,pc1,extra\n\n,,,\n", UTCERT1);
+    fwrite("TSTGRP2,NUL\0,HIDDEN\n", 1, 20, fp);
+    memset(line, 'x', maxline - 2);  // longest line that fits, with its newline
+    line[0] = 'T';
+    line[maxline - 2] = '\0';
+    fprintf(fp, "%s\n", line);
+    fclose(fp);
+
+    rdkcertcfgSnap_t *snap = rdkcertcfg_parseFile(cfg);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_EQ(snap->endStat, certcfgFileNotFound);
+    ASSERT_EQ(snap->rowCnt, 3u);
+    EXPECT_EQ(snap->rows[0].fieldCnt, CERTCFG_FLD_CNT);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, &snap->rows[0], CERTCFG_FLD_GROUP, "TSTGRP1"));
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, &snap->rows[0], CERTCFG_FLD_CREDREF, "pc1"));
+    EXPECT_EQ(rdkcertcfg_rowCert(snap, &snap->rows[0], uri, PATH_MAX, credref, PARAM_MAX), certcfgOk);
+    EXPECT_STREQ(uri, FILESCHEME UTCERT1);
+    EXPECT_STREQ(credref, "pc1");
+    EXPECT_EQ(rdkcertcfg_rowCert(snap, &snap->rows[0], NULL, PATH_MAX, NULL, 3), certcfgFileError);
+    EXPECT_EQ(snap->rows[1].fieldCnt, 2);  // line ends at a null
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, &snap->rows[1], CERTCFG_FLD_LABEL, "NUL"));
+    EXPECT_EQ(snap->rows[2].fieldLen[CERTCFG_FLD_GROUP], maxline - 2);
+    rdkcertcfg_release(&snap);
+
+    // one more character is too long, rows before it are kept
+    fp = fopen(cfg, "a");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "%sx\nTSTGRP1,LAST,TMP,file://%s,pc2\n", line, UTCERT2);
+    fclose(fp);
+    snap = rdkcertcfg_parseFile(cfg);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_EQ(snap->endStat, certcfgFileError);
+    EXPECT_EQ(snap->rowCnt, 3u);
+    rdkcertcfg_release(&snap);
+
+    // large file is parsed from a mapping
+    fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    int lineIndx;
+    for (lineIndx = 0; lineIndx < 1000; lineIndx++) {
+        fprintf(fp, "TSTGRP%d,REF%d,TMP,file://%s,pc%d\n", lineIndx % 7, lineIndx, UTCERT1, lineIndx);
+    }
+    fclose(fp);
+    snap = rdkcertcfg_parseFile(cfg);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_EQ(snap->rowCnt, 1000u);
+    const rdkcertcfgRow_t *row = rdkcertcfg_findRef(snap, "REF999");
+    ASSERT_NE(row, nullptr);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, row, CERTCFG_FLD_CREDREF, "pc999"));
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "TSTGRP6", &row, 1), 142u);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, row, CERTCFG_FLD_LABEL, "REF6"));
+    rdkcertcfg_release(&snap);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, GroupIndexTests) {
+    const char *cfg = UTDIR "/tst1groups.cfg";
+    const char *bin = UTDIR "/tst1groups.bin";
+    FILE *fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    // more than 10 groups on a line, and a group listed twice on a line
+    fprintf(fp, "G1|G2|G3|G4|G5|G6|G7|G8|G9|G10|G11|G12,MANY,TMP,file://%s,pc1\n", UTCERT1);
+    fprintf(fp, "G12||G12|X,DUP,TMP,file://%s,pc2\n", UTCERT2);
+    fprintf(fp, "X,LAST,TMP,file://%s,pc3\n", UTCERT3);
+    fclose(fp);
+
+    rdkcertcfgSnap_t *snap = rdkcertcfg_parseFile(cfg);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_EQ(snap->grpCnt, 0u);  // groups are only built as they are looked up
+    const rdkcertcfgRow_t *rows[LIST_MAX];
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G11", rows, LIST_MAX), 1u);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, rows[0], CERTCFG_FLD_LABEL, "MANY"));
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G12", rows, LIST_MAX), 2u);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, rows[1], CERTCFG_FLD_LABEL, "DUP"));
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G1", rows, LIST_MAX), 1u);  // not a prefix match of G11 or G12
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "NONE", rows, LIST_MAX), 0u);
+    // interning every group gives the same lists
+    EXPECT_EQ(rdkcertcfg_groupIndex(snap), 0);
+    EXPECT_EQ(snap->grpCnt, 13u);
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G12", rows, LIST_MAX), 2u);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, rows[1], CERTCFG_FLD_LABEL, "DUP"));
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "X", rows, 1), 2u);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, rows[0], CERTCFG_FLD_LABEL, "DUP"));
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G", rows, LIST_MAX), 0u);
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "", rows, LIST_MAX), 0u);
+    EXPECT_TRUE(rdkcertcfg_rowHasGroup(snap, &snap->rows[0], "G12"));
+    rdkcertcfg_release(&snap);
+
+    // compiled file has the same groups
+    EXPECT_EQ(rdkcertcfg_compile(cfg, bin), certcfgOk);
+    EXPECT_EQ(rdkcertcfg_verify(bin, cfg), certcfgOk);
+    snap = rdkcertcfg_loadBin(bin);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_EQ(rdkcertcfg_groupRows(snap, "G12", rows, LIST_MAX), 2u);
+    rdkcertcfg_release(&snap);
+    remove(bin);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, ManyCandidatesTests) {
+    const char *cfg = UTDIR "/tst1many.cfg";
+    const int candCnt = 100;  // well past LIST_MAX
+    FILE *fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    int candIndx;
+    for (candIndx = 0; candIndx < candCnt - 1; candIndx++) {
+        fprintf(fp, "TSTGRPM,M%d,TMP,file://%s,pc1\n", candIndx, UTCERT1);
+    }
+    fprintf(fp, "TSTGRPM,MLAST,TMP,file://%s,pc3\n", UTCERT3);
+    fclose(fp);
+
+    rdkcertselector_h mcs = rdkcertselector_new(cfg, hrotprop_path, "TSTGRPM");
+    ASSERT_NE(mcs, nullptr);
+    EXPECT_EQ(mcs->certTable->candCnt, (uint32_t)candCnt);
+    EXPECT_GE(mcs->certStatCnt, (uint32_t)candCnt);
+
+    // the last candidate is found, one past it is not
+    mcs->certIndx = candCnt - 1;
+    EXPECT_EQ(certsel_findCert(mcs), certselectorOk);
+    EXPECT_STREQ(mcs->certUri, FILESCHEME UTCERT3);
+    EXPECT_EQ(certsel_findNextCert(mcs), certselectorFileNotFound);
+    mcs->certIndx = 0;
+    EXPECT_EQ(certsel_findCert(mcs), certselectorOk);
+
+    // all but the last marked bad, getCert walks past them
+    for (candIndx = 0; candIndx < candCnt - 1; candIndx++) {
+        mcs->certStat[candIndx] = filetime(UTCERT1);
+    }
+    char *certUri = NULL, *certPass = NULL;
+    EXPECT_EQ(rdkcertselector_getCert(mcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTCERT3);
+    EXPECT_STREQ(certPass, UTPASS3);
+    EXPECT_EQ(mcs->certIndx, (uint32_t)(candCnt - 1));
+    EXPECT_EQ(rdkcertselector_setCurlStatus(mcs, CURL_SUCCESS, "many"), NO_RETRY);
+    EXPECT_EQ(mcs->certIndx, 0u);
+
+    rdkcertselector_free(&mcs);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, CompiledConfigTests) {
+    const char *cfg = UTDIR "/tst1compiled.cfg";
+    const char *bin = UTDIR "/tst1compiled.bin";
+    FILE *fp = fopen(cfg, "w");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "TSTGRP1,FRST,TMP,file://%s,pc1\n", UTCERT1);
+    fprintf(fp, "TSTGRP2||TSTGRP1|TSTGRP1,SCND,TMP,file://%s,pc2\n", UTCERT2);
+    fprintf(fp, "TSTGRP3,FRST,TMP,file://%s,pc3\n", UTCERT3);
+    fclose(fp);
+    // compiled file must be newer than the config file
+    struct timeval past[2] = { { time(NULL) - 10, 0 }, { time(NULL) - 10, 0 } };
+    ASSERT_EQ(utimes(cfg, past), 0);
+    ASSERT_EQ(rdkcertcfg_compile(cfg, bin), certcfgOk);
+    EXPECT_EQ(rdkcertcfg_verify(bin, cfg), certcfgOk);
+
+    ut_initcs(tstcs);
+    strncpy(tstcs->certSelPath, cfg, PATH_MAX);
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    ASSERT_NE(tstcs->certTable->snap->bin, nullptr);
+    EXPECT_EQ(tstcs->certTable->snap->binState, CERTCFG_BIN_USED);
+    EXPECT_EQ(tstcs->certTable->candCnt, 2);
+    tstcs->certIndx = 1;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    EXPECT_STREQ(tstcs->certUri, FILESCHEME UTCERT2);
+    EXPECT_STREQ(tstcs->certCredRef, "pc2");
+    tstcs->certIndx = 2;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorFileNotFound);
+    const rdkcertcfgRow_t *row = rdkcertcfg_findRef(tstcs->certTable->snap, "FRST");
+    ASSERT_NE(row, nullptr);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(tstcs->certTable->snap, row, CERTCFG_FLD_CREDREF, "pc1"));
+    EXPECT_EQ(rdkcertcfg_findRef(tstcs->certTable->snap, "FRS"), nullptr);
+
+    // the image is a copy, rewriting the compiled file in place does not fault its readers
+    ASSERT_EQ(truncate(bin, 0), 0);
+    row = rdkcertcfg_findRef(tstcs->certTable->snap, "FRST");
+    ASSERT_NE(row, nullptr);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(tstcs->certTable->snap, row, CERTCFG_FLD_CREDREF, "pc1"));
+    ASSERT_EQ(rdkcertcfg_compile(cfg, bin), certcfgOk);
+
+    // corrupt compiled file is rejected, text config is used
+    fp = fopen(bin, "r+");
+    ASSERT_NE(fp, nullptr);
+    fseek(fp, sizeof(rdkcertcfgBinHdr_t) + 4, SEEK_SET);
+    fputc(0x5a, fp);
+    fclose(fp);
+    EXPECT_NE(rdkcertcfg_verify(bin, NULL), certcfgOk);
+    tstcs->certIndx = 1;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    EXPECT_EQ(tstcs->certTable->snap->bin, nullptr);
+    EXPECT_EQ(tstcs->certTable->snap->binState, CERTCFG_BIN_REJECTED);
+    EXPECT_STREQ(tstcs->certCredRef, "pc2");
+
+    // config file newer than the compiled file, text config is used
+    ASSERT_EQ(rdkcertcfg_compile(cfg, bin), certcfgOk);
+    ASSERT_EQ(utimes(bin, past), 0);
+    fp = fopen(cfg, "a");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "TSTGRP1,THRD,TMP,file://%s,pc4\n", UTCERT3);
+    fclose(fp);
+    tstcs->certIndx = 2;
+    EXPECT_EQ(certsel_findCert(tstcs), certselectorOk);
+    EXPECT_EQ(tstcs->certTable->snap->binState, CERTCFG_BIN_NONE);
+    EXPECT_STREQ(tstcs->certCredRef, "pc4");
+    EXPECT_EQ(rdkcertcfg_verify(bin, cfg), certcfgFileError);
+    remove(bin);
+    remove(cfg);
+}
+
+// replace a config file the way provisioning does, write a new file then rename it over the old one
+static void ut_replaceCfg(const char *cfg, const char *line) {
+    char tmp[PATH_MAX+8];
+    snprintf(tmp, sizeof(tmp), "%s.new", cfg);
+    FILE *fp = fopen(tmp, "w");
+    ASSERT_NE(fp, nullptr);
+    fprintf(fp, "%s\n", line);
+    fclose(fp);
+    ASSERT_EQ(rename(tmp, cfg), 0);
+}
+
+// refresh until the image changes or 5 seconds pass; the watcher reloads in the background
+static rdkcertcfgStatus_t ut_waitReload(rdkcertcfg_t **cfg, const char *path, rdkcertcfgSnap_t **snap) {
+    const rdkcertcfgSnap_t *oldsnap = *snap;
+    rdkcertcfgStatus_t cfgstat = certcfgOk;
+    int tries;
+    for (tries = 0; tries < 500; tries++) {
+        cfgstat = rdkcertcfg_refresh(cfg, path, snap);
+        if (*snap != oldsnap) {
+            break;
+        }
+        usleep(10000);
+    }
+    return cfgstat;
+}
+
+// wait until the watcher has seen no change for 100ms, so earlier file changes don't show up in a measurement
+static void ut_waitQuiet(void) {
+    unsigned long certSeq = rdkcertcfg_certSeq();
+    int tries, quiet = 0;
+    for (tries = 0; tries < 500 && quiet < 10; tries++) {
+        usleep(10000);
+        quiet = (rdkcertcfg_certSeq() == certSeq) ? quiet + 1 : 0;
+        certSeq = rdkcertcfg_certSeq();
+    }
+}
+
+TEST_F(CertSelFindCertTest, AutoReloadTests) {
+    const char *cfg = UTDIR "/tst1watch.cfg";
+    char line[PATH_MAX*2];
+    snprintf(line, sizeof(line), "WGRP,W1,TMP,file://%s,pc1", UTCERT1);
+    ut_replaceCfg(cfg, line);
+
+    rdkcertcfg_t *watchcfg = NULL;
+    rdkcertcfgSnap_t *snap = NULL;
+    EXPECT_EQ(rdkcertcfg_watch(NULL), certcfgBadPointer);
+    ASSERT_EQ(rdkcertcfg_refresh(&watchcfg, cfg, &snap), certcfgOk);
+    EXPECT_FALSE(rdkcertcfg_watching(watchcfg));
+    ASSERT_EQ(rdkcertcfg_watch(watchcfg), certcfgOk);
+    EXPECT_TRUE(rdkcertcfg_watching(watchcfg));
+    EXPECT_EQ(rdkcertcfg_watch(watchcfg), certcfgOk);
+
+    // unchanged file keeps the same image
+    const rdkcertcfgSnap_t *oldsnap = snap;
+    EXPECT_EQ(rdkcertcfg_refresh(&watchcfg, cfg, &snap), certcfgOk);
+    EXPECT_EQ(snap, oldsnap);
+
+    // replaced file is reloaded by the watcher
+    snprintf(line, sizeof(line), "WGRP,W2,TMP,file://%s,pc2", UTCERT2);
+    ut_replaceCfg(cfg, line);
+    EXPECT_EQ(ut_waitReload(&watchcfg, cfg, &snap), certcfgOk);
+    ASSERT_NE(snap, oldsnap);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, &snap->rows[0], CERTCFG_FLD_LABEL, "W2"));
+
+    // changes to cert files are counted
+    unsigned long certSeq = rdkcertcfg_certSeq();
+    UT_SYSTEM0("touch " UTCERT2);
+    int tries;
+    for (tries = 0; tries < 500 && rdkcertcfg_certSeq() == certSeq; tries++) {
+        usleep(10000);
+    }
+    EXPECT_NE(rdkcertcfg_certSeq(), certSeq);
+
+    // selector sharing the watched file
+    rdkcertselector_h watchcs = rdkcertselector_new(cfg, DEFAULT_HROT, "WGRP");
+    ASSERT_NE(watchcs, nullptr);
+    EXPECT_EQ(rdkcertselector_enableAutoReload(NULL), certselectorBadPointer);
+    EXPECT_EQ(rdkcertselector_enableAutoReload(watchcs), certselectorOk);
+    EXPECT_STREQ(rdkcertselector_getEngine(watchcs), "e4tstdef");
+    char *certUri = NULL, *certPass = NULL;
+    EXPECT_EQ(rdkcertselector_getCert(watchcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTCERT2);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(watchcs, CURL_SUCCESS, "ut"), NO_RETRY);
+
+    // removed file is reported once the watcher sees it
+    remove(cfg);
+    EXPECT_EQ(ut_waitReload(&watchcfg, cfg, &snap), certcfgFileNotFound);
+    EXPECT_EQ(snap, nullptr);
+    snprintf(line, sizeof(line), "WGRP,W3,TMP,file://%s,pc3", UTCERT3);
+    ut_replaceCfg(cfg, line);
+    EXPECT_EQ(rdkcertcfg_refresh(&watchcfg, cfg, &snap), certcfgOk);
+    ASSERT_NE(snap, nullptr);
+    EXPECT_TRUE(rdkcertcfg_fieldIs(snap, &snap->rows[0], CERTCFG_FLD_LABEL, "W3"));
+
+    rdkcertselector_free(&watchcs);
+    rdkcertcfg_release(&snap);
+    rdkcertcfg_detach(&watchcfg);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, MetaCacheTests) {
+    const char *cfg = UTDIR "/tst1meta.cfg";
+    char line[PATH_MAX*2];
+    snprintf(line, sizeof(line), "MGRP,M1,TMP,file://%s,pc1", UTCERT1);
+    ut_replaceCfg(cfg, line);
+    rdkcertselector_h metacs = rdkcertselector_new(cfg, DEFAULT_HROT, "MGRP");
+    ASSERT_NE(metacs, nullptr);
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorCounters_t before, after;
+    int iter;
+
+    // without auto reload or a ttl, every getCert checks the cert file
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.statCalls - before.statCalls, 1u);
+    EXPECT_EQ(after.metaMisses - before.metaMisses, 1u);
+
+    // with a ttl, the metadata is reused
+    rdkcertselector_setCertMetaTtl(60000);
+    EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&before);
+    for (iter = 0; iter < 10; iter++) {
+        EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+        EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    }
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.statCalls - before.statCalls, 0u);
+    EXPECT_EQ(after.metaHits - before.metaHits, 10u);
+    rdkcertselector_setCertMetaTtl(0);
+
+    // with auto reload, the steady state makes no file syscalls until a cert changes
+    EXPECT_EQ(rdkcertselector_enableAutoReload(metacs), certselectorOk);
+    ut_waitQuiet();
+    EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&before);
+    for (iter = 0; iter < 10; iter++) {
+        EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+        EXPECT_STREQ(certUri, FILESCHEME UTCERT1);
+        EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    }
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.statCalls - before.statCalls, 0u);
+    EXPECT_EQ(after.openCalls - before.openCalls, 0u);
+    EXPECT_EQ(after.metaHits - before.metaHits, 10u);
+
+    // a change in the cert directory makes the next check stat the file
+    unsigned long certSeq = rdkcertcfg_certSeq();
+    UT_SYSTEM0("touch " UTCERT1);
+    for (iter = 0; iter < 500 && rdkcertcfg_certSeq() == certSeq; iter++) {
+        usleep(10000);
+    }
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(metacs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(metacs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.metaMisses - before.metaMisses, 1u);
+
+    rdkcertselector_free(&metacs);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, FingerprintTests) {
+    const char *cfg = UTDIR "/tst1print.cfg";
+    const char *cert = UTDIR "/tst1print.p12";
+    char line[PATH_MAX*2];
+    UT_SYSTEM0("echo cert1 > " UTDIR "/tst1print.p12");
+    snprintf(line, sizeof(line), "FGRP,F1,TMP,file://%s,pc1\nFGRP,F2,TMP,file://%s,pc2", cert, UTCERT2);
+    ut_replaceCfg(cfg, line);
+    rdkcertselector_h printcs = rdkcertselector_new(cfg, DEFAULT_HROT, "FGRP");
+    ASSERT_NE(printcs, nullptr);
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorCounters_t before, after;
+
+    // first goes bad, uses second
+    EXPECT_EQ(rdkcertselector_getCert(printcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tst1print.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(printcs, CURLERR_LOCALCERT, "ut"), TRY_ANOTHER);
+    EXPECT_EQ(rdkcertselector_getCert(printcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTCERT2);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(printcs, CURL_SUCCESS, "ut"), NO_RETRY);
+
+    // touched, content unchanged; first stays bad and is hashed once
+    sleep(1);
+    UT_SYSTEM0("touch " UTDIR "/tst1print.p12");
+    rdkcertselector_getCounters(&before);
+    for (int iter = 0; iter < 3; iter++) {
+        EXPECT_EQ(rdkcertselector_getCert(printcs, &certUri, &certPass), certselectorOk);
+        EXPECT_STREQ(certUri, FILESCHEME UTCERT2);
+        EXPECT_EQ(rdkcertselector_setCurlStatus(printcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    }
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.hashReads - before.hashReads, 1u);
+
+    // replaced by a new file with the same content; first stays bad
+    UT_SYSTEM0("echo cert1 > " UTDIR "/tst1print.new && mv " UTDIR "/tst1print.new " UTDIR "/tst1print.p12");
+    EXPECT_EQ(rdkcertselector_getCert(printcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTCERT2);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(printcs, CURL_SUCCESS, "ut"), NO_RETRY);
+
+    // content changed, first is tried again
+    UT_SYSTEM0("echo renewed >> " UTDIR "/tst1print.p12");
+    EXPECT_EQ(rdkcertselector_getCert(printcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tst1print.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(printcs, CURL_SUCCESS, "ut"), NO_RETRY);
+
+    rdkcertselector_free(&printcs);
+    remove(cert);
+    remove(cfg);
+}
+
+// write a self signed EC cert and its key as PKCS#12, valid from now+fromSec to now+toSec
+// with otherKey, the cert and a key that is not the key of the cert are written as PEM, PKCS#12 won't take them
+static void ut_writeP12(const char *path, const char *pass, long fromSec, long toSec, int otherKey) {
+    EVP_PKEY *pkey[2] = { NULL, NULL };
+    for (int keyIndx = 0; keyIndx < 2; keyIndx++) {
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+        ASSERT_NE(ctx, nullptr);
+        ASSERT_EQ(EVP_PKEY_keygen_init(ctx), 1);
+        ASSERT_EQ(EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1), 1);
+        ASSERT_EQ(EVP_PKEY_keygen(ctx, &pkey[keyIndx]), 1);
+        EVP_PKEY_CTX_free(ctx);
+    }
+    X509 *cert = X509_new();
+    ASSERT_NE(cert, nullptr);
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), fromSec);
+    X509_gmtime_adj(X509_getm_notAfter(cert), toSec);
+    X509_set_pubkey(cert, pkey[0]);
+    X509_NAME *name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *)"certsel ut", -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    ASSERT_GT(X509_sign(cert, pkey[0], EVP_sha256()), 0);
+    char tmp[PATH_MAX+8];
+    snprintf(tmp, sizeof(tmp), "%s.new", path);
+    FILE *fp = fopen(tmp, "wb");
+    ASSERT_NE(fp, nullptr);
+    if (otherKey) {
+        EXPECT_EQ(PEM_write_X509(fp, cert), 1);
+        EXPECT_EQ(PEM_write_PrivateKey(fp, pkey[1], NULL, NULL, 0, NULL, NULL), 1);
+    } else {
+        PKCS12 *p12 = PKCS12_create(pass, "ut", pkey[0], cert, NULL, 0, 0, 0, 0, 0);
+        ASSERT_NE(p12, nullptr);
+        EXPECT_EQ(i2d_PKCS12_fp(fp, p12), 1);
+        PKCS12_free(p12);
+    }
+    fclose(fp);
+    ASSERT_EQ(rename(tmp, path), 0);
+    X509_free(cert);
+    EVP_PKEY_free(pkey[0]);
+    EVP_PKEY_free(pkey[1]);
+}
+
+TEST_F(CertSelFindCertTest, ValidationTests) {
+    const char *cfg = UTDIR "/tst1val.cfg";
+    ut_writeP12(UTDIR "/tstvalexp.p12", "pc1pass", -7200, -3600, 0);
+    ut_writeP12(UTDIR "/tstvalkey.p12", "pc1pass", -3600, 3600, 1);
+    ut_writeP12(UTDIR "/tstvalpass.p12", "otherpass", -3600, 3600, 0);
+    ut_writeP12(UTDIR "/tstvalok.p12", "pc1pass", -3600, 3600, 0);
+    UT_SYSTEM0("echo not a cert > " UTDIR "/tstvalbad.p12");
+    ut_replaceCfg(cfg, "VGRP,V1,P12,file://" UTDIR "/tstvalexp.p12,pc1\n"
+                       "VGRP,V2,P12,file://" UTDIR "/tstvalkey.p12,pc1\n"
+                       "VGRP,V3,P12,file://" UTDIR "/tstvalbad.p12,pc1\n"
+                       "VGRP,V4,P12,file://" UTDIR "/tstvalpass.p12,pc1\n"
+                       "VGRP,V5,P12,file://" UTDIR "/tstvalok.p12,pc1\n"
+                       "VEXP,V6,P12,file://" UTDIR "/tstvalexp.p12,pc1");
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorCounters_t before, after;
+
+    // without validation, the first cert is handed out
+    rdkcertselector_h valcs = rdkcertselector_new(cfg, DEFAULT_HROT, "VGRP");
+    ASSERT_NE(valcs, nullptr);
+    EXPECT_EQ(rdkcertselector_getCert(valcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tstvalexp.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(valcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_free(&valcs);
+
+    // the group is checked in the background
+    valcs = rdkcertselector_new(cfg, DEFAULT_HROT, "VGRP");
+    ASSERT_NE(valcs, nullptr);
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_enableValidation(valcs), certselectorOk);
+    // wait for the queue to drain, a check is counted before its verdict is cached
+    for (int tries = 0; tries < 500; tries++) {
+        pthread_mutex_lock(&certsel_workLock);
+        unsigned int pending = certsel_workPending;
+        pthread_mutex_unlock(&certsel_workLock);
+        rdkcertselector_getCounters(&after);
+        if (after.certChecks - before.certChecks >= 5 && pending == 0) {
+            break;
+        }
+        usleep(10000);
+    }
+    EXPECT_EQ(after.certChecks - before.certChecks, 5u);
+    EXPECT_EQ(after.certRejects - before.certRejects, 4u);
+
+    // expired, key mismatch, corrupt and wrong passcode are skipped, from the cache
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(valcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tstvalok.p12");
+    EXPECT_STREQ(certPass, "pc1pass");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(valcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.certParses - before.certParses, 0u);
+    EXPECT_EQ(after.certRejects - before.certRejects, 4u);
+
+    // content problems are remembered like cert errors, only the expired cert is checked again
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(valcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tstvalok.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(valcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.certRejects - before.certRejects, 1u);
+
+    // a fixed cert is used again
+    ut_writeP12(UTDIR "/tstvalkey.p12", "pc1pass", -3600, 3600, 0);
+    EXPECT_EQ(rdkcertselector_getCert(valcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tstvalkey.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(valcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_free(&valcs);
+
+    // if every cert is skipped, the last resort is still returned
+    valcs = rdkcertselector_new(cfg, DEFAULT_HROT, "VEXP");
+    ASSERT_NE(valcs, nullptr);
+    EXPECT_EQ(rdkcertselector_enableValidation(valcs), certselectorOk);
+    EXPECT_EQ(rdkcertselector_getCert(valcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTDIR "/tstvalexp.p12");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(valcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_free(&valcs);
+
+    // the cache tells passcodes apart by a keyed hash
+    rdkcertvalCounters_t valBefore, valAfter;
+    rdkcertval_getCounters(&valBefore);
+    EXPECT_EQ(rdkcertval_check(NULL, UTDIR "/tstvalpass.p12", "pc1pass"), certvalCorrupt);
+    EXPECT_EQ(rdkcertval_check(NULL, UTDIR "/tstvalpass.p12", "otherpass"), certvalOk);
+    EXPECT_EQ(rdkcertval_check(NULL, UTDIR "/tstvalpass.p12", "otherpass"), certvalOk);
+    rdkcertval_getCounters(&valAfter);
+    EXPECT_EQ(valAfter.parses - valBefore.parses, 1u);
+
+    remove(UTDIR "/tstvalexp.p12");
+    remove(UTDIR "/tstvalkey.p12");
+    remove(UTDIR "/tstvalpass.p12");
+    remove(UTDIR "/tstvalok.p12");
+    remove(UTDIR "/tstvalbad.p12");
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, KeyMaterialTests) {
+    const char *cfg = UTDIR "/tst1key.cfg";
+    ut_writeP12(UTDIR "/tstkeyok.p12", "pc1pass", -3600, 3600, 0);
+    UT_SYSTEM0("echo not a cert > " UTDIR "/tstkeybad.p12");
+    ut_replaceCfg(cfg, "KGRP,K1,P12,file://" UTDIR "/tstkeyok.p12,pc1\n"
+                       "KBAD,K2,P12,file://" UTDIR "/tstkeybad.p12,pc1");
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorKeyMaterial_t keyMat, keyMat2;
+    rdkcertselectorCounters_t before, after;
+
+    rdkcertselector_h keycs = rdkcertselector_new(cfg, DEFAULT_HROT, "KGRP");
+    ASSERT_NE(keycs, nullptr);
+    EXPECT_EQ(rdkcertselector_getKeyMaterial(NULL, &keyMat), certselectorBadPointer);
+    EXPECT_EQ(rdkcertselector_getKeyMaterial(keycs, NULL), certselectorBadArgument);
+    EXPECT_EQ(rdkcertselector_getKeyMaterial(keycs, &keyMat), certselectorGeneralFailure);  // before getCert
+
+    // decoded once, the same objects are handed out again with their own references
+    EXPECT_EQ(rdkcertselector_getCert(keycs, &certUri, &certPass), certselectorOk);
+    ASSERT_EQ(rdkcertselector_getKeyMaterial(keycs, &keyMat), certselectorOk);
+    ASSERT_NE(keyMat.pkey, nullptr);
+    ASSERT_NE(keyMat.cert, nullptr);
+    EXPECT_EQ(keyMat.chain, nullptr);
+    EXPECT_EQ(X509_check_private_key(keyMat.cert, keyMat.pkey), 1);
+    rdkcertselector_getCounters(&before);
+    ASSERT_EQ(rdkcertselector_getKeyMaterial(keycs, &keyMat2), certselectorOk);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.certParses - before.certParses, 0u);
+    EXPECT_EQ(keyMat2.cert, keyMat.cert);
+    EXPECT_EQ(keyMat2.pkey, keyMat.pkey);
+    rdkcertselector_freeKeyMaterial(&keyMat2);
+    EXPECT_EQ(keyMat2.cert, nullptr);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(keycs, CURL_SUCCESS, "ut"), NO_RETRY);
+    EXPECT_EQ(X509_check_private_key(keyMat.cert, keyMat.pkey), 1);  // still held
+    rdkcertselector_freeKeyMaterial(&keyMat);
+    rdkcertselector_free(&keycs);
+
+    // a cert that can't be decoded
+    keycs = rdkcertselector_new(cfg, DEFAULT_HROT, "KBAD");
+    ASSERT_NE(keycs, nullptr);
+    EXPECT_EQ(rdkcertselector_getCert(keycs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_getKeyMaterial(keycs, &keyMat), certselectorFileError);
+    EXPECT_EQ(keyMat.cert, nullptr);
+    EXPECT_EQ(keyMat.pkey, nullptr);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(keycs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_free(&keycs);
+
+    remove(UTDIR "/tstkeyok.p12");
+    remove(UTDIR "/tstkeybad.p12");
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, CertBlobTests) {
+    const char *cfg = UTDIR "/tst1blob.cfg";
+    const char *cert = UTDIR "/tst1blob.p12";
+    UT_SYSTEM0("echo blob1 > " UTDIR "/tst1blob.p12");
+    ut_replaceCfg(cfg, "BGRP,B1,P12,file://" UTDIR "/tst1blob.p12,pc1");
+    char *certUri = NULL, *certPass = NULL;
+    const unsigned char *data = NULL;
+    size_t len = 0;
+    rdkcertselectorCounters_t before, after;
+
+    rdkcertselector_h blobcs = rdkcertselector_new(cfg, DEFAULT_HROT, "BGRP");
+    ASSERT_NE(blobcs, nullptr);
+    EXPECT_EQ(rdkcertselector_getCertBlob(NULL, &data, &len), certselectorBadPointer);
+    EXPECT_EQ(rdkcertselector_getCertBlob(blobcs, NULL, &len), certselectorBadArgument);
+    EXPECT_EQ(rdkcertselector_getCertBlob(blobcs, &data, &len), certselectorGeneralFailure);  // before getCert
+
+    // read once, the same content is handed out for the next getCert
+    EXPECT_EQ(rdkcertselector_getCert(blobcs, &certUri, &certPass), certselectorOk);
+    ASSERT_EQ(rdkcertselector_getCertBlob(blobcs, &data, &len), certselectorOk);
+    ASSERT_EQ(len, 6u);
+    EXPECT_EQ(memcmp(data, "blob1\n", len), 0);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(blobcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(blobcs, &certUri, &certPass), certselectorOk);
+    ASSERT_EQ(rdkcertselector_getCertBlob(blobcs, &data, &len), certselectorOk);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.blobReads - before.blobReads, 0u);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(blobcs, CURL_SUCCESS, "ut"), NO_RETRY);
+
+    // content changed, read again
+    UT_SYSTEM0("echo renewed >> " UTDIR "/tst1blob.p12");
+    EXPECT_EQ(rdkcertselector_getCert(blobcs, &certUri, &certPass), certselectorOk);
+    ASSERT_EQ(rdkcertselector_getCertBlob(blobcs, &data, &len), certselectorOk);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.blobReads - before.blobReads, 1u);
+    ASSERT_EQ(len, 14u);
+    EXPECT_EQ(memcmp(data, "blob1\nrenewed\n", len), 0);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(blobcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    EXPECT_EQ(rdkcertselector_getCertBlob(blobcs, &data, &len), certselectorGeneralFailure);  // released
+    EXPECT_EQ(data, nullptr);
+
+    rdkcertselector_free(&blobcs);
+    remove(cert);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, PassCacheTests) {
+    const char *cfg = UTDIR "/tst1pass.cfg";
+    char line[PATH_MAX*2];
+    snprintf(line, sizeof(line), "PGRP,P1,TMP,file://%s,pc1\nPGRP,P2,TMP,file://%s,pc2", UTCERT1, UTCERT2);
+    ut_replaceCfg(cfg, line);
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorCounters_t before, after;
+
+    rdkcertselector_h passcs = rdkcertselector_new(cfg, DEFAULT_HROT, "PGRP");
+    ASSERT_NE(passcs, nullptr);
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(60000), certselectorOk);
+
+    // fetched once, then answered from the cache
+    rdkcertselector_getCounters(&before);
+    for (int iter = 0; iter < 3; iter++) {
+        EXPECT_EQ(rdkcertselector_getCert(passcs, &certUri, &certPass), certselectorOk);
+        EXPECT_STREQ(certPass, "pc1pass");
+        EXPECT_EQ(rdkcertselector_setCurlStatus(passcs, CURL_SUCCESS, "ut"), NO_RETRY);
+        EXPECT_STREQ(certPass, "");  // the handle's copy is still wiped
+    }
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passMisses - before.passMisses, 1u);
+    EXPECT_EQ(after.passHits - before.passHits, 2u);
+
+    // purged, fetched again
+    rdkcertselector_purgePassCache();
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(passcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certPass, "pc1pass");
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passMisses - before.passMisses, 1u);
+
+    // a bad cert drops its passcode, the next cert's is fetched
+    EXPECT_EQ(rdkcertselector_setCurlStatus(passcs, CURLERR_LOCALCERT, "ut"), TRY_ANOTHER);
+    EXPECT_EQ(rdkcertselector_getCert(passcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certPass, "pc2pass");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(passcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    EXPECT_EQ(rdkcertcfg_passGet(UTCRED1, line, sizeof(line)), certcfgFileNotFound);
+    EXPECT_EQ(rdkcertcfg_passGet(UTCRED2, line, sizeof(line)), certcfgOk);
+    EXPECT_STREQ(line, "pc2pass");
+
+    // expired
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(1), certselectorOk);
+    rdkcertselector_purgePassCache();
+    EXPECT_EQ(rdkcertselector_getCert(passcs, &certUri, &certPass), certselectorOk);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(passcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    usleep(5000);
+    EXPECT_EQ(rdkcertcfg_passGet(UTCRED2, line, sizeof(line)), certcfgFileNotFound);
+
+    // disabled, nothing cached or counted
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(0), certselectorOk);
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(passcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certPass, "pc2pass");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(passcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passMisses - before.passMisses, 0u);
+    EXPECT_EQ(after.passHits - before.passHits, 0u);
+
+    rdkcertselector_free(&passcs);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, PassCacheFreeTests) {
+    const char *cfg = UTDIR "/tst1passfree.cfg";
+    char line[PATH_MAX*2];
+    snprintf(line, sizeof(line), "AGRP,A1,TMP,file://%s,pc1\nBGRP,B1,TMP,file://%s,pc2", UTCERT1, UTCERT2);
+    ut_replaceCfg(cfg, line);
+    char *certUri = NULL, *certPass = NULL;
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(60000), certselectorOk);
+    rdkcertselector_purgePassCache();
+
+    // two handles use pc1, one uses pc2, all on the same config file
+    rdkcertselector_h acs1 = rdkcertselector_new(cfg, DEFAULT_HROT, "AGRP");
+    rdkcertselector_h acs2 = rdkcertselector_new(cfg, DEFAULT_HROT, "AGRP");
+    rdkcertselector_h bcs = rdkcertselector_new(cfg, DEFAULT_HROT, "BGRP");
+    ASSERT_NE(acs1, nullptr);
+    ASSERT_NE(acs2, nullptr);
+    ASSERT_NE(bcs, nullptr);
+    rdkcertselector_h handles[] = { acs1, acs2, bcs };
+    for (rdkcertselector_h cs : handles) {
+        EXPECT_EQ(rdkcertselector_getCert(cs, &certUri, &certPass), certselectorOk);
+        EXPECT_EQ(rdkcertselector_setCurlStatus(cs, CURL_SUCCESS, "ut"), NO_RETRY);
+    }
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED1), 1);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED2), 1);
+
+    // the passcode of a freed handle is wiped unless another handle still holds it
+    rdkcertselector_free(&bcs);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED2), 0);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED1), 1);
+    rdkcertselector_free(&acs1);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED1), 1);
+    rdkcertselector_free(&acs2);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED1), 0);
+
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(0), certselectorOk);
+    remove(cfg);
+}
+
+// wait for the background worker to finish its jobs
+static void ut_waitWork(void) {
+    for (int tries = 0; tries < 500; tries++) {
+        pthread_mutex_lock(&certsel_workLock);
+        unsigned int pending = certsel_workPending;
+        pthread_mutex_unlock(&certsel_workLock);
+        if (pending == 0) {
+            break;
+        }
+        usleep(10000);
+    }
+}
+
+TEST_F(CertSelFindCertTest, PrefetchTests) {
+    const char *cfg = UTDIR "/tst1pref.cfg";
+    char line[PATH_MAX*2];
+    snprintf(line, sizeof(line), "FGRP,F1,TMP,file://%s,pc1\nFGRP,F2,TMP,file://%s,pc2", UTCERT1, UTCERT2);
+    ut_replaceCfg(cfg, line);
+    char *certUri = NULL, *certPass = NULL;
+    rdkcertselectorCounters_t before, after;
+
+    rdkcertselector_h prefcs = rdkcertselector_new(cfg, DEFAULT_HROT, "FGRP");
+    ASSERT_NE(prefcs, nullptr);
+    EXPECT_EQ(rdkcertselector_enablePrefetch(NULL), certselectorBadPointer);
+    EXPECT_EQ(rdkcertselector_enablePrefetch(prefcs), certselectorGeneralFailure);  // needs the passcode cache
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(60000), certselectorOk);
+    rdkcertselector_purgePassCache();
+
+    // the first cert's passcode is fetched ahead
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_enablePrefetch(prefcs), certselectorOk);
+    ut_waitWork();
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passPrefetches - before.passPrefetches, 1u);
+
+    // handing it out fetches the next cert's passcode while the caller connects
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_getCert(prefcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certPass, "pc1pass");
+    ut_waitWork();
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passHits - before.passHits, 1u);
+    EXPECT_EQ(after.passMisses - before.passMisses, 0u);
+    EXPECT_EQ(after.passPrefetches - before.passPrefetches, 1u);
+    EXPECT_EQ(rdkcertcfg_passCached(UTCRED2), 1);
+
+    // the retry gets it from the cache
+    rdkcertselector_getCounters(&before);
+    EXPECT_EQ(rdkcertselector_setCurlStatus(prefcs, CURLERR_LOCALCERT, "ut"), TRY_ANOTHER);
+    EXPECT_EQ(rdkcertselector_getCert(prefcs, &certUri, &certPass), certselectorOk);
+    EXPECT_STREQ(certUri, FILESCHEME UTCERT2);
+    EXPECT_STREQ(certPass, "pc2pass");
+    EXPECT_EQ(rdkcertselector_setCurlStatus(prefcs, CURL_SUCCESS, "ut"), NO_RETRY);
+    ut_waitWork();
+    rdkcertselector_getCounters(&after);
+    EXPECT_EQ(after.passHits - before.passHits, 1u);
+    EXPECT_EQ(after.passMisses - before.passMisses, 0u);
+    EXPECT_EQ(after.passPrefetches - before.passPrefetches, 0u);  // no candidate after the last
+
+    rdkcertselector_free(&prefcs);
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(0), certselectorOk);
+    remove(cfg);
+}
+
+TEST_F(CertSelFindCertTest, BatchPassTests) {
+    // jobs taken by the worker together get their passcodes in one rdkconfig call
+    const char *creds[] = { UTCRED1, UTCRED2, UTCRED1 };
+    certsel_workJob_t *jobs[3];
+    for (int indx = 2; indx >= 0; indx--) {
+        jobs[indx] = (certsel_workJob_t *)calloc(1, sizeof(certsel_workJob_t));
+        ASSERT_NE(jobs[indx], nullptr);
+        strcpy(jobs[indx]->certCredRef, creds[indx]);
+        jobs[indx]->validate = 1;
+        jobs[indx]->next = (indx < 2) ? jobs[indx+1] : NULL;
+    }
+    ut_getManyCnt = 0;
+    certsel_batchPass(jobs[0]);
+    EXPECT_EQ(ut_getManyCnt, 1);
+    EXPECT_EQ(jobs[0]->passState, CERTSEL_PASS_FETCHED);
+    EXPECT_STREQ(jobs[0]->certPass, "pc1pass");
+    EXPECT_EQ(jobs[1]->passState, CERTSEL_PASS_FETCHED);
+    EXPECT_STREQ(jobs[1]->certPass, "pc2pass");
+    EXPECT_EQ(jobs[2]->passState, CERTSEL_PASS_CACHED);  // shared with the first
+    EXPECT_STREQ(jobs[2]->certPass, "pc1pass");
+
+    // prefetches of cached passcodes have nothing to do
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(60000), certselectorOk);
+    rdkcertselector_purgePassCache();
+    jobs[0]->validate = jobs[1]->validate = 0;
+    jobs[1]->next = NULL;
+    certsel_batchPass(jobs[0]);
+    EXPECT_EQ(ut_getManyCnt, 2);
+    EXPECT_EQ(jobs[0]->passState, CERTSEL_PASS_FETCHED);
+    EXPECT_EQ(jobs[1]->passState, CERTSEL_PASS_FETCHED);
+    certsel_batchPass(jobs[0]);
+    EXPECT_EQ(ut_getManyCnt, 2);
+    EXPECT_EQ(jobs[0]->passState, CERTSEL_PASS_NONE);
+    EXPECT_EQ(jobs[1]->passState, CERTSEL_PASS_NONE);
+    ASSERT_EQ(rdkcertselector_setPassCacheTtl(0), certselectorOk);
+
+    for (int indx = 0; indx < 3; indx++) {
+        free(jobs[indx]);
+    }
+}
+
 class CertSelectorNextCertTest : public ::testing::Test {
 protected:
     rdkcertselector_h tstcs;
@@ -789,6 +1718,25 @@ TEST_F(RdkCertSelectorSetCurlStatusTest, TestNonCertError) {
 
     rdkcertselector_free(&tstcs1);
 }
+// Test for a cert released without a status, as applyToCurl does when the hrot engine is not found
+TEST_F(RdkCertSelectorSetCurlStatusTest, TestReleaseCert) {
+    tstcs1 = rdkcertselector_new(certsel_path, DEFAULT_HROT, GRP1);
+    tstcs1->state = cssReadyToCheckCert;
+    tstcs1->certPass[0] = 'P';
+
+    EXPECT_EQ(certsel_chkCertError(53), TRY_ANOTHER);  // CURLE_SSL_ENGINE_NOTFOUND is a cert error to setCurlStatus
+    rdkcertselector_releaseCert(tstcs1);
+    EXPECT_EQ(tstcs1->certStat[0], CERTSTAT_NOTBAD);  // Cert not marked bad
+    EXPECT_EQ(tstcs1->certPass[0], 0);  // Password wiped
+    EXPECT_EQ(tstcs1->certIndx, 0);
+    EXPECT_EQ(tstcs1->state, cssReadyToGiveCert);
+
+    // Wrong state, no change
+    rdkcertselector_releaseCert(tstcs1);
+    EXPECT_EQ(tstcs1->state, cssReadyToGiveCert);
+
+    rdkcertselector_free(&tstcs1);
+}
 /* function : ut_rdkcertselector_getEngine()
  *
  *unit tests for char *rdkcertselector_getEngine( rdkcertselector_h thiscertsel )
@@ -941,7 +1889,7 @@ TEST_F(RdkCertSelectorSeqTest, TestSequence3) {
 
     // 2) First cert renewed, uses first cert again
     sleep(1);  // Wait to simulate time passing, making the first cert seem old
-    UT_SYSTEM0("touch " UTCERT1);  // Renew first cert (using touch command to update file time)
+    UT_SYSTEM0("echo renewed >> " UTCERT1);  // Renew first cert (content changes, touching is not enough)
     seq1cs->state = cssReadyToGiveCert;
     EXPECT_EQ(ut_getThenSet(seq1cs, CURL_SUCCESS, FILESCHEME UTCERT1, UTPASS1, NO_RETRY), 0);// First cert is used again
 
@@ -982,7 +1930,7 @@ TEST_F(RdkCertSelectorSeq4Test, CertSelectorSequenceTest) {
     EXPECT_EQ(ut_getThenSet(seq1cs, CURL_SUCCESS, FILESCHEME UTCERT3, UTPASS3, NO_RETRY), EXPECTED_RESULT);
 
     // 2) Second restored, use second
-    UT_SYSTEM0("touch " UTCERT2);  // Restore the second certificate
+    UT_SYSTEM0("echo renewed >> " UTCERT2);  // Restore the second certificate
     EXPECT_EQ(ut_getThenSet(seq1cs, CURL_SUCCESS, FILESCHEME UTCERT2, UTPASS2, NO_RETRY), EXPECTED_RESULT);
 
     // 3) Next try skips first, uses second
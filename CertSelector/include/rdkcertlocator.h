@@ -19,6 +19,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -86,6 +88,83 @@ char *rdkcertlocator_getEngine( rdkcertlocator_h thiscertloc );
 **/
 rdkcertlocatorStatus_t rdkcertlocator_locateCert(rdkcertlocator_h thiscertloc, const char *cert_ref, char **cert_uri, char **cert_pass );
 
+/* result of locating one cert with rdkcertlocator_locateCerts */
+typedef struct rdkcertlocatorResult_s {
+  rdkcertlocatorStatus_t status;   // certlocatorOk, or the status rdkcertlocator_locateCert would return
+  char certUri[PATH_MAX+1];
+  char certCredRef[PARAM_MAX+1];
+  char certPass[PARAM_MAX+1];      // must be wiped with rdkcertlocator_wipeResults after use
+} rdkcertlocatorResult_t;
+
+/**
+ *  API for locating a set of certs in one call, such as all the cert references a device uses.
+ *  The config file is checked once and each distinct credential is fetched once.
+ *  In @param thiscertloc; cert locator handle.
+ *  In @param cert_refs; array of ref_cnt cert references.
+ *  In @param ref_cnt; number of cert references.
+ *  Out @param results; array of ref_cnt results, in the same order as cert_refs.
+ *  @return 0/certlocatorOk if every cert was located, otherwise the status of the first one that was not.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_locateCerts(rdkcertlocator_h thiscertloc, const char **cert_refs, size_t ref_cnt, rdkcertlocatorResult_t *results );
+
+/**
+ *  Wipe the results of rdkcertlocator_locateCerts, including the passcodes.
+ *  In @param results; array of ref_cnt results.
+ *  In @param ref_cnt; number of results.
+**/
+void rdkcertlocator_wipeResults(rdkcertlocatorResult_t *results, size_t ref_cnt );
+
+/**
+ *  Enables automatic reload of the config file and hrot properties file of a cert locator.
+ *  The files, and the directories of the certs named in the config file, are watched with inotify.
+ *  Changes are loaded by a background thread, so locateCert no longer checks the config file on each call.
+ *  Applies to every handle in the process using the same files; stays enabled until they are all freed.
+ *  In @param thiscertloc; cert locator handle.
+ *  @return 0/certlocatorOk for success, non-zero values for the failure; files are then checked on each call.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_enableAutoReload(rdkcertlocator_h thiscertloc );
+
+/**
+ *  Sets how long cert file metadata may be reused before the cert file is checked again.
+ *  With auto reload the metadata is reused until a change is seen, whatever the ttl; the ttl is for
+ *  certs whose config file or directory is not watched. Applies to every handle in the process.
+ *  In @param ttl_ms; time to reuse metadata in milliseconds, 0 (the default) checks the file on every use.
+**/
+void rdkcertlocator_setCertMetaTtl(unsigned int ttl_ms );
+
+/**
+ *  Enables the passcode cache, so locating a cert does not fetch the passcode from rdkconfig every time.
+ *  Passcodes are cached by credential reference in locked memory that is left out of core dumps; they
+ *  are wiped when they expire, when purged, and when the last handle is freed.
+ *  Applies to every handle in the process; off by default.
+ *  In @param ttl_ms; time to reuse a passcode in milliseconds, 0 disables the cache and wipes it.
+ *  @return 0/certlocatorOk for success, certlocatorGeneralFailure if the memory can't be locked,
+ *  the cache is then disabled.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_setPassCacheTtl(unsigned int ttl_ms );
+
+/**
+ *  Wipes the cached passcodes, e.g. after a passcode was changed.
+**/
+void rdkcertlocator_purgePassCache(void );
+
+/* file syscall, cert metadata cache and passcode cache counters, totals for the process */
+typedef struct rdkcertlocatorCounters_s {
+  unsigned long statCalls;     // stat and fstat of config, hrot properties and cert files
+  unsigned long openCalls;     // open of config and hrot properties files
+  unsigned long metaHits;      // cert file checks answered from the metadata cache
+  unsigned long metaMisses;    // cert file checks that had to stat the file
+  unsigned long hashReads;     // cert files read to fingerprint their content
+  unsigned long passHits;      // passcodes answered from the passcode cache, see rdkcertlocator_setPassCacheTtl
+  unsigned long passMisses;    // passcodes fetched from rdkconfig while the passcode cache is enabled
+} rdkcertlocatorCounters_t;
+
+/**
+ *  Gets the file syscall and cert metadata cache counters, to check the cost of locating certs.
+ *  Out @param counters; counters.
+**/
+void rdkcertlocator_getCounters(rdkcertlocatorCounters_t *counters );
+
 
 #ifdef __cplusplus
 }
@@ -111,6 +111,121 @@ rdkcertselectorStatus_t rdkcertselector_getCert(rdkcertselector_h thiscertcel, c
 **/
 rdkcertselectorRetry_t rdkcertselector_setCurlStatus(rdkcertselector_h thiscertsel, unsigned int curlStat, const char *logEndpoint );
 
+/**
+ *  Enables automatic reload of the config file and hrot properties file of a cert selector.
+ *  The files, and the directories of the certs named in the config file, are watched with inotify.
+ *  Changes are loaded by a background thread, so getCert no longer checks the files on each call.
+ *  Applies to every handle in the process using the same files; stays enabled until they are all freed.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure; files are then checked on each call.
+**/
+rdkcertselectorStatus_t rdkcertselector_enableAutoReload(rdkcertselector_h thiscertsel );
+
+/**
+ *  Enables checking of the certs of a cert selector with openssl before getCert returns them.
+ *  Certs that are corrupt, can't be opened with their passcode, have a private key that does not match
+ *  the cert, are expired or are not yet valid are skipped instead of failing the TLS handshake.
+ *  The certs of the cert group are checked ahead by a background thread; results are kept until a cert file changes.
+ *  Skipped certs are still returned as a last resort, as for certs that failed a connection.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure; certselectorGeneralFailure if the
+ *  library was built without cert validation (--enable-certvalidation).
+**/
+rdkcertselectorStatus_t rdkcertselector_enableValidation(rdkcertselector_h thiscertsel );
+
+/**
+ *  Sets how long cert file metadata may be reused before the cert file is checked again.
+ *  With auto reload the metadata is reused until a change is seen, whatever the ttl; the ttl is for
+ *  certs whose config file or directory is not watched. Applies to every handle in the process.
+ *  In @param ttl_ms; time to reuse metadata in milliseconds, 0 (the default) checks the file on every use.
+**/
+void rdkcertselector_setCertMetaTtl(unsigned int ttl_ms );
+
+/**
+ *  Enables the passcode cache, so a getCert does not fetch the passcode from rdkconfig every time.
+ *  Passcodes are cached by credential reference in locked memory that is left out of core dumps; they
+ *  are wiped when they expire, when purged, when a cert is found bad, and when the last handle is freed.
+ *  Applies to every handle in the process; off by default.
+ *  In @param ttl_ms; time to reuse a passcode in milliseconds, 0 disables the cache and wipes it.
+ *  @return 0/certselectorOk for success, certselectorGeneralFailure if the memory can't be locked,
+ *  the cache is then disabled.
+**/
+rdkcertselectorStatus_t rdkcertselector_setPassCacheTtl(unsigned int ttl_ms );
+
+/**
+ *  Wipes the cached passcodes, e.g. after a passcode was changed.
+**/
+void rdkcertselector_purgePassCache(void );
+
+/**
+ *  Enables fetching ahead the passcode of the cert getCert would hand out next if the current one fails,
+ *  so the getCert after a TRY_ANOTHER does not wait for rdkconfig.
+ *  The passcode is fetched by a background thread while the caller connects, and held in the passcode cache.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure; certselectorGeneralFailure if the
+ *  passcode cache is not enabled, see rdkcertselector_setPassCacheTtl.
+**/
+rdkcertselectorStatus_t rdkcertselector_enablePrefetch(rdkcertselector_h thiscertsel );
+
+/**
+ *  Gets the content of the cert file returned by the last getCert, e.g. for CURLOPT_SSLCERT_BLOB.
+ *  The file is read once for each change, later calls get a copy kept in memory.
+ *  Call between getCert and setCurlStatus.
+ *  In @param thiscertsel; cert selector handle.
+ *  Out @param data; content, not null terminated; valid until the next getCert or the handle is freed.
+ *  Out @param len; length of the content.
+ *  @return 0/certselectorOk for success, non-zero values for the failure.
+**/
+rdkcertselectorStatus_t rdkcertselector_getCertBlob(rdkcertselector_h thiscertsel, const unsigned char **data, size_t *len );
+
+/* decoded key and certs of a cert file, openssl objects; EVP_PKEY, X509 and STACK_OF(X509) */
+typedef struct rdkcertselectorKeyMaterial_s {
+  struct evp_pkey_st *pkey;      // private key, NULL if the key is not in the file, e.g. it is in the hrot engine
+  struct x509_st *cert;          // client cert
+  struct stack_st_X509 *chain;   // CA certs in the file, NULL if none
+} rdkcertselectorKeyMaterial_t;
+
+/**
+ *  Gets the decoded private key, cert and CA chain of the cert returned by the last getCert, so the
+ *  caller can hand them to its TLS stack instead of the cert file and passcode.
+ *  The file is decoded once for its content and passcode, later calls get the same objects from a cache.
+ *  Each object has a reference of its own, release them with rdkcertselector_freeKeyMaterial.
+ *  Call between getCert and setCurlStatus.
+ *  In @param thiscertsel; cert selector handle.
+ *  Out @param keyMaterial; decoded objects, all NULL on failure.
+ *  @return 0/certselectorOk for success, certselectorFileError if the cert can't be decoded with its passcode,
+ *  certselectorGeneralFailure if the library was built without openssl (--enable-certvalidation).
+**/
+rdkcertselectorStatus_t rdkcertselector_getKeyMaterial(rdkcertselector_h thiscertsel, rdkcertselectorKeyMaterial_t *keyMaterial );
+
+/**
+ *  Releases the objects from rdkcertselector_getKeyMaterial, and sets them to NULL.
+ *  In/Out @param keyMaterial; decoded objects.
+**/
+void rdkcertselector_freeKeyMaterial(rdkcertselectorKeyMaterial_t *keyMaterial );
+
+/* file syscall, cert metadata cache, passcode cache and cert validation counters, totals for the process */
+typedef struct rdkcertselectorCounters_s {
+  unsigned long statCalls;     // stat and fstat of config, hrot properties and cert files
+  unsigned long openCalls;     // open of config and hrot properties files
+  unsigned long metaHits;      // cert file checks answered from the metadata cache
+  unsigned long metaMisses;    // cert file checks that had to stat the file
+  unsigned long hashReads;     // cert files read to fingerprint their content
+  unsigned long blobReads;     // cert files read to keep a copy in memory, see rdkcertselector_getCertBlob
+  unsigned long passHits;      // passcodes answered from the passcode cache, see rdkcertselector_setPassCacheTtl
+  unsigned long passMisses;    // passcodes fetched from rdkconfig while the passcode cache is enabled
+  unsigned long passPrefetches; // passcodes fetched ahead into the passcode cache, see rdkcertselector_enablePrefetch
+  unsigned long certChecks;    // certs checked before use, see rdkcertselector_enableValidation
+  unsigned long certParses;    // certs parsed with openssl, the other checks were answered from the cache
+  unsigned long certRejects;   // checks that found a cert unusable
+} rdkcertselectorCounters_t;
+
+/**
+ *  Gets the file syscall and cert metadata cache counters, to check the cost of cert selection.
+ *  Out @param counters; counters.
+**/
+void rdkcertselector_getCounters(rdkcertselectorCounters_t *counters );
+
 
 #ifdef __cplusplus
 }
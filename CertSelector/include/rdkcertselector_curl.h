@@ -0,0 +1,88 @@
+#ifndef __RDKCERTSELECTOR_CURL__
+#define __RDKCERTSELECTOR_CURL__
+
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// libcurl helper for the cert selector, in libRdkCertSelectorCurl
+
+#include <curl/curl.h>
+
+// curl/curl.h includes <linux/limits.h>, rdkcertselector.h has its own PATH_MAX for object lengths
+#undef PATH_MAX
+#include "rdkcertselector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Selects a cert with rdkcertselector_getCert and sets it on a curl easy handle.
+ *  The cert is set from a copy kept in memory (CURLOPT_SSLCERT_BLOB, and CURLOPT_SSLKEY_BLOB for PEM),
+ *  so the file is not read on each connection; with an hrot engine, the engine is set and the cert
+ *  is set by path. The passcode is set with CURLOPT_KEYPASSWD.
+ *  Use in place of getCert, then pass the curl result to rdkcertselector_setCurlStatus as usual:
+ *    do {
+ *      if ( rdkcertselector_applyToCurl( cs, easy ) != certselectorOk ) break;
+ *      rc = curl_easy_perform( easy );
+ *    } while ( rdkcertselector_setCurlStatus( cs, rc, url ) == TRY_ANOTHER );
+ *  In @param thiscertsel; cert selector handle.
+ *  In @param easy; curl easy handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure; if the options could not be set,
+ *  the cert is released and setCurlStatus must not be called.
+**/
+rdkcertselectorStatus_t rdkcertselector_applyToCurl(rdkcertselector_h thiscertsel, CURL *easy );
+
+/**
+ *  Performs a request, trying the certs of the group in turn until one is not rejected.
+ *  Runs the applyToCurl, curl_easy_perform, setCurlStatus loop on the one easy handle, so its
+ *  connection cache and options are kept across attempts; set the url and other options first.
+ *  Each attempt is logged with its curl result and duration, and counted, see getPerformCounters.
+ *  TLS sessions are cached per cert, so a later transfer with the same cert to the same host resumes
+ *  the session instead of a full handshake, with any easy handle; the sessions of a cert are dropped
+ *  when the cert file changes or the cert is rejected, and are never resumed with another cert.
+ *  In @param thiscertsel; cert selector handle.
+ *  In @param easy; curl easy handle.
+ *  Out @param httpCode; response code of the last attempt, 0 if none; may be NULL.
+ *  @return curl result of the last attempt; CURLE_SSL_CERTPROBLEM if no cert could be applied,
+ *  CURLE_BAD_FUNCTION_ARGUMENT for a NULL handle.
+**/
+CURLcode rdkcertselector_perform(rdkcertselector_h thiscertsel, CURL *easy, long *httpCode );
+
+/* rdkcertselector_perform counters, totals for the process */
+typedef struct rdkcertselectorPerformCounters_s {
+  unsigned long performs;            // calls to rdkcertselector_perform
+  unsigned long attempts;            // curl_easy_perform calls, one per cert tried
+  unsigned long retries;             // attempts with another cert after a cert error
+  unsigned long long attemptUsec;    // total duration of the attempts, microseconds
+  unsigned long maxAttemptUsec;      // longest attempt, microseconds
+  unsigned long sessionCaches;       // tls session caches made, one per cert version
+  unsigned long sessionDrops;        // tls session caches dropped for a changed or rejected cert
+} rdkcertselectorPerformCounters_t;
+
+/**
+ *  Gets the rdkcertselector_perform counters.
+ *  Out @param counters; counter values.
+**/
+void rdkcertselector_getPerformCounters(rdkcertselectorPerformCounters_t *counters );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RDKCERTSELECTOR_CURL__
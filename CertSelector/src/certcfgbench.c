@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// config parser benchmark, build and run with "make -f Makefile.vm bench"
+// compares the field slice parser, rdkcertcfg_parseFile, with reading lines with fgets
+// and tokenizing them with strtok_r into a stack buffer, as certsel_findCert and certloc_locateCert used to
+// on every call; configs of 10 and 50000 lines are written to ./ut
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "rdkcertcfg.h"
+
+#define MAX_LINE_LENGTH 1024
+#define DELIM_STR ","
+#define GRPDELIM_STR "|"
+#define URI_MAX 128
+#define CRED_MAX 64
+
+typedef struct bench_cfg_s {
+  const char *path;
+  int lines;
+  int iters;
+} bench_cfg_t;
+
+static double now( void ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// last line is the one looked up, so every parser reads the whole file
+static int writeCfg( const char *path, int lines ) {
+  FILE *fp = fopen( path, "w" );
+  if ( fp == NULL ) {
+    return -1;
+  }
+  int line;
+  for ( line = 0; line < lines - 1; line++ ) {
+    fprintf( fp, "GRP%d|GRPX%d,REF%d,P12,file:///opt/certs/bench%d.p12,benchpc%d\n", line % 97, line % 13, line, line, line );
+  }
+  fprintf( fp, "BENCHGRP,BENCHREF,P12,file:///opt/certs/bench.p12,benchpc\n" );
+  fclose( fp );
+  return 0;
+}
+
+// fgets and strtok_r scan of the whole file for the first row in group, fields copied out of the line buffer
+static int lineFindCert( const char *path, const char *group, char *uri, char *credref ) {
+  FILE *cfgfp = fopen( path, "r" );
+  if ( cfgfp == NULL ) {
+    return certcfgFileNotFound;
+  }
+  int retval = certcfgFileNotFound;
+  char cfgline[MAX_LINE_LENGTH+1];
+  char *savetok_f, *savetok_g;
+  cfgline[MAX_LINE_LENGTH-1] = '\0';
+  while ( fgets( cfgline, sizeof(cfgline), cfgfp ) ) {
+    if ( cfgline[MAX_LINE_LENGTH-1] != '\0' ) {
+      retval = certcfgFileError;
+      break;
+    }
+    char *nl = strchr( cfgline, '\n' );
+    if ( nl != NULL ) *nl = '\0';
+    char *cfgfield = strtok_r( cfgline, DELIM_STR, &savetok_f );
+    char *cfggrp = ( cfgfield != NULL ) ? strtok_r( cfgfield, GRPDELIM_STR, &savetok_g ) : NULL;
+    while ( cfggrp != NULL && strcmp( cfggrp, group ) != 0 ) {
+      cfggrp = strtok_r( NULL, GRPDELIM_STR, &savetok_g );
+    }
+    if ( cfggrp == NULL ) {
+      continue;
+    }
+    strtok_r( NULL, DELIM_STR, &savetok_f );
+    strtok_r( NULL, DELIM_STR, &savetok_f );
+    char *urifld = strtok_r( NULL, DELIM_STR, &savetok_f );
+    char *credfld = strtok_r( NULL, DELIM_STR, &savetok_f );
+    if ( urifld == NULL || credfld == NULL || strlen( urifld ) >= URI_MAX || strlen( credfld ) >= CRED_MAX ) {
+      retval = certcfgFileError;
+    } else {
+      strcpy( uri, urifld );
+      strcpy( credref, credfld );
+      retval = certcfgOk;
+    }
+    break;
+  }
+  fclose( cfgfp );
+  return retval;
+}
+
+// parse into an image, then select the first row in group and copy its fields
+static int sliceFindCert( const char *path, const char *group, char *uri, char *credref ) {
+  rdkcertcfgSnap_t *snap = rdkcertcfg_parseFile( path );
+  if ( snap == NULL ) {
+    return certcfgFileNotFound;
+  }
+  const rdkcertcfgRow_t *row = NULL;
+  int retval = snap->endStat;
+  if ( rdkcertcfg_groupRows( snap, group, &row, 1 ) > 0 ) {
+    retval = rdkcertcfg_rowCert( snap, row, uri, URI_MAX, credref, CRED_MAX );
+  }
+  rdkcertcfg_release( &snap );
+  return retval;
+}
+
+int main( int argc, char *argv[] ) {
+  bench_cfg_t cfgs[] = {
+    { "./ut/bench10.cfg", 10, 20000 },
+    { "./ut/bench50k.cfg", 50000, 20 },
+  };
+  char uri[URI_MAX], credref[CRED_MAX];
+  size_t cfgIndx;
+
+  for ( cfgIndx = 0; cfgIndx < sizeof(cfgs)/sizeof(cfgs[0]); cfgIndx++ ) {
+    bench_cfg_t *cfg = &cfgs[cfgIndx];
+    if ( writeCfg( cfg->path, cfg->lines ) != 0 ) {
+      fprintf( stderr, "unable to write %s\n", cfg->path );
+      return 1;
+    }
+
+    int iter;
+    double start = now();
+    for ( iter = 0; iter < cfg->iters; iter++ ) {
+      if ( lineFindCert( cfg->path, "BENCHGRP", uri, credref ) != certcfgOk || strcmp( credref, "benchpc" ) != 0 ) {
+        fprintf( stderr, "fgets/strtok_r lookup failed\n" );
+        return 1;
+      }
+    }
+    double lineTime = ( now() - start ) / cfg->iters;
+
+    start = now();
+    for ( iter = 0; iter < cfg->iters; iter++ ) {
+      if ( sliceFindCert( cfg->path, "BENCHGRP", uri, credref ) != certcfgOk || strcmp( credref, "benchpc" ) != 0 ) {
+        fprintf( stderr, "slice parser lookup failed\n" );
+        return 1;
+      }
+    }
+    double sliceTime = ( now() - start ) / cfg->iters;
+
+    // parsed image reused while the file does not change, as the libraries do; index built before timing
+    rdkcertcfgSnap_t *snap = rdkcertcfg_parseFile( cfg->path );
+    const rdkcertcfgRow_t *row = rdkcertcfg_findRef( snap, "BENCHREF" );
+    int lookups = cfg->iters * 100;
+    start = now();
+    for ( iter = 0; iter < lookups; iter++ ) {
+      row = rdkcertcfg_findRef( snap, "BENCHREF" );
+      rdkcertcfg_rowCert( snap, row, uri, URI_MAX, credref, CRED_MAX );
+    }
+    double cachedTime = ( now() - start ) / lookups;
+    rdkcertcfg_release( &snap );
+
+    printf( "%6d lines: fgets/strtok_r %10.2f us, slice parser %10.2f us (%.2fx), cached image lookup %6.3f us\n",
+            cfg->lines, lineTime * 1e6, sliceTime * 1e6, lineTime / sliceTime, cachedTime * 1e6 );
+  }
+  return 0;
+}
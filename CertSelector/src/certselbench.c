@@ -0,0 +1,187 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// cert selector benchmark, build and run with "make -f Makefile.vm bench"
+// measures getCert/setCurlStatus as the number of candidates in the cert group grows:
+//   steady state, getCert and a successful setCurlStatus on the first candidate
+//   failover, getCert and a cert error on each candidate in turn, so the selector walks the whole group
+// both are per call pair and should not depend on the number of candidates; configs are written to ./ut
+// each is run with the passcode cache disabled, then enabled; a cost above BENCH_RATIO_MAX times the
+// smallest group's is reported and the benchmark fails; each is the best of BENCH_REPEAT runs, the group sizes
+// taking turns, so clock and scheduling noise does not land on one size
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "rdkcertselector.h"
+#include "rdkconfig.h"
+
+#define BENCH_CERT "./ut/benchcert.p12"
+#define BENCH_PASS "benchpass"
+#define BENCH_HROT "./ut/benchhrot.properties"
+#define BENCH_GROUP "BENCHGRP"
+#define CURLERR_LOCALCERT 58
+#define BENCH_RATIO_MAX 1.3
+#define BENCH_REPEAT 5
+#define BENCH_CALLS 50000  // call pairs per run
+
+// passcode store stand in, every credref has the same passcode
+int rdkconfig_getStr( char **sbuff, size_t *sbuffsz, const char *refname ) {
+  *sbuff = strdup( BENCH_PASS );
+  if ( *sbuff == NULL ) {
+    return RDKCONFIG_FAIL;
+  }
+  *sbuffsz = sizeof(BENCH_PASS);
+  return RDKCONFIG_OK;
+}
+
+int rdkconfig_freeStr( char **sbuff, size_t sbuffsz ) {
+  memset( *sbuff, 0, sbuffsz );
+  free( *sbuff );
+  *sbuff = NULL;
+  return RDKCONFIG_OK;
+}
+
+static double now( void ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// every candidate names the same cert, other groups are interleaved so the candidates are not adjacent rows
+static int writeCfg( const char *path, int cands ) {
+  FILE *fp = fopen( path, "w" );
+  if ( fp == NULL ) {
+    return -1;
+  }
+  int cand;
+  for ( cand = 0; cand < cands; cand++ ) {
+    fprintf( fp, "OTHERGRP,OTHER%d,P12,file://%s,otherpc%d\n", cand, BENCH_CERT, cand );
+    fprintf( fp, BENCH_GROUP ",BENCH%d,P12,file://%s,benchpc%d\n", cand, BENCH_CERT, cand );
+  }
+  fclose( fp );
+  return 0;
+}
+
+// time the steady state and failover step per call pair for a cert group of cands candidates
+// returns 0, or 1 if a call did not do what was expected
+static int benchCands( int cands, double *steadyTime, double *failoverTime ) {
+  char *certUri = NULL, *certPass = NULL;
+  char path[64];
+  snprintf( path, sizeof(path), "./ut/benchsel%d.cfg", cands );
+  if ( writeCfg( path, cands ) != 0 ) {
+    fprintf( stderr, "unable to write %s\n", path );
+    return 1;
+  }
+
+  rdkcertselector_h cs = rdkcertselector_new( path, BENCH_HROT, BENCH_GROUP );
+  if ( cs == NULL ) {
+    fprintf( stderr, "selector not created for %s\n", path );
+    return 1;
+  }
+
+  int iter, iters = BENCH_CALLS;
+  double start = now();
+  for ( iter = 0; iter < iters; iter++ ) {
+    if ( rdkcertselector_getCert( cs, &certUri, &certPass ) != certselectorOk ||
+         rdkcertselector_setCurlStatus( cs, 0, "bench" ) != NO_RETRY ) {
+      fprintf( stderr, "steady state failed\n" );
+      return 1;
+    }
+  }
+  *steadyTime = ( now() - start ) / iters;
+
+  // a fresh selector for each walk, each candidate fails once; the last one has no next cert
+  // freeing the selector is counted, it drops the passcode cache holds of the walk
+  int walks = ( BENCH_CALLS / cands ) + 1, walk, steps = 0;
+  double walkTime = 0;
+  for ( walk = 0; walk < walks; walk++ ) {
+    rdkcertselector_h wcs = rdkcertselector_new( path, BENCH_HROT, BENCH_GROUP );
+    if ( wcs == NULL ) {
+      fprintf( stderr, "selector not created for %s\n", path );
+      return 1;
+    }
+    rdkcertselectorRetry_t retry = TRY_ANOTHER;
+    start = now();
+    while ( retry == TRY_ANOTHER ) {
+      if ( rdkcertselector_getCert( wcs, &certUri, &certPass ) != certselectorOk ) {
+        fprintf( stderr, "failover failed\n" );
+        return 1;
+      }
+      retry = rdkcertselector_setCurlStatus( wcs, CURLERR_LOCALCERT, "bench" );
+      steps++;
+    }
+    rdkcertselector_free( &wcs );
+    walkTime += now() - start;
+  }
+  if ( steps != walks * cands ) {
+    fprintf( stderr, "failover walked %d of %d candidates\n", steps, walks * cands );
+    return 1;
+  }
+  *failoverTime = walkTime / steps;
+  rdkcertselector_free( &cs );
+  return 0;
+}
+
+int main( int argc, char *argv[] ) {
+  int candCnts[] = { 6, 64, 1024 };
+  unsigned int passTtls[] = { 0, 60000 };
+  size_t cntIndx, ttlIndx;
+  int overBound = 0;
+
+  FILE *fp = fopen( BENCH_CERT, "w" );
+  if ( fp == NULL ) {
+    fprintf( stderr, "unable to write %s\n", BENCH_CERT );
+    return 1;
+  }
+  fclose( fp );
+
+  for ( ttlIndx = 0; ttlIndx < sizeof(passTtls)/sizeof(passTtls[0]); ttlIndx++ ) {
+    if ( rdkcertselector_setPassCacheTtl( passTtls[ttlIndx] ) != certselectorOk ) {
+      fprintf( stderr, "passcode cache not set\n" );
+      return 1;
+    }
+    printf( "passcode cache %s\n", passTtls[ttlIndx] ? "enabled" : "disabled" );
+    double steadyTimes[sizeof(candCnts)/sizeof(candCnts[0])], failoverTimes[sizeof(candCnts)/sizeof(candCnts[0])];
+    int rep;
+    for ( rep = 0; rep < BENCH_REPEAT; rep++ ) {
+      for ( cntIndx = 0; cntIndx < sizeof(candCnts)/sizeof(candCnts[0]); cntIndx++ ) {
+        double steadyRep, failoverRep;
+        if ( benchCands( candCnts[cntIndx], &steadyRep, &failoverRep ) != 0 ) {
+          return 1;
+        }
+        if ( rep == 0 || steadyRep < steadyTimes[cntIndx] ) steadyTimes[cntIndx] = steadyRep;
+        if ( rep == 0 || failoverRep < failoverTimes[cntIndx] ) failoverTimes[cntIndx] = failoverRep;
+      }
+    }
+    for ( cntIndx = 0; cntIndx < sizeof(candCnts)/sizeof(candCnts[0]); cntIndx++ ) {
+      double steadyRatio = steadyTimes[cntIndx] / steadyTimes[0], failoverRatio = failoverTimes[cntIndx] / failoverTimes[0];
+      printf( "%5d candidates: steady state %7.3f us (%.2fx), failover step %7.3f us (%.2fx)\n", candCnts[cntIndx],
+              steadyTimes[cntIndx] * 1e6, steadyRatio, failoverTimes[cntIndx] * 1e6, failoverRatio );
+      if ( steadyRatio > BENCH_RATIO_MAX || failoverRatio > BENCH_RATIO_MAX ) {
+        printf( "WARNING: %d candidates cost more than %.2fx of %d\n", candCnts[cntIndx], BENCH_RATIO_MAX, candCnts[0] );
+        overBound = 1;
+      }
+    }
+  }
+  rdkcertselector_setPassCacheTtl( 0 );
+  return overBound;
+}
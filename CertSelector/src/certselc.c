@@ -0,0 +1,779 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// certselc - compile certsel.cfg into certsel.bin, or verify a certsel.bin
+//
+// certselc [-o <certsel.bin>] <certsel.cfg>    compile, then verify the output
+// certselc -v <certsel.bin> [<certsel.cfg>]    verify, optionally against the text config
+//
+// the compiled file is used by the cert selector and cert locator libraries when it is newer than
+// the config file; see rdkcertcfg.h for the format
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rdkcertcfg.h"
+
+#define CMD "certselc"
+#define OUT_SWITCH "-o"
+#define VERIFY_SWITCH "-v"
+#define TMP_SUFFIX ".tmp"
+#define MAX_DISP 0x100000   // give up on a bucket after this many displacements, then add buckets
+#define GRPDELIM_CHAR '|'
+
+// string to index map, used to intern strings and collect keys
+// keys are copied, null terminated, when added and freed with the map
+typedef struct certselc_map_s {
+  char **keys;
+  uint32_t *vals;
+  size_t cap;       // power of 2
+  size_t cnt;
+} certselc_map_t;
+
+// key being compiled into a perfect hash table
+typedef struct certselc_key_s {
+  const char *name;
+  uint32_t nameOff;
+  uint32_t first;
+  uint32_t count;
+} certselc_key_t;
+
+// group being compiled, candidate rows in file order
+typedef struct certselc_grp_s {
+  const char *name;
+  uint32_t *rows;
+  uint32_t rowCnt;
+  uint32_t rowMax;
+} certselc_grp_t;
+
+static int certselc_mapInit( certselc_map_t *map );
+static void certselc_mapFree( certselc_map_t *map );
+static uint32_t *certselc_mapFind( certselc_map_t *map, const char *key, size_t keylen, int *added, uint32_t newval );
+static const char *certselc_mapKey( const certselc_map_t *map, const uint32_t *val );
+static const char *certselc_nextGroup( const char **grpfield, const char *fldend, size_t *grplen );
+static int certselc_perfectHash( certselc_key_t *keys, uint32_t keyCnt, const char *pool,
+                                 rdkcertcfgBinKey_t **slots, uint32_t *slotCnt, uint32_t **disp, uint32_t *dispCnt );
+static int certselc_writeFile( const char *binpath, const void *data, size_t len );
+
+#if !defined(GTEST_ENABLE)
+int main( int argc, char *argv[] ) {
+  const char *binpath = NULL;
+  const char *cfgpath = NULL;
+
+  if ( argc >= 3 && strcmp( argv[1], VERIFY_SWITCH ) == 0 ) {
+    binpath = argv[2];
+    cfgpath = ( argc > 3 ) ? argv[3] : NULL;
+    if ( rdkcertcfg_verify( binpath, cfgpath ) != certcfgOk ) {
+      return 1; // error
+    }
+    fprintf( stderr, "%s: %s ok\n", CMD, binpath );
+    return 0;
+  }
+
+  if ( argc >= 4 && strcmp( argv[1], OUT_SWITCH ) == 0 ) {
+    binpath = argv[2];
+    cfgpath = argv[3];
+  } else if ( argc == 2 && argv[1][0] != '-' ) {
+    cfgpath = argv[1];
+  } else {
+    fprintf( stderr, "usage: %s [%s <certsel.bin>] <certsel.cfg>\n", CMD, OUT_SWITCH );
+    fprintf( stderr, "       %s %s <certsel.bin> [<certsel.cfg>]\n", CMD, VERIFY_SWITCH );
+    return 1; // error
+  }
+
+  char *defpath = NULL;
+  if ( binpath == NULL ) {
+    defpath = rdkcertcfg_binPath( cfgpath );
+    if ( defpath == NULL ) {
+      fprintf( stderr, "%s: mem error\n", CMD );
+      return 1;
+    }
+    binpath = defpath;
+  }
+
+  int exitcd = 1;
+  if ( rdkcertcfg_compile( cfgpath, binpath ) == certcfgOk &&
+       rdkcertcfg_verify( binpath, cfgpath ) == certcfgOk ) {
+    fprintf( stderr, "%s: %s -> %s ok\n", CMD, cfgpath, binpath );
+    exitcd = 0;
+  }
+  free( defpath );
+  return exitcd;
+}
+#endif // !GTEST_ENABLE
+
+/**
+ * Compile a text config file.
+ * In @param path; text config file
+ * In @param binpath; compiled config file, replaced atomically
+ * @return certcfgOk, certcfgFileNotFound if the config can't be read, otherwise certcfgGeneralFailure
+**/
+rdkcertcfgStatus_t rdkcertcfg_compile( const char *path, const char *binpath ) {
+  if ( path == NULL || binpath == NULL ) {
+    fprintf( stderr, "%s: error, null argument\n", CMD );
+    return certcfgBadPointer;
+  }
+
+  rdkcertcfgSnap_t *snap = rdkcertcfg_parseFile( path );
+  if ( snap == NULL ) {
+    fprintf( stderr, "%s: error, unable to read %s\n", CMD, path );
+    return certcfgFileNotFound;
+  }
+
+  rdkcertcfgStatus_t retval = certcfgGeneralFailure;
+  certselc_map_t strmap, grpmap, refmap;
+  int mapsok = certselc_mapInit( &strmap ) & certselc_mapInit( &grpmap ) & certselc_mapInit( &refmap );
+
+  size_t rowCnt = snap->rowCnt;
+  rdkcertcfgRow_t *rows = (rdkcertcfgRow_t *)calloc( rowCnt + 1, sizeof(rdkcertcfgRow_t) );
+  char *pool = (char *)malloc( 1 );
+  size_t poolSz = 0;
+  certselc_grp_t *grps = NULL;
+  certselc_key_t *grpkeys = NULL, *refkeys = NULL;
+  uint32_t grpCnt = 0, refCnt = 0, candCnt = 0;
+  uint32_t *cand = NULL;
+  rdkcertcfgBinKey_t *grpslots = NULL, *refslots = NULL;
+  uint32_t *grpdisp = NULL, *refdisp = NULL;
+  uint32_t grpslotCnt = 0, grpdispCnt = 0, refslotCnt = 0, refdispCnt = 0;
+  char *binbuf = NULL;
+  const char *err = NULL;
+  size_t rowIndx;
+  uint16_t fld;
+
+  if ( !mapsok || rows == NULL || pool == NULL ) {
+    err = "mem error";
+  }
+
+  // intern all fields; rows point into the new pool
+  for ( rowIndx = 0; err == NULL && rowIndx < rowCnt; rowIndx++ ) {
+    const rdkcertcfgRow_t *row = &snap->rows[rowIndx];
+    rows[rowIndx].fieldCnt = row->fieldCnt;
+    for ( fld = 0; err == NULL && fld < row->fieldCnt; fld++ ) {
+      size_t fieldlen = 0;
+      const char *field = rdkcertcfg_field( snap, row, fld, &fieldlen );
+      int added = 0;
+      uint32_t *off = certselc_mapFind( &strmap, field, fieldlen, &added, (uint32_t)poolSz );
+      rows[rowIndx].fieldLen[fld] = (uint16_t)fieldlen;
+      if ( off == NULL ) {
+        err = "mem error";
+      } else if ( added ) {
+        char *newpool = (char *)realloc( pool, poolSz + fieldlen + 1 );
+        if ( newpool == NULL || poolSz + fieldlen + 1 > UINT32_MAX ) {
+          err = "mem error";
+          break;
+        }
+        pool = newpool;
+        memcpy( pool + poolSz, field, fieldlen );
+        pool[poolSz + fieldlen] = '\0';
+        poolSz += fieldlen + 1;
+      }
+      if ( off != NULL ) {
+        rows[rowIndx].fieldOff[fld] = *off;
+      }
+    }
+  }
+
+  // collect groups with their candidate rows, and the first row of each cert ref
+  // group names are interned as well, they are substrings of the group field
+  for ( rowIndx = 0; err == NULL && rowIndx < rowCnt; rowIndx++ ) {
+    const rdkcertcfgRow_t *row = &snap->rows[rowIndx];
+    size_t fldlen = 0;
+    const char *grpfield = rdkcertcfg_field( snap, row, CERTCFG_FLD_GROUP, &fldlen );
+    const char *fldend = grpfield + fldlen;
+    while ( err == NULL ) {
+      size_t grplen = 0;
+      const char *grpname = certselc_nextGroup( &grpfield, fldend, &grplen );
+      if ( grpname == NULL ) {
+        break;
+      }
+      int added = 0;
+      uint32_t *gi = certselc_mapFind( &grpmap, grpname, grplen, &added, grpCnt );
+      const char *grpkey = certselc_mapKey( &grpmap, gi );
+      if ( gi == NULL ) {
+        err = "mem error";
+        break;
+      }
+      if ( added ) {
+        certselc_grp_t *newgrps = (certselc_grp_t *)realloc( grps, ( grpCnt + 1 ) * sizeof(certselc_grp_t) );
+        if ( newgrps == NULL ) {
+          err = "mem error";
+          break;
+        }
+        grps = newgrps;
+        memset( &grps[grpCnt], 0, sizeof(certselc_grp_t) );
+        grps[grpCnt].name = grpkey;
+        grpCnt++;
+      }
+      certselc_grp_t *grp = &grps[*gi];
+      // a group listed twice on the same line is still one candidate
+      if ( grp->rowCnt > 0 && grp->rows[grp->rowCnt-1] == rowIndx ) {
+        continue;
+      }
+      if ( grp->rowCnt == grp->rowMax ) {
+        uint32_t newmax = grp->rowMax ? 2 * grp->rowMax : 4;
+        uint32_t *newrows = (uint32_t *)realloc( grp->rows, newmax * sizeof(uint32_t) );
+        if ( newrows == NULL ) {
+          err = "mem error";
+          break;
+        }
+        grp->rows = newrows;
+        grp->rowMax = newmax;
+      }
+      grp->rows[grp->rowCnt++] = (uint32_t)rowIndx;
+      candCnt++;
+    }
+
+    size_t reflen = 0;
+    const char *certRef = rdkcertcfg_field( snap, row, CERTCFG_FLD_LABEL, &reflen );
+    if ( err == NULL && certRef != NULL ) {
+      int added = 0;
+      if ( certselc_mapFind( &refmap, certRef, reflen, &added, (uint32_t)rowIndx ) == NULL ) {
+        err = "mem error";
+      }
+    }
+  }
+
+  // group names into the pool, candidate rows into one array
+  if ( err == NULL ) {
+    grpkeys = (certselc_key_t *)calloc( grpCnt + 1, sizeof(certselc_key_t) );
+    refkeys = (certselc_key_t *)calloc( refmap.cnt + 1, sizeof(certselc_key_t) );
+    cand = (uint32_t *)malloc( ( candCnt + 1 ) * sizeof(uint32_t) );
+    if ( grpkeys == NULL || refkeys == NULL || cand == NULL ) {
+      err = "mem error";
+    }
+  }
+  uint32_t grpIndx, candIndx = 0;
+  for ( grpIndx = 0; err == NULL && grpIndx < grpCnt; grpIndx++ ) {
+    int added = 0;
+    uint32_t *off = certselc_mapFind( &strmap, grps[grpIndx].name, strlen( grps[grpIndx].name ), &added, (uint32_t)poolSz );
+    if ( off == NULL ) {
+      err = "mem error";
+      break;
+    }
+    if ( added ) {
+      size_t namelen = strlen( grps[grpIndx].name ) + 1;
+      char *newpool = (char *)realloc( pool, poolSz + namelen );
+      if ( newpool == NULL ) {
+        err = "mem error";
+        break;
+      }
+      pool = newpool;
+      memcpy( pool + poolSz, grps[grpIndx].name, namelen );
+      poolSz += namelen;
+    }
+    grpkeys[grpIndx].name = grps[grpIndx].name;
+    grpkeys[grpIndx].nameOff = *off;
+    grpkeys[grpIndx].first = candIndx;
+    grpkeys[grpIndx].count = grps[grpIndx].rowCnt;
+    memcpy( cand + candIndx, grps[grpIndx].rows, grps[grpIndx].rowCnt * sizeof(uint32_t) );
+    candIndx += grps[grpIndx].rowCnt;
+  }
+  size_t slot;
+  for ( slot = 0; err == NULL && slot < refmap.cap; slot++ ) {
+    if ( refmap.keys[slot] != NULL ) {
+      int added = 0;
+      refkeys[refCnt].name = refmap.keys[slot];
+      refkeys[refCnt].nameOff = *certselc_mapFind( &strmap, refmap.keys[slot], strlen( refmap.keys[slot] ), &added, 0 ); // always a field
+      refkeys[refCnt].first = refmap.vals[slot];
+      refkeys[refCnt].count = 1;
+      refCnt++;
+    }
+  }
+
+  if ( err == NULL &&
+       ( certselc_perfectHash( grpkeys, grpCnt, pool, &grpslots, &grpslotCnt, &grpdisp, &grpdispCnt ) != 0 ||
+         certselc_perfectHash( refkeys, refCnt, pool, &refslots, &refslotCnt, &refdisp, &refdispCnt ) != 0 ) ) {
+    err = "hash error";
+  }
+
+  // lay out the file, every table 4 byte aligned
+  size_t binLen = 0;
+  if ( err == NULL ) {
+    rdkcertcfgBinHdr_t hdr;
+    memset( &hdr, 0, sizeof(hdr) );
+    memcpy( hdr.magic, CERTCFG_BIN_MAGIC, sizeof(hdr.magic) );
+    hdr.version = CERTCFG_BIN_VERSION;
+    hdr.bom = CERTCFG_BIN_BOM;
+    hdr.endStat = snap->endStat;
+    binLen = sizeof(hdr);
+#define CERTSELC_TABLE( offfld, cntfld, cnt, elsz ) \
+    hdr.offfld = (uint32_t)binLen; hdr.cntfld = (uint32_t)(cnt); \
+    binLen += ( (size_t)(cnt) * (elsz) + 3 ) & ~(size_t)3;
+    CERTSELC_TABLE( rowOff, rowCnt, rowCnt, sizeof(rdkcertcfgRow_t) );
+    CERTSELC_TABLE( poolOff, poolSz, poolSz, 1 );
+    CERTSELC_TABLE( candOff, candCnt, candCnt, sizeof(uint32_t) );
+    CERTSELC_TABLE( grpOff, grpCnt, grpslotCnt, sizeof(rdkcertcfgBinKey_t) );
+    CERTSELC_TABLE( grpDispOff, grpDispCnt, grpdispCnt, sizeof(uint32_t) );
+    CERTSELC_TABLE( refOff, refCnt, refslotCnt, sizeof(rdkcertcfgBinKey_t) );
+    CERTSELC_TABLE( refDispOff, refDispCnt, refdispCnt, sizeof(uint32_t) );
+#undef CERTSELC_TABLE
+    if ( binLen > UINT32_MAX ) {
+      err = "size error";
+    } else {
+      binbuf = (char *)calloc( 1, binLen );
+      if ( binbuf == NULL ) {
+        err = "mem error";
+      }
+    }
+    if ( err == NULL ) {
+      hdr.fileSize = (uint32_t)binLen;
+      memcpy( binbuf + hdr.rowOff, rows, rowCnt * sizeof(rdkcertcfgRow_t) );
+      memcpy( binbuf + hdr.poolOff, pool, poolSz );
+      memcpy( binbuf + hdr.candOff, cand, candCnt * sizeof(uint32_t) );
+      memcpy( binbuf + hdr.grpOff, grpslots, grpslotCnt * sizeof(rdkcertcfgBinKey_t) );
+      memcpy( binbuf + hdr.grpDispOff, grpdisp, grpdispCnt * sizeof(uint32_t) );
+      memcpy( binbuf + hdr.refOff, refslots, refslotCnt * sizeof(rdkcertcfgBinKey_t) );
+      memcpy( binbuf + hdr.refDispOff, refdisp, refdispCnt * sizeof(uint32_t) );
+      hdr.checksum = rdkcertcfg_binHash( binbuf + sizeof(hdr), binLen - sizeof(hdr), 0 );
+      memcpy( binbuf, &hdr, sizeof(hdr) );
+    }
+  }
+
+  if ( err == NULL ) {
+    if ( certselc_writeFile( binpath, binbuf, binLen ) == 0 ) {
+      fprintf( stderr, "%s: %zu rows, %u groups, %u cert refs, %zu bytes\n", CMD, rowCnt, grpCnt, refCnt, binLen );
+      retval = certcfgOk;
+    }
+  } else {
+    fprintf( stderr, "%s: error, %s compiling %s\n", CMD, err, path );
+  }
+
+  for ( grpIndx = 0; grps != NULL && grpIndx < grpCnt; grpIndx++ ) {
+    free( grps[grpIndx].rows );
+  }
+  free( grps );
+  free( binbuf );
+  free( grpslots );
+  free( grpdisp );
+  free( refslots );
+  free( refdisp );
+  free( grpkeys );
+  free( refkeys );
+  free( cand );
+  free( pool );
+  free( rows );
+  certselc_mapFree( &refmap );
+  certselc_mapFree( &grpmap );
+  certselc_mapFree( &strmap );
+  rdkcertcfg_release( &snap );
+  return retval;
+} // rdkcertcfg_compile( )
+
+/**
+ * Verify a compiled config file.
+ * The file is loaded exactly as the libraries load it; if the text config file is given,
+ * every row, every group's candidate list and every cert ref lookup must match the text parse.
+ * In @param binpath; compiled config file
+ * In @param path; text config file, or NULL
+ * @return certcfgOk, certcfgFileError if invalid or different
+**/
+rdkcertcfgStatus_t rdkcertcfg_verify( const char *binpath, const char *path ) {
+  if ( binpath == NULL ) {
+    fprintf( stderr, "%s: error, null argument\n", CMD );
+    return certcfgBadPointer;
+  }
+  rdkcertcfgSnap_t *binsnap = rdkcertcfg_loadBin( binpath );
+  if ( binsnap == NULL ) {
+    fprintf( stderr, "%s: error, %s is not a valid compiled config\n", CMD, binpath );
+    return certcfgFileError;
+  }
+  if ( path == NULL ) {
+    rdkcertcfg_release( &binsnap );
+    return certcfgOk;
+  }
+
+  rdkcertcfgSnap_t *txtsnap = rdkcertcfg_parseFile( path );
+  if ( txtsnap == NULL ) {
+    fprintf( stderr, "%s: error, unable to read %s\n", CMD, path );
+    rdkcertcfg_release( &binsnap );
+    return certcfgFileNotFound;
+  }
+
+  const char *err = NULL;
+  size_t rowIndx = 0, txtCandCnt = 0, binCandCnt = 0;
+  uint16_t fld;
+  if ( txtsnap->rowCnt != binsnap->rowCnt || txtsnap->endStat != binsnap->endStat ) {
+    err = "row count";
+  }
+
+  // every group of the compiled file is found by lookup, with candidates in file order
+  // that do have the group; with the candidate counts matching, the candidate lists are the same
+  const rdkcertcfgBinHdr_t *bin = binsnap->bin;
+  const rdkcertcfgBinKey_t *keys = (const rdkcertcfgBinKey_t *)( (const char *)bin + bin->grpOff );
+  const uint32_t *cand = (const uint32_t *)( (const char *)bin + bin->candOff );
+  uint32_t slot, candIndx;
+  for ( slot = 0; err == NULL && slot < bin->grpCnt; slot++ ) {
+    if ( keys[slot].nameOff == CERTCFG_BIN_EMPTY ) {
+      continue;
+    }
+    const char *grpname = binsnap->pool + keys[slot].nameOff;
+    if ( rdkcertcfg_groupRows( binsnap, grpname, NULL, 0 ) != keys[slot].count || keys[slot].count == 0 ) {
+      err = "group lookup";
+    }
+    for ( candIndx = 0; err == NULL && candIndx < keys[slot].count; candIndx++ ) {
+      rowIndx = cand[keys[slot].first + candIndx];
+      if ( ( candIndx > 0 && rowIndx <= cand[keys[slot].first + candIndx - 1] ) ||
+           !rdkcertcfg_rowHasGroup( txtsnap, &txtsnap->rows[rowIndx], grpname ) ) {
+        err = "group candidate";
+      }
+    }
+    binCandCnt += keys[slot].count;
+  }
+  for ( rowIndx = 0; err == NULL && rowIndx < txtsnap->rowCnt; rowIndx++ ) {
+    const rdkcertcfgRow_t *txtrow = &txtsnap->rows[rowIndx];
+    const rdkcertcfgRow_t *binrow = &binsnap->rows[rowIndx];
+    if ( txtrow->fieldCnt != binrow->fieldCnt ) {
+      err = "field count";
+      break;
+    }
+    for ( fld = 0; fld < txtrow->fieldCnt; fld++ ) {
+      if ( txtrow->fieldLen[fld] != binrow->fieldLen[fld] ||
+           memcmp( rdkcertcfg_field( txtsnap, txtrow, fld, NULL ), rdkcertcfg_field( binsnap, binrow, fld, NULL ), txtrow->fieldLen[fld] ) != 0 ) {
+        err = "field";
+        break;
+      }
+    }
+
+    size_t reflen = 0;
+    const char *certRef = rdkcertcfg_field( txtsnap, txtrow, CERTCFG_FLD_LABEL, &reflen );
+    char *refstr = ( certRef != NULL ) ? strndup( certRef, reflen ) : NULL;
+    if ( err == NULL && certRef != NULL ) {
+      const rdkcertcfgRow_t *txtref = rdkcertcfg_findRef( txtsnap, refstr );
+      const rdkcertcfgRow_t *binref = rdkcertcfg_findRef( binsnap, refstr );
+      if ( refstr == NULL || binref == NULL || txtref - txtsnap->rows != binref - binsnap->rows ) {
+        err = "cert ref";
+      }
+    }
+    free( refstr );
+  }
+
+  // every group of the text parse has the same number of candidates in the compiled file
+  size_t grpIndx;
+  if ( err == NULL && rdkcertcfg_groupIndex( txtsnap ) != 0 ) {
+    err = "memory";
+  }
+  for ( grpIndx = 0; err == NULL && grpIndx < txtsnap->grpCnt; grpIndx++ ) {
+    const rdkcertcfgGroup_t *grp = &txtsnap->groups[grpIndx];
+    char *grpname = strndup( txtsnap->pool + grp->nameOff, grp->nameLen );
+    if ( grpname == NULL || rdkcertcfg_groupRows( binsnap, grpname, NULL, 0 ) != grp->count ) {
+      err = "group";
+    }
+    free( grpname );
+    txtCandCnt += grp->count;
+  }
+  if ( err == NULL && txtCandCnt != binCandCnt ) {
+    err = "group candidate count";
+  }
+  if ( err != NULL ) {
+    fprintf( stderr, "%s: error, %s does not match %s (%s, row %zu)\n", CMD, binpath, path, err, rowIndx );
+  }
+  rdkcertcfg_release( &txtsnap );
+  rdkcertcfg_release( &binsnap );
+  return ( err == NULL ) ? certcfgOk : certcfgFileError;
+} // rdkcertcfg_verify( )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int certselc_mapInit( certselc_map_t *map ) {
+  map->cap = 64;
+  map->cnt = 0;
+  map->keys = (char **)calloc( map->cap, sizeof(char *) );
+  map->vals = (uint32_t *)calloc( map->cap, sizeof(uint32_t) );
+  return ( map->keys != NULL && map->vals != NULL );
+}
+
+static void certselc_mapFree( certselc_map_t *map ) {
+  size_t slot;
+  for ( slot = 0; map->keys != NULL && slot < map->cap; slot++ ) {
+    free( map->keys[slot] );
+  }
+  free( map->keys );
+  free( map->vals );
+  map->keys = NULL;
+  map->vals = NULL;
+}
+
+// grow the map to keep it at most half full
+static int certselc_mapGrow( certselc_map_t *map ) {
+  certselc_map_t newmap;
+  newmap.cap = 2 * map->cap;
+  newmap.cnt = map->cnt;
+  newmap.keys = (char **)calloc( newmap.cap, sizeof(char *) );
+  newmap.vals = (uint32_t *)calloc( newmap.cap, sizeof(uint32_t) );
+  if ( newmap.keys == NULL || newmap.vals == NULL ) {
+    free( newmap.keys );
+    free( newmap.vals );
+    return -1;
+  }
+  size_t slot;
+  for ( slot = 0; slot < map->cap; slot++ ) {
+    if ( map->keys[slot] != NULL ) {
+      size_t newslot = rdkcertcfg_binHash( map->keys[slot], strlen( map->keys[slot] ), 0 ) & ( newmap.cap - 1 );
+      while ( newmap.keys[newslot] != NULL ) {
+        newslot = ( newslot + 1 ) & ( newmap.cap - 1 );
+      }
+      newmap.keys[newslot] = map->keys[slot];
+      newmap.vals[newslot] = map->vals[slot];
+    }
+  }
+  free( map->keys );
+  free( map->vals );
+  *map = newmap;
+  return 0;
+}
+
+// find key, adding it with newval if not there
+// returns pointer to the value, valid until the next add; NULL on memory error
+static uint32_t *certselc_mapFind( certselc_map_t *map, const char *key, size_t keylen, int *added, uint32_t newval ) {
+  *added = 0;
+  if ( map->keys == NULL ) {
+    return NULL;
+  }
+  if ( 2 * ( map->cnt + 1 ) > map->cap && certselc_mapGrow( map ) != 0 ) {
+    return NULL;
+  }
+  size_t slot = rdkcertcfg_binHash( key, keylen, 0 ) & ( map->cap - 1 );
+  while ( map->keys[slot] != NULL ) {
+    if ( strncmp( map->keys[slot], key, keylen ) == 0 && map->keys[slot][keylen] == '\0' ) {
+      return &map->vals[slot];
+    }
+    slot = ( slot + 1 ) & ( map->cap - 1 );
+  }
+  char *newkey = strndup( key, keylen );
+  if ( newkey == NULL ) {
+    return NULL;
+  }
+  map->keys[slot] = newkey;
+  map->vals[slot] = newval;
+  map->cnt++;
+  *added = 1;
+  return &map->vals[slot];
+}
+
+// key of a value returned by certselc_mapFind
+static const char *certselc_mapKey( const certselc_map_t *map, const uint32_t *val ) {
+  return ( val != NULL ) ? map->keys[val - map->vals] : NULL;
+}
+
+// next group of a group field slice, skipping empty groups, as rdkcertcfg_rowHasGroup does
+// returns the group and its length, NULL at end of field
+static const char *certselc_nextGroup( const char **grpfield, const char *fldend, size_t *grplen ) {
+  const char *grp = *grpfield;
+  while ( grp < fldend && *grp == GRPDELIM_CHAR ) {
+    grp++;
+  }
+  if ( grp >= fldend ) {
+    return NULL;
+  }
+  const char *grpend = (const char *)memchr( grp, GRPDELIM_CHAR, fldend - grp );
+  *grplen = ( grpend != NULL ) ? (size_t)(grpend - grp) : (size_t)(fldend - grp);
+  *grpfield = grp + *grplen;
+  return grp;
+}
+
+// order of buckets when placing keys, by size descending then bucket
+static int certselc_bucketCmp( const void *a, const void *b ) {
+  uint64_t abucket = *(const uint64_t *)a, bbucket = *(const uint64_t *)b;
+  return ( abucket > bbucket ) - ( abucket < bbucket );
+}
+
+// build a hash-displace perfect hash table of keys, see rdkcertcfg.h
+// returns 0 on success, -1 on error
+static int certselc_perfectHash( certselc_key_t *keys, uint32_t keyCnt, const char *pool,
+                                 rdkcertcfgBinKey_t **slots, uint32_t *slotCnt, uint32_t **disp, uint32_t *dispCnt ) {
+  *slots = NULL;
+  *disp = NULL;
+  *slotCnt = 0;
+  *dispCnt = 0;
+  if ( keyCnt == 0 ) {
+    return 0;
+  }
+
+  uint32_t m = keyCnt + keyCnt / 4 + 1;
+  uint32_t r = keyCnt / 4 + 1;
+  rdkcertcfgBinKey_t *table = (rdkcertcfgBinKey_t *)malloc( m * sizeof(rdkcertcfgBinKey_t) );
+  uint32_t *keyHash = (uint32_t *)malloc( keyCnt * sizeof(uint32_t) );
+  uint32_t *keyLen = (uint32_t *)malloc( keyCnt * sizeof(uint32_t) );
+  uint32_t *order = (uint32_t *)malloc( keyCnt * sizeof(uint32_t) );
+  uint32_t *trySlot = (uint32_t *)malloc( keyCnt * sizeof(uint32_t) );
+  uint32_t *bucketStart = NULL, *bucketDisp = NULL, *slotsUsed = NULL;
+  uint64_t *bucketOrder = NULL;
+  uint32_t keyIndx;
+  int retval = -1;
+
+  if ( table == NULL || keyHash == NULL || keyLen == NULL || order == NULL || trySlot == NULL ) {
+    goto done;
+  }
+  for ( keyIndx = 0; keyIndx < keyCnt; keyIndx++ ) {
+    keyLen[keyIndx] = (uint32_t)strlen( pool + keys[keyIndx].nameOff );
+    keyHash[keyIndx] = rdkcertcfg_binHash( pool + keys[keyIndx].nameOff, keyLen[keyIndx], 0 );
+  }
+
+  // retry with more, smaller buckets until every bucket finds a displacement
+  while ( r <= m * 4 ) {
+    free( bucketStart );
+    free( bucketDisp );
+    free( bucketOrder );
+    free( slotsUsed );
+    bucketStart = (uint32_t *)calloc( r + 1, sizeof(uint32_t) );
+    bucketDisp = (uint32_t *)calloc( r, sizeof(uint32_t) );
+    bucketOrder = (uint64_t *)malloc( r * sizeof(uint64_t) );
+    slotsUsed = (uint32_t *)calloc( m, sizeof(uint32_t) );
+    if ( bucketStart == NULL || bucketDisp == NULL || bucketOrder == NULL || slotsUsed == NULL ) {
+      goto done;
+    }
+    // keys grouped by bucket, in key order
+    uint32_t bucket;
+    for ( keyIndx = 0; keyIndx < keyCnt; keyIndx++ ) {
+      bucketStart[keyHash[keyIndx] % r + 1]++;
+    }
+    for ( bucket = 0; bucket < r; bucket++ ) {
+      uint32_t size = bucketStart[bucket+1];
+      bucketOrder[bucket] = ( (uint64_t)( UINT32_MAX - size ) << 32 ) | bucket;  // largest first
+      bucketStart[bucket+1] += bucketStart[bucket];
+    }
+    for ( keyIndx = 0; keyIndx < keyCnt; keyIndx++ ) {
+      order[bucketStart[keyHash[keyIndx] % r]++] = keyIndx;
+    }
+    for ( bucket = r; bucket > 0; bucket-- ) {
+      bucketStart[bucket] = bucketStart[bucket-1];
+    }
+    bucketStart[0] = 0;
+    qsort( bucketOrder, r, sizeof(uint64_t), certselc_bucketCmp );
+
+    int failed = 0;
+    uint32_t orderIndx;
+    for ( orderIndx = 0; orderIndx < r && !failed; orderIndx++ ) {
+      bucket = (uint32_t)bucketOrder[orderIndx];
+      uint32_t first = bucketStart[bucket], cnt = bucketStart[bucket+1] - first;
+      uint32_t d, j;
+      if ( cnt == 0 ) {
+        break;  // the rest are empty
+      }
+      for ( d = 1; d < MAX_DISP; d++ ) {
+        // all keys of the bucket must land on distinct free slots
+        for ( j = 0; j < cnt; j++ ) {
+          keyIndx = order[first+j];
+          trySlot[j] = rdkcertcfg_binHash( pool + keys[keyIndx].nameOff, keyLen[keyIndx], d ) % m;
+          if ( slotsUsed[trySlot[j]] != 0 ) {
+            break;
+          }
+          slotsUsed[trySlot[j]] = keyIndx + 1;
+        }
+        if ( j == cnt ) {
+          break;
+        }
+        // free the slots taken by this attempt
+        while ( j > 0 ) {
+          slotsUsed[trySlot[--j]] = 0;
+        }
+      }
+      if ( d == MAX_DISP ) {
+        failed = 1;
+      } else {
+        bucketDisp[bucket] = d;
+      }
+    }
+    if ( !failed ) {
+      break;
+    }
+    r *= 2;
+  }
+  if ( r > m * 4 ) {
+    goto done;
+  }
+
+  uint32_t slot;
+  for ( slot = 0; slot < m; slot++ ) {
+    if ( slotsUsed[slot] == 0 ) {
+      table[slot].nameOff = CERTCFG_BIN_EMPTY;
+      table[slot].first = 0;
+      table[slot].count = 0;
+    } else {
+      const certselc_key_t *key = &keys[slotsUsed[slot] - 1];
+      table[slot].nameOff = key->nameOff;
+      table[slot].first = key->first;
+      table[slot].count = key->count;
+    }
+  }
+  *slots = table;
+  *slotCnt = m;
+  *disp = bucketDisp;
+  *dispCnt = r;
+  table = NULL;
+  bucketDisp = NULL;
+  retval = 0;
+
+done:
+  free( table );
+  free( keyHash );
+  free( keyLen );
+  free( order );
+  free( trySlot );
+  free( bucketStart );
+  free( bucketDisp );
+  free( bucketOrder );
+  free( slotsUsed );
+  return retval;
+} // certselc_perfectHash( )
+
+// write data to a temp file next to binpath, sync, then rename over binpath
+static int certselc_writeFile( const char *binpath, const void *data, size_t len ) {
+  size_t tmplen = strlen( binpath ) + sizeof(TMP_SUFFIX);
+  char *tmppath = (char *)malloc( tmplen );
+  if ( tmppath == NULL ) {
+    fprintf( stderr, "%s: mem error\n", CMD );
+    return -1;
+  }
+  snprintf( tmppath, tmplen, "%s%s", binpath, TMP_SUFFIX );
+
+  int fd = open( tmppath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+  if ( fd < 0 ) {
+    fprintf( stderr, "%s: error, unable to create %s\n", CMD, tmppath );
+    free( tmppath );
+    return -1;
+  }
+  const char *buf = (const char *)data;
+  size_t written = 0;
+  while ( written < len ) {
+    ssize_t cnt = write( fd, buf + written, len - written );
+    if ( cnt <= 0 ) {
+      break;
+    }
+    written += (size_t)cnt;
+  }
+  int ok = ( written == len && fsync( fd ) == 0 );
+  ok = ( close( fd ) == 0 ) && ok;
+  if ( ok && rename( tmppath, binpath ) != 0 ) {
+    ok = 0;
+  }
+  if ( !ok ) {
+    fprintf( stderr, "%s: error, unable to write %s\n", CMD, binpath );
+    unlink( tmppath );
+  }
+  free( tmppath );
+  return ok ? 0 : -1;
+} // certselc_writeFile( )
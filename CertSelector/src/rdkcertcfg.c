@@ -0,0 +1,2148 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef RDKLOGGER
+    #include "rdk_debug.h"
+    #define LOG_LIB "LOG.RDK.CERTSELECTOR"
+#else
+    #define RDK_LOG(a1, a2, args...) fprintf(stderr, args)
+    #define RDK_LOG_INFO 0
+    #define RDK_LOG_ERROR 0
+    #define RDK_LOG_DEBUG 0
+    #define LOG_LIB 0
+#endif
+
+#define ERROR_LOG(...) RDK_LOG(RDK_LOG_ERROR, LOG_LIB, __VA_ARGS__)
+#define DEBUG_LOG(...) RDK_LOG(RDK_LOG_INFO, LOG_LIB, __VA_ARGS__)
+#define EXTRA_DEBUG_LOG(...) RDK_LOG(RDK_LOG_DEBUG, LOG_LIB, __VA_ARGS__)
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rdkcertcfg.h"
+
+// cache entry, one per file path
+struct rdkcertcfg_s {
+  char *path;
+  char *binPath;                // compiled config file, used instead of path if newer
+  unsigned int attachCnt;
+  rdkcertcfgSnap_t *snap;       // current config image, NULL until first used as a config file
+  int engineValid;              // engine has been read from the file identified by engineId
+  rdkcertcfgFileId_t engineId;
+  char *engine;                 // NULL if the file has no engine tag
+  int kind;                     // CERTCFG_KIND_ flags, how the entry has been used
+  int watched;                  // changes are picked up by the watcher thread, see rdkcertcfg_watch
+  int watchWd;                  // inotify watch of the directory of the file
+  const char *watchName;        // file name within the directory, in path
+  const char *watchBinName;     // compiled file name within the directory, in binPath
+  int reloadPending;            // watcher saw a change, not yet reloaded
+  struct rdkcertcfg_s *next;
+};
+
+// candidate list of one group of a text image, built on its first lookup; never changed once published
+typedef struct certcfg_grpCand_s {
+  struct certcfg_grpCand_s *next;
+  uint32_t *cand;               // NULL if the group has no rows
+  uint32_t count;
+  size_t nameLen;
+  char name[];
+} certcfg_grpCand_t;
+
+#define CERTCFG_KIND_CONFIG 1
+#define CERTCFG_KIND_HROT 2
+
+// directory watched by the watcher thread, for config files or cert files
+typedef struct certcfg_watchDir_s {
+  int wd;
+  char *dir;
+  struct certcfg_watchDir_s *next;
+} certcfg_watchDir_t;
+
+#define WATCH_MASK ( IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB )
+#define FILESCHEME "file://"
+
+#define MAX_LINE_LENGTH 1024
+#define ROW_LEN_EST 64       // for the initial row table size
+#define CFG_MAP_MIN 16384    // smaller config files are read, not mapped
+#ifdef MAP_POPULATE
+#define CFG_MAP_FLAGS MAP_POPULATE  // the whole file is read, fault it in up front
+#else
+#define CFG_MAP_FLAGS 0
+#endif
+#define CFG_SUFFIX ".cfg"
+#define BIN_SUFFIX ".bin"
+
+#define ENGINETAG "hrotengine="
+#define DELIM_CHAR ','
+#define GRPDELIM_CHAR '|'
+
+// all entries and image reference counts are protected by this lock
+static pthread_mutex_t certcfg_lock = PTHREAD_MUTEX_INITIALIZER;
+static rdkcertcfg_t *certcfg_list = NULL;
+
+// watcher thread, started by the first rdkcertcfg_watch and left running for the life of the process
+static int certcfg_inotifyFd = -1;
+static int certcfg_watchOk = 0;              // cleared if an event may have been lost for good
+static unsigned long certcfg_certSeq = 0;    // bumped for every change seen in a watched directory
+static certcfg_watchDir_t *certcfg_watchDirs = NULL;
+
+// cert file metadata cache entry, one per cert file path
+typedef struct certcfg_meta_s {
+  char *path;
+  uint32_t hash;
+  int found;
+  rdkcertcfgFileId_t id;
+  int dirWatched;               // reused while certcfg_certSeq is unchanged
+  unsigned long seq;            // certcfg_certSeq before the file was stat'ed
+  uint64_t checkNs;             // monotonic time of the stat, for the ttl
+  int hashValid;                // content hash of the file as identified by hashId, see rdkcertcfg_certHash
+  rdkcertcfgFileId_t hashId;
+  uint64_t contentHash;
+  rdkcertcfgBlob_t *blob;       // content of the file identified by blob->id, see rdkcertcfg_certBlob
+  struct certcfg_meta_s *next;
+} certcfg_meta_t;
+
+#define CERTCFG_META_MAX 1024   // cache is emptied when it grows past this many paths
+#define CERTCFG_META_BUCKETS 256
+
+// cert metadata cache, separate from the entries so lookups don't wait on config reloads
+static pthread_mutex_t certcfg_metaLock = PTHREAD_MUTEX_INITIALIZER;
+static certcfg_meta_t *certcfg_metaTab[CERTCFG_META_BUCKETS];
+static size_t certcfg_metaCnt = 0;
+static uint64_t certcfg_metaTtlNs = 0;
+
+static rdkcertcfgCounters_t certcfg_counters;
+
+// passcode cache entry; all entries are in one locked mapping
+typedef struct certcfg_pass_s {
+  char credRef[CERTCFG_PASS_LEN];    // empty if the entry is free
+  char pass[CERTCFG_PASS_LEN];
+  uint64_t expiresNs;
+} certcfg_pass_t;
+
+static pthread_mutex_t certcfg_passLock = PTHREAD_MUTEX_INITIALIZER;
+static certcfg_pass_t *certcfg_passTab = NULL;         // CERTCFG_PASS_MAX entries, NULL while disabled
+static size_t certcfg_passMapsz = 0;
+static uint64_t certcfg_passTtlNs = 0;
+
+// handles holding a credential reference, see rdkcertcfg_passHold; under certcfg_passLock
+typedef struct certcfg_hold_s {
+  struct certcfg_hold_s *next;
+  uint32_t hash;               // rdkcertcfg_binHash of credRef
+  unsigned int cnt;
+  char credRef[];
+} certcfg_hold_t;
+#define CERTCFG_HOLD_BUCKETS 256
+static certcfg_hold_t *certcfg_holdTab[CERTCFG_HOLD_BUCKETS];
+#define CERTCFG_COUNT( ctr ) __atomic_add_fetch( &certcfg_counters.ctr, 1, __ATOMIC_RELAXED )
+
+static int certcfg_sameFile( const rdkcertcfgFileId_t *fileId, const struct stat *fileStat );
+static void certcfg_setFileId( rdkcertcfgFileId_t *fileId, const struct stat *fileStat );
+static int certcfg_newer( const struct stat *binStat, const struct stat *cfgStat );
+static int certcfg_binRange( size_t fileLen, uint32_t off, uint32_t cnt, size_t elsz );
+static const rdkcertcfgBinKey_t *certcfg_binLookup( const rdkcertcfgSnap_t *snap, uint32_t keyOff, uint32_t keyCnt,
+                                                    uint32_t dispOff, uint32_t dispCnt, const char *key );
+static void certcfg_freeSnap( rdkcertcfgSnap_t *snap );
+static void certcfg_readEngine( rdkcertcfg_t *cfg, FILE *hrotfp );
+static uint32_t *certcfg_buildRefIndex( const rdkcertcfgSnap_t *snap, size_t *indexsz );
+static int certcfg_buildGroups( rdkcertcfgSnap_t *snap );
+static certcfg_grpCand_t *certcfg_findGrpCand( certcfg_grpCand_t *grpCand, const char *group, size_t grplen );
+static certcfg_grpCand_t *certcfg_buildGrpCand( const rdkcertcfgSnap_t *snap, const char *group, size_t grplen );
+static uint32_t *certcfg_groupSlot( const rdkcertcfgSnap_t *snap, const uint32_t *grpIndex, size_t indexsz,
+                                    const char *group, size_t grplen );
+static const char *certcfg_nextGroup( const char **grpfield, const char *fldend, size_t *grplen );
+static int certcfg_snapCurrent( const rdkcertcfgSnap_t *snap, const struct stat *cfgStat, int useBin, const struct stat *binStat );
+static rdkcertcfgSnap_t *certcfg_loadSnap( const rdkcertcfg_t *cfg, const struct stat *cfgStat, int useBin, const struct stat *binStat );
+static int certcfg_watchDir( const char *dir, size_t dirlen );
+static void certcfg_watchCertDirs( const rdkcertcfgSnap_t *snap );
+static void *certcfg_watcher( void *arg );
+static void certcfg_reload( rdkcertcfg_t *cfg );
+static void certcfg_reloadEngine( rdkcertcfg_t *cfg );
+static int certcfg_stat( const char *path, struct stat *fileStat );
+static int certcfg_fstat( int fd, struct stat *fileStat );
+static int certcfg_open( const char *path, int flags );
+static FILE *certcfg_fopen( const char *path, const char *mode );
+static int certcfg_dirWatched( const char *path );
+static certcfg_meta_t *certcfg_metaFind( const char *file, uint32_t hash );
+static void certcfg_blobUnref( rdkcertcfgBlob_t *blob );
+static uint64_t certcfg_nowNs( void );
+static void certcfg_passWipe( void *pass, size_t sz );
+static void certcfg_passWipeRef( const char *credRef );
+
+/**
+ * Attach to the shared cache entry for a file.
+ * In @param path; config or hrot properties file path
+ * @return the entry, NULL on memory error
+**/
+rdkcertcfg_t *rdkcertcfg_attach( const char *path ) {
+  if ( path == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return NULL;
+  }
+
+  pthread_mutex_lock( &certcfg_lock );
+  rdkcertcfg_t *cfg = certcfg_list;
+  while ( cfg != NULL && strcmp( cfg->path, path ) != 0 ) {
+    cfg = cfg->next;
+  }
+
+  if ( cfg == NULL ) {
+    cfg = (rdkcertcfg_t *)calloc( 1, sizeof(rdkcertcfg_t) );
+    if ( cfg != NULL ) {
+      cfg->path = strdup( path );
+      cfg->binPath = rdkcertcfg_binPath( path );
+      if ( cfg->path == NULL || cfg->binPath == NULL ) {
+        free( cfg->path );
+        free( cfg->binPath );
+        free( cfg );
+        cfg = NULL;
+      }
+    }
+    if ( cfg == NULL ) {
+      pthread_mutex_unlock( &certcfg_lock );
+      ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+      return NULL;
+    }
+    cfg->next = certcfg_list;
+    certcfg_list = cfg;
+    EXTRA_DEBUG_LOG( " %s:new entry [%s]\n", __FUNCTION__, path );
+  }
+  cfg->attachCnt++;
+  pthread_mutex_unlock( &certcfg_lock );
+
+  return cfg;
+} // rdkcertcfg_attach( )
+
+/**
+ * Detach from a shared cache entry; the entry and its image are freed with the last detach.
+ * In/Out @param cfg; pointer to entry, NULLed
+**/
+void rdkcertcfg_detach( rdkcertcfg_t **cfg ) {
+  if ( cfg == NULL || *cfg == NULL ) {
+    return;
+  }
+  rdkcertcfg_t *thiscfg = *cfg;
+  rdkcertcfgSnap_t *freesnap = NULL;
+  *cfg = NULL;
+
+  pthread_mutex_lock( &certcfg_lock );
+  if ( --thiscfg->attachCnt == 0 ) {
+    rdkcertcfg_t **link = &certcfg_list;
+    while ( *link != NULL && *link != thiscfg ) {
+      link = &(*link)->next;
+    }
+    if ( *link != NULL ) {
+      *link = thiscfg->next;
+    }
+    if ( thiscfg->snap != NULL && --thiscfg->snap->refCnt == 0 ) {
+      freesnap = thiscfg->snap;
+    }
+  } else {
+    thiscfg = NULL; // still in use
+  }
+  int lastEntry = ( certcfg_list == NULL );
+  pthread_mutex_unlock( &certcfg_lock );
+
+  if ( lastEntry ) {
+    rdkcertcfg_passPurge( NULL );  // no handle left to use the passcodes
+  }
+  if ( thiscfg != NULL ) {
+    EXTRA_DEBUG_LOG( " %s:free entry [%s]\n", __FUNCTION__, thiscfg->path );
+    certcfg_freeSnap( freesnap );
+    free( thiscfg->engine );
+    free( thiscfg->binPath );
+    free( thiscfg->path );
+    free( thiscfg );
+  }
+} // rdkcertcfg_detach( )
+
+const char *rdkcertcfg_getPath( const rdkcertcfg_t *cfg ) {
+  return ( cfg != NULL ) ? cfg->path : NULL;
+}
+
+/**
+ * Get the current image of a config file, attaching to its entry if needed.
+ * The file is stat'ed on each call, and only parsed if it changed since the current image was built.
+ * If a compiled config file newer than the config file exists, it is loaded instead of parsing the text.
+ * In/Out @param cfg; entry, (re)attached if NULL or attached to a different path
+ * In @param path; config file path
+ * In/Out @param snap; image reference held by the caller, replaced by the current image
+ * @return certcfgOk, certcfgFileNotFound if the config file is missing, certcfgGeneralFailure on memory error
+**/
+rdkcertcfgStatus_t rdkcertcfg_refresh( rdkcertcfg_t **cfg, const char *path, rdkcertcfgSnap_t **snap ) {
+  if ( cfg == NULL || path == NULL || snap == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+
+  if ( *cfg != NULL && strcmp( (*cfg)->path, path ) != 0 ) {
+    rdkcertcfg_release( snap );
+    rdkcertcfg_detach( cfg );
+  }
+  if ( *cfg == NULL ) {
+    rdkcertcfg_release( snap );
+    *cfg = rdkcertcfg_attach( path );
+    if ( *cfg == NULL ) {
+      return certcfgGeneralFailure;
+    }
+  }
+  rdkcertcfg_t *thiscfg = *cfg;
+  rdkcertcfgSnap_t *freesnap = NULL, *freeold = NULL;
+
+  // a watched file is reloaded by the watcher thread; if the caller already has the current image
+  // there is nothing to do, without a syscall or the lock
+  if ( rdkcertcfg_watching( thiscfg ) ) {
+    rdkcertcfgSnap_t *cursnap = __atomic_load_n( &thiscfg->snap, __ATOMIC_ACQUIRE );
+    if ( cursnap != NULL && cursnap == *snap ) {
+      return certcfgOk;
+    }
+    if ( cursnap != NULL ) {
+      pthread_mutex_lock( &certcfg_lock );
+      cursnap = thiscfg->snap;
+      if ( cursnap != NULL ) {
+        if ( *snap != NULL && --(*snap)->refCnt == 0 ) {
+          freeold = *snap;
+        }
+        *snap = cursnap;
+        cursnap->refCnt++;
+      }
+      pthread_mutex_unlock( &certcfg_lock );
+      certcfg_freeSnap( freeold );
+      if ( cursnap != NULL ) {
+        return certcfgOk;
+      }
+      freeold = NULL;
+    }
+    // no image yet, or the file was removed; check the file as if not watched
+  }
+
+  struct stat cfgStat;
+  if ( certcfg_stat( path, &cfgStat ) != 0 ) {
+    ERROR_LOG( " %s:config file, %s, not found\n", __FUNCTION__, path );
+    rdkcertcfg_release( snap );
+    return certcfgFileNotFound;
+  }
+
+  // prefer compiled config if it is newer
+  struct stat binStat;
+  int useBin = ( certcfg_stat( thiscfg->binPath, &binStat ) == 0 && certcfg_newer( &binStat, &cfgStat ) );
+
+  rdkcertcfgStatus_t retval = certcfgOk;
+
+  pthread_mutex_lock( &certcfg_lock );
+  thiscfg->kind |= CERTCFG_KIND_CONFIG;
+  if ( !certcfg_snapCurrent( thiscfg->snap, &cfgStat, useBin, &binStat ) ) {
+    // file changed, or not parsed yet
+    rdkcertcfgSnap_t *newsnap = certcfg_loadSnap( thiscfg, &cfgStat, useBin, &binStat );
+    if ( newsnap == NULL ) {
+      retval = certcfgFileNotFound;
+    } else {
+      if ( thiscfg->snap != NULL && --thiscfg->snap->refCnt == 0 ) {
+        freesnap = thiscfg->snap;
+      }
+      __atomic_store_n( &thiscfg->snap, newsnap, __ATOMIC_RELEASE );
+    }
+  }
+  if ( retval == certcfgOk && *snap != thiscfg->snap ) {
+    // release caller's old image and give it the current one
+    if ( *snap != NULL && --(*snap)->refCnt == 0 ) {
+      freeold = *snap;
+    }
+    *snap = thiscfg->snap;
+    (*snap)->refCnt++;
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+
+  certcfg_freeSnap( freesnap );
+  certcfg_freeSnap( freeold );
+  if ( retval != certcfgOk ) {
+    rdkcertcfg_release( snap );
+  }
+  return retval;
+} // rdkcertcfg_refresh( )
+
+/**
+ * Release a reference to a config image.
+ * In/Out @param snap; pointer to image, NULLed
+**/
+void rdkcertcfg_release( rdkcertcfgSnap_t **snap ) {
+  if ( snap == NULL || *snap == NULL ) {
+    return;
+  }
+  rdkcertcfgSnap_t *freesnap = NULL;
+  pthread_mutex_lock( &certcfg_lock );
+  if ( --(*snap)->refCnt == 0 ) {
+    freesnap = *snap;
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+  certcfg_freeSnap( freesnap );
+  *snap = NULL;
+} // rdkcertcfg_release( )
+
+const char *rdkcertcfg_field( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, int fld, size_t *fldlen ) {
+  if ( snap == NULL || row == NULL || fld < 0 || fld >= row->fieldCnt ) {
+    return NULL;
+  }
+  if ( fldlen != NULL ) {
+    *fldlen = row->fieldLen[fld];
+  }
+  return snap->pool + row->fieldOff[fld];
+}
+
+int rdkcertcfg_fieldIs( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, int fld, const char *str ) {
+  size_t fldlen = 0;
+  const char *field = rdkcertcfg_field( snap, row, fld, &fldlen );
+  return ( field != NULL && str != NULL && strncmp( str, field, fldlen ) == 0 && str[fldlen] == '\0' );
+}
+
+/**
+ * Find the first row of the image with the given cert ref.
+ * The hash index is built once per image, under the lock, and published for lock free lookups.
+ * In @param snap; config image
+ * In @param certRef; cert reference, field 2 of the config file
+ * @return the row, NULL if not found
+**/
+const rdkcertcfgRow_t *rdkcertcfg_findRef( rdkcertcfgSnap_t *snap, const char *certRef ) {
+  if ( snap == NULL || certRef == NULL ) {
+    return NULL;
+  }
+
+  if ( snap->bin != NULL ) {
+    const rdkcertcfgBinHdr_t *bin = snap->bin;
+    const rdkcertcfgBinKey_t *key = certcfg_binLookup( snap, bin->refOff, bin->refCnt, bin->refDispOff, bin->refDispCnt, certRef );
+    return ( key != NULL ) ? &snap->rows[key->first] : NULL;
+  }
+
+  uint32_t *refIndex = __atomic_load_n( &snap->refIndex, __ATOMIC_ACQUIRE );
+  if ( refIndex == NULL ) {
+    pthread_mutex_lock( &certcfg_lock );
+    refIndex = snap->refIndex;
+    if ( refIndex == NULL ) {
+      size_t indexsz = 0;
+      refIndex = certcfg_buildRefIndex( snap, &indexsz );
+      if ( refIndex != NULL ) {
+        snap->refIndexSz = indexsz;
+        __atomic_store_n( &snap->refIndex, refIndex, __ATOMIC_RELEASE );
+      }
+    }
+    pthread_mutex_unlock( &certcfg_lock );
+  }
+
+  if ( refIndex == NULL ) {
+    // no memory for the index, search the rows
+    size_t rowIndx;
+    for ( rowIndx = 0; rowIndx < snap->rowCnt; rowIndx++ ) {
+      if ( rdkcertcfg_fieldIs( snap, &snap->rows[rowIndx], CERTCFG_FLD_LABEL, certRef ) ) {
+        return &snap->rows[rowIndx];
+      }
+    }
+    return NULL;
+  }
+
+  size_t mask = snap->refIndexSz - 1;
+  size_t slot = rdkcertcfg_binHash( certRef, strlen( certRef ), 0 ) & mask;
+  while ( refIndex[slot] != 0 ) {
+    const rdkcertcfgRow_t *row = &snap->rows[refIndex[slot]-1];
+    if ( rdkcertcfg_fieldIs( snap, row, CERTCFG_FLD_LABEL, certRef ) ) {
+      return row;
+    }
+    slot = ( slot + 1 ) & mask;
+  }
+  return NULL;
+} // rdkcertcfg_findRef( )
+
+/**
+ * Get the candidate list of a group, indices of the rows that include the group in their group field.
+ * The list is part of the image, so it is valid as long as the image is referenced.
+ * In @param snap; config image
+ * In @param group; cert group
+ * Out @param cand; row indices in file order, NULL if the group has no rows
+ * @return the number of candidate rows
+**/
+size_t rdkcertcfg_groupCand( rdkcertcfgSnap_t *snap, const char *group, const uint32_t **cand ) {
+  if ( cand != NULL ) {
+    *cand = NULL;
+  }
+  if ( snap == NULL || group == NULL ) {
+    return 0;
+  }
+
+  if ( snap->bin != NULL ) {
+    const rdkcertcfgBinHdr_t *bin = snap->bin;
+    const rdkcertcfgBinKey_t *key = certcfg_binLookup( snap, bin->grpOff, bin->grpCnt, bin->grpDispOff, bin->grpDispCnt, group );
+    if ( key == NULL ) {
+      return 0;
+    }
+    if ( cand != NULL ) {
+      *cand = (const uint32_t *)( (const char *)bin + bin->candOff ) + key->first;
+    }
+    return key->count;
+  }
+
+  size_t grplen = strlen( group );
+  if ( __atomic_load_n( &snap->grpBuilt, __ATOMIC_ACQUIRE ) ) {
+    // all groups are interned, see rdkcertcfg_groupIndex
+    const uint32_t *slot = certcfg_groupSlot( snap, snap->grpIndex, snap->grpIndexSz, group, grplen );
+    if ( slot == NULL || *slot == 0 ) {
+      return 0;
+    }
+    const rdkcertcfgGroup_t *grp = &snap->groups[*slot-1];
+    if ( cand != NULL ) {
+      *cand = snap->cand + grp->first;
+    }
+    return grp->count;
+  }
+
+  // the list of a group is built on its first lookup, under the lock, and published for lock free lookups;
+  // a handle uses one group, so the parse does not pay for interning every group of every row
+  certcfg_grpCand_t *grpCand = certcfg_findGrpCand( __atomic_load_n( &snap->grpCands, __ATOMIC_ACQUIRE ), group, grplen );
+  if ( grpCand == NULL ) {
+    pthread_mutex_lock( &certcfg_lock );
+    grpCand = certcfg_findGrpCand( snap->grpCands, group, grplen );
+    if ( grpCand == NULL ) {
+      grpCand = certcfg_buildGrpCand( snap, group, grplen );
+      if ( grpCand != NULL ) {
+        grpCand->next = snap->grpCands;
+        __atomic_store_n( &snap->grpCands, grpCand, __ATOMIC_RELEASE );
+      }
+    }
+    pthread_mutex_unlock( &certcfg_lock );
+  }
+  if ( grpCand == NULL ) {
+    ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+    return 0;
+  }
+  if ( cand != NULL ) {
+    *cand = grpCand->cand;
+  }
+  return grpCand->count;
+} // rdkcertcfg_groupCand( )
+
+/**
+ * Intern all groups of a text image, to list them; lookups build only the groups they use, see rdkcertcfg_groupCand.
+ * In @param snap; config image
+ * @return 0, -1 on memory error
+**/
+int rdkcertcfg_groupIndex( rdkcertcfgSnap_t *snap ) {
+  if ( snap == NULL || snap->bin != NULL || __atomic_load_n( &snap->grpBuilt, __ATOMIC_ACQUIRE ) ) {
+    return 0;
+  }
+  int retval = 0;
+  pthread_mutex_lock( &certcfg_lock );
+  if ( !snap->grpBuilt ) {
+    retval = certcfg_buildGroups( snap );
+    if ( retval == 0 ) {
+      __atomic_store_n( &snap->grpBuilt, 1, __ATOMIC_RELEASE );
+    } else {
+      free( snap->groups );
+      free( snap->grpIndex );
+      free( snap->cand );
+      snap->groups = NULL;
+      snap->grpIndex = NULL;
+      snap->cand = NULL;
+      snap->grpCnt = snap->grpIndexSz = 0;
+    }
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+  return retval;
+} // rdkcertcfg_groupIndex( )
+
+/**
+ * Get the candidate rows of a group, rows that include the group in their group field.
+ * In @param snap; config image
+ * In @param group; cert group
+ * Out @param rows; up to maxrows candidate rows, in file order
+ * @return the number of candidate rows, may be more than maxrows
+**/
+size_t rdkcertcfg_groupRows( rdkcertcfgSnap_t *snap, const char *group, const rdkcertcfgRow_t **rows, size_t maxrows ) {
+  const uint32_t *cand = NULL;
+  size_t candCnt = rdkcertcfg_groupCand( snap, group, &cand );
+  size_t rowIndx;
+  for ( rowIndx = 0; rowIndx < candCnt && rowIndx < maxrows; rowIndx++ ) {
+    rows[rowIndx] = &snap->rows[cand[rowIndx]];
+  }
+  return candCnt;
+} // rdkcertcfg_groupRows( )
+
+// look for group in the '|' separated group field
+// same rules as tokenizing the field: empty groups are skipped
+int rdkcertcfg_rowHasGroup( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, const char *group ) {
+  size_t fldlen = 0;
+  const char *grpfield = rdkcertcfg_field( snap, row, CERTCFG_FLD_GROUP, &fldlen );
+  if ( grpfield == NULL || group == NULL ) {
+    return 0;
+  }
+  const char *fldend = grpfield + fldlen;
+  size_t grplen = strlen( group ), toklen = 0;
+  const char *cfggrp;
+  while ( ( cfggrp = certcfg_nextGroup( &grpfield, fldend, &toklen ) ) != NULL ) {
+    if ( toklen == grplen && memcmp( cfggrp, group, grplen ) == 0 ) {
+      return 1;
+    }
+  }
+  return 0;
+} // rdkcertcfg_rowHasGroup( )
+
+// check format of the cert info in a row
+rdkcertcfgStatus_t rdkcertcfg_rowCert( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row,
+                                       char *uri, size_t urimax, char *credref, size_t credmax ) {
+  if ( snap == NULL || row == NULL ) {
+    return certcfgBadPointer;
+  }
+  if ( row->fieldCnt <= CERTCFG_FLD_TYPE ) {
+    ERROR_LOG( " %s:missing fields (2/3)\n", __FUNCTION__ );
+    return certcfgFileError;
+  }
+  // an error here is probably a corruption of the config file
+  if ( row->fieldCnt <= CERTCFG_FLD_CREDREF ||
+       row->fieldLen[CERTCFG_FLD_URI] >= urimax || row->fieldLen[CERTCFG_FLD_CREDREF] >= credmax ) {
+    ERROR_LOG( " %s:missing fields (4/5)\n", __FUNCTION__ );
+    return certcfgFileError;
+  }
+  // only the selected row is copied out of the image
+  if ( uri != NULL ) {
+    memcpy( uri, snap->pool + row->fieldOff[CERTCFG_FLD_URI], row->fieldLen[CERTCFG_FLD_URI] );
+    uri[row->fieldLen[CERTCFG_FLD_URI]] = '\0';
+  }
+  if ( credref != NULL ) {
+    memcpy( credref, snap->pool + row->fieldOff[CERTCFG_FLD_CREDREF], row->fieldLen[CERTCFG_FLD_CREDREF] );
+    credref[row->fieldLen[CERTCFG_FLD_CREDREF]] = '\0';
+  }
+  return certcfgOk;
+} // rdkcertcfg_rowCert( )
+
+/**
+ * Get the hrot engine from a hrot properties file.
+ * The engine is read once and cached in the entry until the file changes.
+ * In @param cfg; entry for the hrot properties file
+ * Out @param engine; engine, empty string if none
+ * In @param enginesz; size of engine buffer
+ * @return certcfgOk, certcfgFileNotFound if the file is missing
+**/
+rdkcertcfgStatus_t rdkcertcfg_getEngine( rdkcertcfg_t *cfg, char *engine, size_t enginesz ) {
+  if ( cfg == NULL || engine == NULL || enginesz == 0 ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+  engine[0] = '\0';
+
+  // a watched file is re-read by the watcher thread
+  if ( rdkcertcfg_watching( cfg ) ) {
+    int found = 0;
+    pthread_mutex_lock( &certcfg_lock );
+    if ( cfg->engineValid ) {
+      found = 1;
+      if ( cfg->engine != NULL ) {
+        strncpy( engine, cfg->engine, enginesz-1 );
+        engine[enginesz-1] = '\0'; // terminate if necessary to truncate
+      }
+    }
+    pthread_mutex_unlock( &certcfg_lock );
+    if ( found ) {
+      return certcfgOk;
+    }
+  }
+
+  FILE *hrotfp = certcfg_fopen( cfg->path, "r" );
+  if ( hrotfp == NULL ) {
+    return certcfgFileNotFound;
+  }
+  struct stat hrotStat;
+  if ( certcfg_fstat( fileno( hrotfp ), &hrotStat ) != 0 ) {
+    fclose( hrotfp );
+    return certcfgFileNotFound;
+  }
+
+  pthread_mutex_lock( &certcfg_lock );
+  cfg->kind |= CERTCFG_KIND_HROT;
+  if ( !cfg->engineValid || !certcfg_sameFile( &cfg->engineId, &hrotStat ) ) {
+    certcfg_readEngine( cfg, hrotfp );
+    certcfg_setFileId( &cfg->engineId, &hrotStat );
+    cfg->engineValid = 1;
+  }
+  if ( cfg->engine != NULL ) {
+    strncpy( engine, cfg->engine, enginesz-1 );
+    engine[enginesz-1] = '\0'; // terminate if necessary to truncate
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+
+  fclose( hrotfp );
+  return certcfgOk;
+} // rdkcertcfg_getEngine( )
+
+/**
+ * Watch a file for changes with inotify, from a watcher thread shared by all entries.
+ * Config files are re-parsed and the new image published by the watcher, so rdkcertcfg_refresh
+ * no longer checks the file; hrot properties files have the engine re-read.
+ * The directories of cert files named in a config image are watched as well, see rdkcertcfg_certSeq.
+ * The entry stays watched until it is freed.
+ * In @param cfg; entry
+ * @return certcfgOk, certcfgGeneralFailure if the file can't be watched
+**/
+rdkcertcfgStatus_t rdkcertcfg_watch( rdkcertcfg_t *cfg ) {
+  if ( cfg == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+
+  // directory and name, name is the whole path if there is no directory
+  const char *slash = strrchr( cfg->path, '/' );
+  const char *binslash = strrchr( cfg->binPath, '/' );
+  const char *dir = ( slash != NULL ) ? cfg->path : ".";
+  size_t dirlen = ( slash != NULL ) ? (size_t)( slash - cfg->path ) : 1;
+  if ( dirlen == 0 ) {
+    dirlen = 1; // root directory
+  }
+
+  pthread_mutex_lock( &certcfg_lock );
+  if ( cfg->watched ) {
+    pthread_mutex_unlock( &certcfg_lock );
+    return certcfgOk;
+  }
+  if ( certcfg_inotifyFd < 0 ) {
+    certcfg_inotifyFd = inotify_init1( IN_CLOEXEC );
+    pthread_t watcher;
+    if ( certcfg_inotifyFd < 0 || pthread_create( &watcher, NULL, certcfg_watcher, NULL ) != 0 ) {
+      ERROR_LOG( " %s:unable to start watcher (%d)\n", __FUNCTION__, errno );
+      if ( certcfg_inotifyFd >= 0 ) {
+        close( certcfg_inotifyFd );
+        certcfg_inotifyFd = -1;
+      }
+      pthread_mutex_unlock( &certcfg_lock );
+      return certcfgGeneralFailure;
+    }
+    pthread_detach( watcher );
+    certcfg_watchOk = 1;
+  }
+  int wd = certcfg_watchDir( dir, dirlen );
+  if ( wd >= 0 ) {
+    cfg->watchWd = wd;
+    cfg->watchName = ( slash != NULL ) ? slash + 1 : cfg->path;
+    cfg->watchBinName = ( binslash != NULL ) ? binslash + 1 : cfg->binPath;
+    __atomic_store_n( &cfg->watched, 1, __ATOMIC_RELEASE );
+  }
+  const rdkcertcfgSnap_t *snap = cfg->snap;
+  if ( wd >= 0 && snap != NULL ) {
+    certcfg_watchCertDirs( snap );
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+
+  if ( wd < 0 ) {
+    ERROR_LOG( " %s:unable to watch %s (%d)\n", __FUNCTION__, cfg->path, errno );
+    return certcfgGeneralFailure;
+  }
+  EXTRA_DEBUG_LOG( " %s:watching [%s]\n", __FUNCTION__, cfg->path );
+  return certcfgOk;
+} // rdkcertcfg_watch( )
+
+int rdkcertcfg_watching( const rdkcertcfg_t *cfg ) {
+  return ( cfg != NULL && __atomic_load_n( &cfg->watched, __ATOMIC_ACQUIRE ) &&
+           __atomic_load_n( &certcfg_watchOk, __ATOMIC_ACQUIRE ) );
+}
+
+unsigned long rdkcertcfg_certSeq( void ) {
+  return __atomic_load_n( &certcfg_certSeq, __ATOMIC_ACQUIRE );
+}
+
+/**
+ * Get the metadata of a cert file from the cert metadata cache.
+ * A cached entry is used without a syscall if the config file is watched, the cert's directory is watched and
+ * the watcher has seen no change since the file was stat'ed, or if it was stat'ed less than the ttl ago;
+ * otherwise the file is stat'ed again.
+ * Missing files are cached too, so a missing candidate does not cost a syscall on every selection.
+ * In @param cfg; entry of the config file naming the cert, NULL if none
+ * In @param file; cert file path, without the uri scheme
+ * Out @param meta; metadata, found is 0 if the file is missing
+ * @return certcfgOk, certcfgFileNotFound if the file is missing
+**/
+rdkcertcfgStatus_t rdkcertcfg_certMeta( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgCertMeta_t *meta ) {
+  if ( file == NULL || meta == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+  size_t filelen = strlen( file );
+  uint32_t hash = rdkcertcfg_binHash( file, filelen, 0 );
+  unsigned long seq = rdkcertcfg_certSeq();
+  uint64_t ttlNs = __atomic_load_n( &certcfg_metaTtlNs, __ATOMIC_RELAXED );
+  int watchOk = rdkcertcfg_watching( cfg );
+
+  pthread_mutex_lock( &certcfg_metaLock );
+  certcfg_meta_t *ent = certcfg_metaFind( file, hash );
+  if ( ent != NULL && ( ( watchOk && ent->dirWatched && ent->seq == seq ) ||
+                        ( ttlNs != 0 && certcfg_nowNs() - ent->checkNs < ttlNs ) ) ) {
+    meta->found = ent->found;
+    meta->id = ent->id;
+    pthread_mutex_unlock( &certcfg_metaLock );
+    CERTCFG_COUNT( metaHits );
+    return meta->found ? certcfgOk : certcfgFileNotFound;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  CERTCFG_COUNT( metaMisses );
+
+  // stat outside the lock; seq was read first, so a change during the stat is seen on the next lookup
+  int dirWatched = ( watchOk && certcfg_dirWatched( file ) );
+  uint64_t checkNs = ( ttlNs != 0 ) ? certcfg_nowNs() : 0;
+  struct stat fileStat;
+  memset( meta, 0, sizeof(*meta) );
+  if ( certcfg_stat( file, &fileStat ) == 0 ) {
+    meta->found = 1;
+    certcfg_setFileId( &meta->id, &fileStat );
+  }
+
+  pthread_mutex_lock( &certcfg_metaLock );
+  ent = certcfg_metaFind( file, hash );
+  if ( ent == NULL ) {
+    if ( certcfg_metaCnt >= CERTCFG_META_MAX ) {
+      size_t bucket;
+      for ( bucket = 0; bucket < CERTCFG_META_BUCKETS; bucket++ ) {
+        while ( certcfg_metaTab[bucket] != NULL ) {
+          certcfg_meta_t *freeent = certcfg_metaTab[bucket];
+          certcfg_metaTab[bucket] = freeent->next;
+          certcfg_blobUnref( freeent->blob );
+          free( freeent->path );
+          free( freeent );
+        }
+      }
+      certcfg_metaCnt = 0;
+    }
+    ent = (certcfg_meta_t *)calloc( 1, sizeof(certcfg_meta_t) );
+    if ( ent != NULL && ( ent->path = strdup( file ) ) == NULL ) {
+      free( ent );
+      ent = NULL;
+    }
+    if ( ent != NULL ) {
+      ent->hash = hash;
+      ent->next = certcfg_metaTab[hash % CERTCFG_META_BUCKETS];
+      certcfg_metaTab[hash % CERTCFG_META_BUCKETS] = ent;
+      certcfg_metaCnt++;
+    }
+  }
+  if ( ent != NULL ) {  // not cached on memory error, checked again next time
+    ent->found = meta->found;
+    ent->id = meta->id;
+    ent->dirWatched = dirWatched;
+    ent->seq = seq;
+    ent->checkNs = checkNs;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  return meta->found ? certcfgOk : certcfgFileNotFound;
+} // rdkcertcfg_certMeta( )
+
+/**
+ * Get a hash of the content of a cert file, with its metadata.
+ * The hash is kept with the cert's metadata cache entry, so the file is only read again once its metadata changes.
+ * In @param cfg; entry of the config file naming the cert, NULL if none
+ * In @param file; cert file path, without the uri scheme
+ * Out @param meta; metadata of the file that was hashed
+ * Out @param hash; 64 bit FNV-1a hash of the content
+ * @return certcfgOk, certcfgFileNotFound if the file is missing or can't be read
+**/
+rdkcertcfgStatus_t rdkcertcfg_certHash( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgCertMeta_t *meta, uint64_t *hash ) {
+  if ( hash == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+  rdkcertcfgStatus_t retval = rdkcertcfg_certMeta( cfg, file, meta );
+  if ( retval != certcfgOk ) {
+    return retval;
+  }
+  uint32_t pathHash = rdkcertcfg_binHash( file, strlen( file ), 0 );
+  pthread_mutex_lock( &certcfg_metaLock );
+  certcfg_meta_t *ent = certcfg_metaFind( file, pathHash );
+  int hashValid = ( ent != NULL && ent->hashValid && rdkcertcfg_sameId( &ent->hashId, &meta->id ) );
+  if ( hashValid ) {
+    *hash = ent->contentHash;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  if ( hashValid ) {
+    return certcfgOk;
+  }
+
+  // the metadata is taken from the open file, so it describes the content that was hashed
+  int fd = certcfg_open( file, O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) {
+    return certcfgFileNotFound;
+  }
+  CERTCFG_COUNT( hashReads );
+  struct stat fileStat;
+  uint64_t contentHash = 14695981039346656037ull;
+  unsigned char buf[4096];
+  ssize_t readLen = 0;
+  retval = ( certcfg_fstat( fd, &fileStat ) == 0 ) ? certcfgOk : certcfgFileNotFound;
+  while ( retval == certcfgOk && ( readLen = read( fd, buf, sizeof(buf) ) ) != 0 ) {
+    if ( readLen < 0 ) {
+      if ( errno != EINTR ) {
+        retval = certcfgFileError;
+      }
+      continue;
+    }
+    ssize_t pos;
+    for ( pos = 0; pos < readLen; pos++ ) {
+      contentHash ^= buf[pos];
+      contentHash *= 1099511628211ull;
+    }
+  }
+  close( fd );
+  if ( retval != certcfgOk ) {
+    return retval;
+  }
+  meta->found = 1;
+  certcfg_setFileId( &meta->id, &fileStat );
+  *hash = contentHash;
+
+  pthread_mutex_lock( &certcfg_metaLock );
+  ent = certcfg_metaFind( file, pathHash );
+  if ( ent != NULL ) {  // removed if the cache was emptied meanwhile
+    ent->hashValid = 1;
+    ent->hashId = meta->id;
+    ent->contentHash = contentHash;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  return certcfgOk;
+} // rdkcertcfg_certHash( )
+
+void rdkcertcfg_setMetaTtl( unsigned int ttlMs ) {
+  __atomic_store_n( &certcfg_metaTtlNs, (uint64_t)ttlMs * 1000000, __ATOMIC_RELAXED );
+}
+
+/**
+ * Get the content of a cert file, from the copy cached with its metadata.
+ * In @param cfg; config entry naming the cert, may be NULL
+ * In @param file; cert file path
+ * Out @param blob; content, with a reference for the caller
+ * @return certcfgOk, certcfgFileNotFound or certcfgFileError
+**/
+rdkcertcfgStatus_t rdkcertcfg_certBlob( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgBlob_t **blob ) {
+  if ( file == NULL || blob == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certcfgBadPointer;
+  }
+  *blob = NULL;
+  rdkcertcfgCertMeta_t meta;
+  rdkcertcfgStatus_t retval = rdkcertcfg_certMeta( cfg, file, &meta );
+  if ( retval != certcfgOk ) {
+    return retval;
+  }
+  uint32_t pathHash = rdkcertcfg_binHash( file, strlen( file ), 0 );
+  pthread_mutex_lock( &certcfg_metaLock );
+  certcfg_meta_t *ent = certcfg_metaFind( file, pathHash );
+  if ( ent != NULL && ent->blob != NULL && rdkcertcfg_sameId( &ent->blob->id, &meta.id ) ) {
+    ent->blob->refCnt++;
+    *blob = ent->blob;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  if ( *blob != NULL ) {
+    return certcfgOk;
+  }
+
+  // the metadata is taken from the open file, so it describes the content that was read
+  int fd = certcfg_open( file, O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) {
+    return certcfgFileNotFound;
+  }
+  CERTCFG_COUNT( blobReads );
+  struct stat fileStat;
+  rdkcertcfgBlob_t *newBlob = NULL;
+  retval = ( certcfg_fstat( fd, &fileStat ) == 0 ) ? certcfgOk : certcfgFileNotFound;
+  if ( retval == certcfgOk && ( fileStat.st_size < 0 || fileStat.st_size > CERTCFG_BLOB_MAX ) ) {
+    ERROR_LOG( " %s:cert file too large [%s]\n", __FUNCTION__, file );
+    retval = certcfgFileError;
+  }
+  if ( retval == certcfgOk ) {
+    newBlob = (rdkcertcfgBlob_t *)malloc( sizeof(rdkcertcfgBlob_t) + fileStat.st_size );
+    if ( newBlob == NULL ) {
+      ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+      retval = certcfgGeneralFailure;
+    }
+  }
+  size_t readLen = 0;
+  while ( retval == certcfgOk && readLen < (size_t)fileStat.st_size ) {
+    ssize_t chunk = read( fd, newBlob->data + readLen, fileStat.st_size - readLen );
+    if ( chunk < 0 && errno == EINTR ) {
+      continue;
+    }
+    if ( chunk <= 0 ) {
+      retval = certcfgFileError;  // error, or the file shrank while being read
+      break;
+    }
+    readLen += chunk;
+  }
+  close( fd );
+  if ( retval != certcfgOk ) {
+    free( newBlob );
+    return retval;
+  }
+  newBlob->refCnt = 1;
+  certcfg_setFileId( &newBlob->id, &fileStat );
+  newBlob->len = readLen;
+
+  pthread_mutex_lock( &certcfg_metaLock );
+  ent = certcfg_metaFind( file, pathHash );
+  if ( ent != NULL ) {  // removed if the cache was emptied meanwhile
+    certcfg_blobUnref( ent->blob );
+    newBlob->refCnt++;
+    ent->blob = newBlob;
+  }
+  pthread_mutex_unlock( &certcfg_metaLock );
+  *blob = newBlob;
+  return certcfgOk;
+} // rdkcertcfg_certBlob( )
+
+void rdkcertcfg_releaseBlob( rdkcertcfgBlob_t **blob ) {
+  if ( blob == NULL || *blob == NULL ) {
+    return;
+  }
+  pthread_mutex_lock( &certcfg_metaLock );
+  certcfg_blobUnref( *blob );
+  pthread_mutex_unlock( &certcfg_metaLock );
+  *blob = NULL;
+}
+
+/**
+ * Enable, or disable, the passcode cache.
+ * In @param ttlMs; time to reuse a passcode in milliseconds, 0 disables the cache and wipes it
+ * @return certcfgOk, certcfgGeneralFailure if the memory can't be locked
+**/
+rdkcertcfgStatus_t rdkcertcfg_setPassTtl( unsigned int ttlMs ) {
+  rdkcertcfgStatus_t retval = certcfgOk;
+  pthread_mutex_lock( &certcfg_passLock );
+  if ( ttlMs == 0 ) {
+    if ( certcfg_passTab != NULL ) {
+      certcfg_passWipe( certcfg_passTab, certcfg_passMapsz );
+      munlock( certcfg_passTab, certcfg_passMapsz );
+      munmap( certcfg_passTab, certcfg_passMapsz );
+      certcfg_passTab = NULL;
+    }
+  } else if ( certcfg_passTab == NULL ) {
+    long pagesz = sysconf( _SC_PAGESIZE );
+    size_t mapsz = sizeof(certcfg_pass_t) * CERTCFG_PASS_MAX;
+    mapsz = ( mapsz + pagesz - 1 ) / pagesz * pagesz;
+    void *map = mmap( NULL, mapsz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if ( map == MAP_FAILED ) {
+      ERROR_LOG( " %s:passcode cache not mapped (%d)\n", __FUNCTION__, errno );
+      retval = certcfgGeneralFailure;
+    } else if ( mlock( map, mapsz ) != 0 ) {
+      // passcodes must not reach swap; no cache rather than an unlocked one
+      ERROR_LOG( " %s:passcode cache not locked (%d)\n", __FUNCTION__, errno );
+      munmap( map, mapsz );
+      retval = certcfgGeneralFailure;
+    } else {
+#ifdef MADV_DONTDUMP
+      madvise( map, mapsz, MADV_DONTDUMP );
+#endif
+#ifdef MADV_WIPEONFORK
+      madvise( map, mapsz, MADV_WIPEONFORK );
+#endif
+      certcfg_passTab = (certcfg_pass_t *)map;  // anonymous pages are zero, every entry is free
+      certcfg_passMapsz = mapsz;
+    }
+  }
+  certcfg_passTtlNs = ( retval == certcfgOk ) ? (uint64_t)ttlMs * 1000000 : 0;
+  pthread_mutex_unlock( &certcfg_passLock );
+  return retval;
+} // rdkcertcfg_setPassTtl( )
+
+rdkcertcfgStatus_t rdkcertcfg_passGet( const char *credRef, char *pass, size_t passsz ) {
+  rdkcertcfgStatus_t retval = certcfgFileNotFound;
+  if ( credRef == NULL || pass == NULL ) {
+    return certcfgBadPointer;
+  }
+  pthread_mutex_lock( &certcfg_passLock );
+  if ( certcfg_passTab != NULL ) {
+    uint64_t now = certcfg_nowNs();
+    for ( int indx = 0; indx < CERTCFG_PASS_MAX; indx++ ) {
+      certcfg_pass_t *ent = &certcfg_passTab[indx];
+      if ( ent->credRef[0] == '\0' || strcmp( ent->credRef, credRef ) != 0 ) {
+        continue;
+      }
+      if ( now >= ent->expiresNs ) {
+        certcfg_passWipe( ent, sizeof(*ent) );
+      } else if ( strlen( ent->pass ) < passsz ) {
+        strcpy( pass, ent->pass );
+        retval = certcfgOk;
+      }
+      break;
+    }
+    if ( retval == certcfgOk ) {
+      CERTCFG_COUNT( passHits );
+    } else {
+      CERTCFG_COUNT( passMisses );
+    }
+  }
+  pthread_mutex_unlock( &certcfg_passLock );
+  return retval;
+} // rdkcertcfg_passGet( )
+
+int rdkcertcfg_passEnabled( void ) {
+  pthread_mutex_lock( &certcfg_passLock );
+  int enabled = ( certcfg_passTab != NULL );
+  pthread_mutex_unlock( &certcfg_passLock );
+  return enabled;
+} // rdkcertcfg_passEnabled( )
+
+int rdkcertcfg_passCached( const char *credRef ) {
+  int cached = 0;
+  if ( credRef == NULL ) {
+    return 0;
+  }
+  pthread_mutex_lock( &certcfg_passLock );
+  if ( certcfg_passTab != NULL ) {
+    uint64_t now = certcfg_nowNs();
+    for ( int indx = 0; indx < CERTCFG_PASS_MAX; indx++ ) {
+      certcfg_pass_t *ent = &certcfg_passTab[indx];
+      if ( ent->credRef[0] != '\0' && strcmp( ent->credRef, credRef ) == 0 ) {
+        cached = ( now < ent->expiresNs );
+        break;
+      }
+    }
+  }
+  pthread_mutex_unlock( &certcfg_passLock );
+  return cached;
+} // rdkcertcfg_passCached( )
+
+void rdkcertcfg_passPut( const char *credRef, const char *pass ) {
+  if ( credRef == NULL || pass == NULL || *credRef == '\0' ||
+       strlen( credRef ) >= CERTCFG_PASS_LEN || strlen( pass ) >= CERTCFG_PASS_LEN ) {
+    return;
+  }
+  pthread_mutex_lock( &certcfg_passLock );
+  if ( certcfg_passTab != NULL ) {
+    uint64_t now = certcfg_nowNs();
+    certcfg_pass_t *slot = NULL;
+    for ( int indx = 0; indx < CERTCFG_PASS_MAX; indx++ ) {
+      certcfg_pass_t *ent = &certcfg_passTab[indx];
+      if ( ent->credRef[0] != '\0' && strcmp( ent->credRef, credRef ) == 0 ) {
+        slot = ent;
+        break;
+      }
+      // a free or expired entry, else the one expiring first
+      if ( slot == NULL || ( slot->credRef[0] != '\0' &&
+           ( ent->credRef[0] == '\0' || now >= ent->expiresNs || ent->expiresNs < slot->expiresNs ) ) ) {
+        slot = ent;
+      }
+    }
+    certcfg_passWipe( slot, sizeof(*slot) );
+    strcpy( slot->credRef, credRef );
+    strcpy( slot->pass, pass );
+    slot->expiresNs = now + certcfg_passTtlNs;
+  }
+  pthread_mutex_unlock( &certcfg_passLock );
+} // rdkcertcfg_passPut( )
+
+void rdkcertcfg_passPurge( const char *credRef ) {
+  pthread_mutex_lock( &certcfg_passLock );
+  certcfg_passWipeRef( credRef );
+  pthread_mutex_unlock( &certcfg_passLock );
+} // rdkcertcfg_passPurge( )
+
+void rdkcertcfg_passHold( rdkcertcfgPassHolds_t *holds, const char *credRef ) {
+  if ( holds == NULL || credRef == NULL || *credRef == '\0' || !rdkcertcfg_passEnabled() ) {
+    return; // with no cache there is no passcode to wipe
+  }
+  size_t reflen = strlen( credRef );
+  uint32_t hash = rdkcertcfg_binHash( credRef, reflen, 0 );
+  size_t mask = holds->slotCnt - 1, slot;
+  if ( holds->slots != NULL ) {
+    for ( slot = hash & mask; holds->slots[slot] != NULL; slot = ( slot + 1 ) & mask ) {
+      if ( holds->slots[slot]->hash == hash && strcmp( holds->slots[slot]->credRef, credRef ) == 0 ) {
+        return; // already held by this handle
+      }
+    }
+  }
+  // at most half full
+  if ( ( holds->cnt + 1 ) * 2 > holds->slotCnt ) {
+    size_t slotCnt = ( holds->slotCnt == 0 ) ? 8 : holds->slotCnt * 2;
+    certcfg_hold_t **slots = (certcfg_hold_t **)calloc( slotCnt, sizeof(*slots) );
+    if ( slots == NULL ) {
+      ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+      return; // not held, the passcode is wiped when it expires or with the last handle
+    }
+    for ( size_t indx = 0; indx < holds->slotCnt; indx++ ) {
+      certcfg_hold_t *held = holds->slots[indx];
+      if ( held != NULL ) {
+        for ( slot = held->hash & ( slotCnt - 1 ); slots[slot] != NULL; slot = ( slot + 1 ) & ( slotCnt - 1 ) );
+        slots[slot] = held;
+      }
+    }
+    free( holds->slots );
+    holds->slots = slots;
+    holds->slotCnt = slotCnt;
+    mask = slotCnt - 1;
+  }
+
+  pthread_mutex_lock( &certcfg_passLock );
+  certcfg_hold_t **bucket = &certcfg_holdTab[hash % CERTCFG_HOLD_BUCKETS];
+  certcfg_hold_t *hold = *bucket;
+  while ( hold != NULL && ( hold->hash != hash || strcmp( hold->credRef, credRef ) != 0 ) ) {
+    hold = hold->next;
+  }
+  if ( hold == NULL ) {
+    hold = (certcfg_hold_t *)malloc( sizeof(certcfg_hold_t) + reflen + 1 );
+    if ( hold != NULL ) {
+      hold->hash = hash;
+      hold->cnt = 0;
+      memcpy( hold->credRef, credRef, reflen + 1 );
+      hold->next = *bucket;
+      *bucket = hold;
+    }
+  }
+  if ( hold != NULL ) {
+    hold->cnt++;
+  }
+  pthread_mutex_unlock( &certcfg_passLock );
+
+  if ( hold == NULL ) {
+    ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+    return;
+  }
+  // the entry stays while this handle holds it, so the handle keeps a pointer to it
+  for ( slot = hash & mask; holds->slots[slot] != NULL; slot = ( slot + 1 ) & mask );
+  holds->slots[slot] = hold;
+  holds->cnt++;
+} // rdkcertcfg_passHold( )
+
+void rdkcertcfg_passRelease( rdkcertcfgPassHolds_t *holds ) {
+  if ( holds == NULL ) {
+    return;
+  }
+  if ( holds->cnt != 0 ) {
+    pthread_mutex_lock( &certcfg_passLock );
+    for ( size_t indx = 0; indx < holds->slotCnt; indx++ ) {
+      certcfg_hold_t *hold = holds->slots[indx];
+      if ( hold == NULL || --hold->cnt != 0 ) {
+        continue;
+      }
+      certcfg_hold_t **link = &certcfg_holdTab[hold->hash % CERTCFG_HOLD_BUCKETS];
+      while ( *link != hold ) {
+        link = &(*link)->next;
+      }
+      *link = hold->next;
+      certcfg_passWipeRef( hold->credRef );  // no handle left to use the passcode
+      free( hold );
+    }
+    pthread_mutex_unlock( &certcfg_passLock );
+  }
+  free( holds->slots );
+  holds->slots = NULL;
+  holds->slotCnt = holds->cnt = 0;
+} // rdkcertcfg_passRelease( )
+
+void rdkcertcfg_getCounters( rdkcertcfgCounters_t *counters ) {
+  if ( counters == NULL ) {
+    return;
+  }
+  counters->statCalls = __atomic_load_n( &certcfg_counters.statCalls, __ATOMIC_RELAXED );
+  counters->openCalls = __atomic_load_n( &certcfg_counters.openCalls, __ATOMIC_RELAXED );
+  counters->metaHits = __atomic_load_n( &certcfg_counters.metaHits, __ATOMIC_RELAXED );
+  counters->metaMisses = __atomic_load_n( &certcfg_counters.metaMisses, __ATOMIC_RELAXED );
+  counters->hashReads = __atomic_load_n( &certcfg_counters.hashReads, __ATOMIC_RELAXED );
+  counters->blobReads = __atomic_load_n( &certcfg_counters.blobReads, __ATOMIC_RELAXED );
+  counters->passHits = __atomic_load_n( &certcfg_counters.passHits, __ATOMIC_RELAXED );
+  counters->passMisses = __atomic_load_n( &certcfg_counters.passMisses, __ATOMIC_RELAXED );
+}
+
+int rdkcertcfg_sameId( const rdkcertcfgFileId_t *id1, const rdkcertcfgFileId_t *id2 ) {
+  return ( id1->dev == id2->dev && id1->ino == id2->ino && id1->size == id2->size &&
+           id1->mtime.tv_sec == id2->mtime.tv_sec && id1->mtime.tv_nsec == id2->mtime.tv_nsec );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int certcfg_sameFile( const rdkcertcfgFileId_t *fileId, const struct stat *fileStat ) {
+  return ( fileId->dev == fileStat->st_dev && fileId->ino == fileStat->st_ino &&
+           fileId->size == fileStat->st_size &&
+           fileId->mtime.tv_sec == fileStat->st_mtim.tv_sec &&
+           fileId->mtime.tv_nsec == fileStat->st_mtim.tv_nsec );
+}
+
+static void certcfg_setFileId( rdkcertcfgFileId_t *fileId, const struct stat *fileStat ) {
+  fileId->dev = fileStat->st_dev;
+  fileId->ino = fileStat->st_ino;
+  fileId->size = fileStat->st_size;
+  fileId->mtime = fileStat->st_mtim;
+}
+
+// file syscalls, counted for rdkcertcfg_getCounters
+static int certcfg_stat( const char *path, struct stat *fileStat ) {
+  CERTCFG_COUNT( statCalls );
+  return stat( path, fileStat );
+}
+
+static int certcfg_fstat( int fd, struct stat *fileStat ) {
+  CERTCFG_COUNT( statCalls );
+  return fstat( fd, fileStat );
+}
+
+static int certcfg_open( const char *path, int flags ) {
+  CERTCFG_COUNT( openCalls );
+  return open( path, flags );
+}
+
+static FILE *certcfg_fopen( const char *path, const char *mode ) {
+  CERTCFG_COUNT( openCalls );
+  return fopen( path, mode );
+}
+
+// check if the directory of a file is watched; takes the lock
+static int certcfg_dirWatched( const char *path ) {
+  size_t namePos = strlen( path );
+  while ( namePos > 0 && path[namePos-1] != '/' ) {
+    namePos--;
+  }
+  const char *dir = ( namePos > 0 ) ? path : ".";
+  size_t dirlen = ( namePos > 1 ) ? namePos - 1 : 1;
+  int watched = 0;
+  certcfg_watchDir_t *wdir;
+  pthread_mutex_lock( &certcfg_lock );
+  for ( wdir = certcfg_watchDirs; wdir != NULL; wdir = wdir->next ) {
+    if ( strncmp( wdir->dir, dir, dirlen ) == 0 && wdir->dir[dirlen] == '\0' ) {
+      watched = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+  return watched;
+}
+
+// drop a reference to a blob, called with certcfg_metaLock held; the content is wiped when freed
+static void certcfg_blobUnref( rdkcertcfgBlob_t *blob ) {
+  if ( blob != NULL && --blob->refCnt == 0 ) {
+    memset( blob->data, 0, blob->len );
+    free( blob );
+  }
+}
+
+// find the cert metadata cache entry of a file; called with the metadata lock held
+static certcfg_meta_t *certcfg_metaFind( const char *file, uint32_t hash ) {
+  certcfg_meta_t *ent = certcfg_metaTab[hash % CERTCFG_META_BUCKETS];
+  while ( ent != NULL && ( ent->hash != hash || strcmp( ent->path, file ) != 0 ) ) {
+    ent = ent->next;
+  }
+  return ent;
+}
+
+// wipe passcode cache memory; volatile so the stores are not dropped as dead before munmap
+static void certcfg_passWipe( void *pass, size_t sz ) {
+  volatile unsigned char *mem = (volatile unsigned char *)pass;
+  for ( size_t i = 0; i < sz; i++ ) {
+    mem[i] = 0;
+  }
+}
+
+// wipe the cached passcode of a credential reference, or all if credRef is NULL; caller holds certcfg_passLock
+static void certcfg_passWipeRef( const char *credRef ) {
+  if ( certcfg_passTab == NULL ) {
+    return;
+  }
+  for ( int indx = 0; indx < CERTCFG_PASS_MAX; indx++ ) {
+    certcfg_pass_t *ent = &certcfg_passTab[indx];
+    if ( credRef == NULL || strcmp( ent->credRef, credRef ) == 0 ) {
+      certcfg_passWipe( ent, sizeof(*ent) );
+    }
+  }
+}
+
+// monotonic time in nanoseconds, read through the vdso on linux
+static uint64_t certcfg_nowNs( void ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// read the config file into a new image, refCnt is 1 (the entry's reference)
+// lines are split into fields; empty lines are dropped
+// a line that is too long stops the parse, rows before it are kept
+// returns NULL if the file can't be opened or on memory error
+rdkcertcfgSnap_t *rdkcertcfg_parseFile( const char *path ) {
+  int fd = certcfg_open( path, O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) {
+    ERROR_LOG( " %s:config file, %s, not found\n", __FUNCTION__, path );
+    return NULL;
+  }
+
+  // identity of the file actually opened, in case it was replaced after the caller's stat
+  struct stat cfgStat;
+  rdkcertcfgSnap_t *snap = (rdkcertcfgSnap_t *)calloc( 1, sizeof(rdkcertcfgSnap_t) );
+  if ( snap == NULL || certcfg_fstat( fd, &cfgStat ) != 0 ) {
+    ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+    free( snap );
+    close( fd );
+    return NULL;
+  }
+  certcfg_setFileId( &snap->fileId, &cfgStat );
+  snap->refCnt = 1;
+  snap->endStat = certcfgFileNotFound;
+
+  // rows are grown as needed, starting from a typical line length
+  size_t fileLen = (size_t)cfgStat.st_size;
+  size_t rowMax = fileLen / ROW_LEN_EST + 16;
+  snap->rows = (rdkcertcfgRow_t *)malloc( rowMax * sizeof(rdkcertcfgRow_t) );
+  snap->pool = (char *)malloc( fileLen + 1 );
+
+  // large files are parsed from a read only mapping, small ones are read straight into the pool,
+  // which is cheaper than setting up a mapping for a few lines
+  const char *map = NULL;
+  int mapped = 0;
+  if ( snap->rows != NULL && snap->pool != NULL ) {
+    if ( fileLen >= CFG_MAP_MIN ) {
+      void *addr = mmap( NULL, fileLen, PROT_READ, MAP_PRIVATE | CFG_MAP_FLAGS, fd, 0 );
+      if ( addr != MAP_FAILED ) {
+        map = (const char *)addr;
+        mapped = 1;
+      }
+    } else {
+      ssize_t readLen = read( fd, snap->pool, fileLen );
+      if ( readLen >= 0 ) {
+        fileLen = (size_t)readLen;  // file shrank since fstat, its new identity is seen on the next refresh
+        map = snap->pool;
+      }
+    }
+  }
+  close( fd );
+  if ( map == NULL ) {
+    ERROR_LOG( " %s:%s error\n", __FUNCTION__, ( snap->rows == NULL || snap->pool == NULL ) ? "memory" : "read" );
+    certcfg_freeSnap( snap );
+    return NULL;
+  }
+  const char *pos, *end = map + fileLen;
+
+  // split each line into fields; the same as reading lines of up to MAX_LINE_LENGTH-1 characters with fgets,
+  // then tokenizing with strtok, which skips empty fields, but without copying or modifying the line
+  // do not allow unexpected whitespace
+  const char *line = map;
+  while ( line < end ) {
+    const char *nl = (const char *)memchr( line, '\n', end - line );
+    const char *lineEnd = ( nl != NULL ) ? nl : end;
+    if ( (size_t)( lineEnd - line ) + ( nl != NULL ) >= MAX_LINE_LENGTH ) {
+      ERROR_LOG( " %s: config line too long (%c)\n", __FUNCTION__, line[MAX_LINE_LENGTH-1] );
+      snap->endStat = certcfgFileError;
+      break;
+    }
+    const char *nul = (const char *)memchr( line, '\0', lineEnd - line );
+    const char *fldEnd = ( nul != NULL ) ? nul : lineEnd;  // string functions stop at a null
+
+    if ( snap->rowCnt == rowMax ) {
+      rdkcertcfgRow_t *newrows = (rdkcertcfgRow_t *)realloc( snap->rows, 2 * rowMax * sizeof(rdkcertcfgRow_t) );
+      if ( newrows == NULL ) {
+        break;
+      }
+      snap->rows = newrows;
+      rowMax *= 2;
+    }
+    rdkcertcfgRow_t *row = &snap->rows[snap->rowCnt];
+    row->fieldCnt = 0;
+    pos = line;
+    while ( row->fieldCnt < CERTCFG_FLD_CNT ) {
+      while ( pos < fldEnd && *pos == DELIM_CHAR ) pos++;
+      if ( pos == fldEnd ) {
+        break;
+      }
+      const char *delim = (const char *)memchr( pos, DELIM_CHAR, fldEnd - pos );
+      const char *fieldEnd = ( delim != NULL ) ? delim : fldEnd;
+      row->fieldOff[row->fieldCnt] = (uint32_t)( pos - map );
+      row->fieldLen[row->fieldCnt] = (uint16_t)( fieldEnd - pos );
+      row->fieldCnt++;
+      pos = fieldEnd;
+    }
+    if ( row->fieldCnt != 0 ) {
+      snap->rowCnt++;
+    }
+    line = lineEnd + ( nl != NULL );
+  } // end while
+
+  // the image keeps its own copy of the parsed lines; a long lived mapping would fault
+  // if the file were truncated while a handle still used the image
+  if ( mapped ) {
+    memcpy( snap->pool, map, line - map );
+    munmap( (void *)map, fileLen );
+  }
+  if ( line < end && snap->endStat != certcfgFileError ) {
+    ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+    certcfg_freeSnap( snap );
+    return NULL;
+  }
+
+  EXTRA_DEBUG_LOG( " %s:%zu rows in %s\n", __FUNCTION__, snap->rowCnt, path );
+  return snap;
+} // rdkcertcfg_parseFile( )
+
+// check if an image is still the current one for the config file, and the compiled file if it is used
+static int certcfg_snapCurrent( const rdkcertcfgSnap_t *snap, const struct stat *cfgStat, int useBin, const struct stat *binStat ) {
+  if ( snap == NULL || !certcfg_sameFile( &snap->fileId, cfgStat ) ) {
+    return 0;
+  }
+  return useBin ? ( snap->binState != CERTCFG_BIN_NONE && certcfg_sameFile( &snap->binId, binStat ) )
+                : ( snap->binState == CERTCFG_BIN_NONE );
+}
+
+// build a new image of a config file, from the compiled file if useBin, falling back to the text file
+static rdkcertcfgSnap_t *certcfg_loadSnap( const rdkcertcfg_t *cfg, const struct stat *cfgStat, int useBin, const struct stat *binStat ) {
+  rdkcertcfgSnap_t *newsnap = NULL;
+  if ( useBin ) {
+    newsnap = rdkcertcfg_loadBin( cfg->binPath );
+    if ( newsnap == NULL ) {
+      ERROR_LOG( " %s:compiled config, %s, rejected, using %s\n", __FUNCTION__, cfg->binPath, cfg->path );
+      newsnap = rdkcertcfg_parseFile( cfg->path );
+      if ( newsnap != NULL ) {
+        newsnap->binState = CERTCFG_BIN_REJECTED;
+      }
+    }
+    if ( newsnap != NULL ) {
+      certcfg_setFileId( &newsnap->binId, binStat );
+      certcfg_setFileId( &newsnap->fileId, cfgStat );
+    }
+  } else {
+    newsnap = rdkcertcfg_parseFile( cfg->path );
+  }
+  return newsnap;
+}
+
+// add a directory to the watcher, if not already watched; called with the lock held
+// returns the watch descriptor, -1 on error
+static int certcfg_watchDir( const char *dir, size_t dirlen ) {
+  certcfg_watchDir_t *wdir;
+  for ( wdir = certcfg_watchDirs; wdir != NULL; wdir = wdir->next ) {
+    if ( strncmp( wdir->dir, dir, dirlen ) == 0 && wdir->dir[dirlen] == '\0' ) {
+      return wdir->wd;
+    }
+  }
+  wdir = (certcfg_watchDir_t *)calloc( 1, sizeof(certcfg_watchDir_t) );
+  if ( wdir == NULL || ( wdir->dir = strndup( dir, dirlen ) ) == NULL ) {
+    free( wdir );
+    return -1;
+  }
+  wdir->wd = inotify_add_watch( certcfg_inotifyFd, wdir->dir, WATCH_MASK );
+  if ( wdir->wd < 0 ) {
+    free( wdir->dir );
+    free( wdir );
+    return -1;
+  }
+  wdir->next = certcfg_watchDirs;
+  certcfg_watchDirs = wdir;
+  EXTRA_DEBUG_LOG( " %s:watching directory [%s]\n", __FUNCTION__, wdir->dir );
+  return wdir->wd;
+}
+
+// watch the directories of the "file://" cert uris of an image; called with the lock held
+// a directory that can't be watched is logged, changes to its cert files are not seen
+static void certcfg_watchCertDirs( const rdkcertcfgSnap_t *snap ) {
+  const char *lastdir = NULL;
+  size_t lastlen = 0, rowIndx;
+  for ( rowIndx = 0; rowIndx < snap->rowCnt; rowIndx++ ) {
+    size_t urilen = 0;
+    const char *uri = rdkcertcfg_field( snap, &snap->rows[rowIndx], CERTCFG_FLD_URI, &urilen );
+    if ( uri == NULL || urilen <= sizeof(FILESCHEME)-1 || strncmp( uri, FILESCHEME, sizeof(FILESCHEME)-1 ) != 0 ) {
+      continue;
+    }
+    uri += sizeof(FILESCHEME)-1;
+    urilen -= sizeof(FILESCHEME)-1;
+    // directory is up to the last '/', "/" for the root directory, "." if there is none
+    size_t namePos = urilen;
+    while ( namePos > 0 && uri[namePos-1] != '/' ) {
+      namePos--;
+    }
+    const char *dir = ( namePos > 0 ) ? uri : ".";
+    size_t dirlen = ( namePos > 1 ) ? namePos - 1 : 1;
+    // rows of one directory are usually together
+    if ( lastdir != NULL && dirlen == lastlen && memcmp( dir, lastdir, dirlen ) == 0 ) {
+      continue;
+    }
+    if ( certcfg_watchDir( dir, dirlen ) < 0 ) {
+      ERROR_LOG( " %s:unable to watch cert directory [%.*s] (%d)\n", __FUNCTION__, (int)dirlen, dir, errno );
+    }
+    lastdir = dir;
+    lastlen = dirlen;
+  }
+}
+
+// watcher thread, waits for inotify events and reloads the entries whose files changed
+// events read together are handled together, so an entry is reloaded once for a burst of changes
+// if events were lost, every watched entry is reloaded; if a directory watch is lost, entries go back to
+// checking their files on each use
+static void *certcfg_watcher( void *arg ) {
+  char evbuf[4096] __attribute__(( aligned( __alignof__( struct inotify_event ) ) ));
+  (void)arg;
+
+  while ( 1 ) {
+    ssize_t evlen = read( certcfg_inotifyFd, evbuf, sizeof(evbuf) );
+    if ( evlen <= 0 ) {
+      if ( evlen < 0 && errno == EINTR ) {
+        continue;
+      }
+      ERROR_LOG( " %s:watcher stopped (%d)\n", __FUNCTION__, errno );
+      __atomic_store_n( &certcfg_watchOk, 0, __ATOMIC_RELEASE );
+      break;
+    }
+
+    pthread_mutex_lock( &certcfg_lock );
+    const char *evpos = evbuf;
+    while ( evpos < evbuf + evlen ) {
+      const struct inotify_event *ev = (const struct inotify_event *)evpos;
+      evpos += sizeof(struct inotify_event) + ev->len;
+      rdkcertcfg_t *cfg;
+      if ( ev->mask & IN_Q_OVERFLOW ) {
+        ERROR_LOG( " %s:events lost, reloading all\n", __FUNCTION__ );
+        for ( cfg = certcfg_list; cfg != NULL; cfg = cfg->next ) {
+          cfg->reloadPending = cfg->watched;
+        }
+      } else if ( ev->mask & IN_IGNORED ) {
+        ERROR_LOG( " %s:directory no longer watched, watching stopped\n", __FUNCTION__ );
+        __atomic_store_n( &certcfg_watchOk, 0, __ATOMIC_RELEASE );
+      } else if ( ev->len > 0 ) {
+        for ( cfg = certcfg_list; cfg != NULL; cfg = cfg->next ) {
+          if ( cfg->watched && cfg->watchWd == ev->wd &&
+               ( strcmp( ev->name, cfg->watchName ) == 0 || strcmp( ev->name, cfg->watchBinName ) == 0 ) ) {
+            cfg->reloadPending = 1;
+          }
+        }
+      }
+      __atomic_add_fetch( &certcfg_certSeq, 1, __ATOMIC_RELEASE );
+    }
+
+    // reload outside the lock; the entry is held so it is not freed meanwhile
+    while ( 1 ) {
+      rdkcertcfg_t *cfg = certcfg_list;
+      while ( cfg != NULL && !cfg->reloadPending ) {
+        cfg = cfg->next;
+      }
+      if ( cfg == NULL ) {
+        break;
+      }
+      cfg->reloadPending = 0;
+      cfg->attachCnt++;
+      int kind = cfg->kind;
+      pthread_mutex_unlock( &certcfg_lock );
+      if ( kind & CERTCFG_KIND_CONFIG ) {
+        certcfg_reload( cfg );
+      }
+      if ( kind & CERTCFG_KIND_HROT ) {
+        certcfg_reloadEngine( cfg );
+      }
+      rdkcertcfg_detach( &cfg );
+      pthread_mutex_lock( &certcfg_lock );
+    }
+    pthread_mutex_unlock( &certcfg_lock );
+  }
+  return NULL;
+} // certcfg_watcher( )
+
+// re-parse a watched config file and publish the new image; readers keep the old one until their next refresh
+// a missing config file publishes no image, so the next refresh reports it
+static void certcfg_reload( rdkcertcfg_t *cfg ) {
+  struct stat cfgStat, binStat;
+  int found = ( certcfg_stat( cfg->path, &cfgStat ) == 0 );
+  int useBin = ( found && certcfg_stat( cfg->binPath, &binStat ) == 0 && certcfg_newer( &binStat, &cfgStat ) );
+
+  rdkcertcfgSnap_t *cursnap = __atomic_load_n( &cfg->snap, __ATOMIC_ACQUIRE );
+  if ( found && certcfg_snapCurrent( cursnap, &cfgStat, useBin, &binStat ) ) {
+    return; // only the cert files in the directory changed
+  }
+  rdkcertcfgSnap_t *newsnap = found ? certcfg_loadSnap( cfg, &cfgStat, useBin, &binStat ) : NULL;
+  if ( found && newsnap == NULL ) {
+    return; // keep the current image; removed between stat and open, or memory error
+  }
+
+  rdkcertcfgSnap_t *freesnap = NULL;
+  pthread_mutex_lock( &certcfg_lock );
+  if ( cfg->snap != NULL && --cfg->snap->refCnt == 0 ) {
+    freesnap = cfg->snap;
+  }
+  __atomic_store_n( &cfg->snap, newsnap, __ATOMIC_RELEASE );
+  if ( newsnap != NULL ) {
+    certcfg_watchCertDirs( newsnap );
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+  certcfg_freeSnap( freesnap );
+  DEBUG_LOG( " %s:reloaded [%s], %zu rows\n", __FUNCTION__, cfg->path, newsnap != NULL ? newsnap->rowCnt : 0 );
+} // certcfg_reload( )
+
+// re-read the engine of a watched hrot properties file
+static void certcfg_reloadEngine( rdkcertcfg_t *cfg ) {
+  FILE *hrotfp = certcfg_fopen( cfg->path, "r" );
+  struct stat hrotStat;
+  if ( hrotfp != NULL && certcfg_fstat( fileno( hrotfp ), &hrotStat ) != 0 ) {
+    fclose( hrotfp );
+    hrotfp = NULL;
+  }
+  pthread_mutex_lock( &certcfg_lock );
+  if ( hrotfp == NULL ) {
+    cfg->engineValid = 0; // next use reports the file missing
+  } else if ( !cfg->engineValid || !certcfg_sameFile( &cfg->engineId, &hrotStat ) ) {
+    certcfg_readEngine( cfg, hrotfp );
+    certcfg_setFileId( &cfg->engineId, &hrotStat );
+    cfg->engineValid = 1;
+  }
+  pthread_mutex_unlock( &certcfg_lock );
+  if ( hrotfp != NULL ) {
+    fclose( hrotfp );
+  }
+} // certcfg_reloadEngine( )
+
+static void certcfg_freeSnap( rdkcertcfgSnap_t *snap ) {
+  if ( snap != NULL ) {
+    free( snap->refIndex );
+    certcfg_grpCand_t *grpCand = snap->grpCands;
+    while ( grpCand != NULL ) {
+      certcfg_grpCand_t *next = grpCand->next;
+      free( grpCand->cand );
+      free( grpCand );
+      grpCand = next;
+    }
+    free( snap->groups );
+    free( snap->grpIndex );
+    free( snap->cand );
+    if ( snap->bin != NULL ) {
+      free( (void *)snap->bin );
+    } else {
+      free( snap->rows );
+      free( snap->pool );
+    }
+    free( snap );
+  }
+}
+
+// find the hrot tag, should probably be on the first line, but can be later
+static void certcfg_readEngine( rdkcertcfg_t *cfg, FILE *hrotfp ) {
+  free( cfg->engine );
+  cfg->engine = NULL;
+
+  char hrotline[MAX_LINE_LENGTH + 2]; // one extra to check for trunctation
+  hrotline[MAX_LINE_LENGTH + 1]='1';
+
+  while ( fgets( hrotline, sizeof(hrotline), hrotfp ) ) {
+
+    // check if line from file was truncated
+    if ( hrotline[MAX_LINE_LENGTH + 1] != '1' ) {
+      ERROR_LOG( " %s: hrot line too long\n", __FUNCTION__ );
+      continue;
+    } else {
+
+      // remove terminal newline
+      char *nl = strchr( hrotline, '\n' );
+      if ( nl != NULL ) *nl = '\0';
+
+      // compare first part of line for engine tag
+      if ( strncmp( hrotline, ENGINETAG, sizeof(ENGINETAG)-1 ) == 0 ) {
+        cfg->engine = strdup( hrotline+sizeof(ENGINETAG)-1 );
+        EXTRA_DEBUG_LOG( " %s:hroteng[%s], hrotpath[%s]\n", __FUNCTION__, cfg->engine ? cfg->engine : "", cfg->path );
+        break;
+      }
+    } // end else line read ok
+  } // end while
+} // certcfg_readEngine( )
+
+// build the cert ref index, table size is a power of 2 at least twice the row count
+// rows are added in file order and a ref already in the table is not replaced, so the first row wins
+// rows without a cert ref are not indexed
+static uint32_t *certcfg_buildRefIndex( const rdkcertcfgSnap_t *snap, size_t *indexsz ) {
+  size_t tablesz = 16;
+  while ( tablesz < 2 * snap->rowCnt ) tablesz *= 2;
+  uint32_t *refIndex = (uint32_t *)calloc( tablesz, sizeof(uint32_t) );
+  if ( refIndex == NULL ) {
+    ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+    return NULL;
+  }
+
+  size_t mask = tablesz - 1;
+  size_t rowIndx;
+  for ( rowIndx = 0; rowIndx < snap->rowCnt; rowIndx++ ) {
+    size_t reflen = 0;
+    const char *certRef = rdkcertcfg_field( snap, &snap->rows[rowIndx], CERTCFG_FLD_LABEL, &reflen );
+    if ( certRef == NULL ) {
+      continue;
+    }
+    size_t slot = rdkcertcfg_binHash( certRef, reflen, 0 ) & mask;
+    while ( refIndex[slot] != 0 ) {
+      const rdkcertcfgRow_t *row = &snap->rows[refIndex[slot]-1];
+      if ( row->fieldLen[CERTCFG_FLD_LABEL] == reflen &&
+           memcmp( rdkcertcfg_field( snap, row, CERTCFG_FLD_LABEL, NULL ), certRef, reflen ) == 0 ) {
+        break;
+      }
+      slot = ( slot + 1 ) & mask;
+    }
+    if ( refIndex[slot] == 0 ) {
+      refIndex[slot] = (uint32_t)rowIndx + 1;
+    }
+  }
+  *indexsz = tablesz;
+  EXTRA_DEBUG_LOG( " %s:%zu rows, %zu slots\n", __FUNCTION__, snap->rowCnt, tablesz );
+  return refIndex;
+} // certcfg_buildRefIndex( )
+
+// intern the groups of a text image and list the candidate rows of each group, in file order
+// the groups of each row are looked up once, then the (group, row) pairs are sorted by group
+// a group listed more than once on a row is one candidate
+// returns 0, -1 on memory error
+static int certcfg_buildGroups( rdkcertcfgSnap_t *snap ) {
+  size_t grpMax = 16, tablesz = 32, pairMax = snap->rowCnt + 16, candCnt = 0, rowIndx, grpIndx, pairIndx;
+  uint32_t *pairGrp = (uint32_t *)malloc( pairMax * sizeof(uint32_t) );
+  uint32_t *pairRow = (uint32_t *)malloc( pairMax * sizeof(uint32_t) );
+  snap->groups = (rdkcertcfgGroup_t *)malloc( grpMax * sizeof(rdkcertcfgGroup_t) );
+  snap->grpIndex = (uint32_t *)calloc( tablesz, sizeof(uint32_t) );
+  int retval = -1;
+  if ( pairGrp == NULL || pairRow == NULL || snap->groups == NULL || snap->grpIndex == NULL ) {
+    goto done;
+  }
+  snap->grpIndexSz = tablesz;
+
+  // first of each group is the last row seen + 1 until the candidates are placed
+  for ( rowIndx = 0; rowIndx < snap->rowCnt; rowIndx++ ) {
+    size_t fldlen = 0, grplen = 0;
+    const char *grpfield = rdkcertcfg_field( snap, &snap->rows[rowIndx], CERTCFG_FLD_GROUP, &fldlen );
+    const char *fldend = grpfield + fldlen, *grpname;
+    while ( ( grpname = certcfg_nextGroup( &grpfield, fldend, &grplen ) ) != NULL ) {
+      uint32_t *slot = certcfg_groupSlot( snap, snap->grpIndex, snap->grpIndexSz, grpname, grplen );
+      if ( *slot == 0 ) {
+        if ( snap->grpCnt == grpMax ) {
+          rdkcertcfgGroup_t *newgrps = (rdkcertcfgGroup_t *)realloc( snap->groups, 2 * grpMax * sizeof(rdkcertcfgGroup_t) );
+          if ( newgrps == NULL ) {
+            goto done;
+          }
+          snap->groups = newgrps;
+          grpMax *= 2;
+        }
+        rdkcertcfgGroup_t *grp = &snap->groups[snap->grpCnt];
+        grp->nameOff = (uint32_t)( grpname - snap->pool );
+        grp->nameLen = (uint32_t)grplen;
+        grp->first = 0;
+        grp->count = 0;
+        *slot = (uint32_t)++snap->grpCnt;
+
+        // keep the table at most half full
+        if ( 2 * snap->grpCnt > tablesz ) {
+          uint32_t *newIndex = (uint32_t *)calloc( 2 * tablesz, sizeof(uint32_t) );
+          if ( newIndex == NULL ) {
+            goto done;
+          }
+          for ( grpIndx = 0; grpIndx < snap->grpCnt; grpIndx++ ) {
+            const rdkcertcfgGroup_t *g = &snap->groups[grpIndx];
+            *certcfg_groupSlot( snap, newIndex, 2 * tablesz, snap->pool + g->nameOff, g->nameLen ) = (uint32_t)grpIndx + 1;
+          }
+          free( snap->grpIndex );
+          snap->grpIndex = newIndex;
+          tablesz *= 2;
+          snap->grpIndexSz = tablesz;
+          slot = certcfg_groupSlot( snap, snap->grpIndex, tablesz, grpname, grplen );
+        }
+      }
+      rdkcertcfgGroup_t *grp = &snap->groups[*slot-1];
+      if ( grp->first == rowIndx + 1 ) {
+        continue;
+      }
+      if ( candCnt == pairMax ) {
+        uint32_t *newGrp = (uint32_t *)realloc( pairGrp, 2 * pairMax * sizeof(uint32_t) );
+        pairGrp = ( newGrp != NULL ) ? newGrp : pairGrp;
+        uint32_t *newRow = (uint32_t *)realloc( pairRow, 2 * pairMax * sizeof(uint32_t) );
+        pairRow = ( newRow != NULL ) ? newRow : pairRow;
+        if ( newGrp == NULL || newRow == NULL ) {
+          goto done;
+        }
+        pairMax *= 2;
+      }
+      pairGrp[candCnt] = *slot - 1;
+      pairRow[candCnt] = (uint32_t)rowIndx;
+      candCnt++;
+      grp->first = (uint32_t)rowIndx + 1;
+      grp->count++;
+    }
+  }
+
+  // counting sort of the pairs by group; pairs are in row order, so each group's rows stay in file order
+  snap->cand = (uint32_t *)malloc( ( candCnt + 1 ) * sizeof(uint32_t) );
+  if ( snap->cand == NULL ) {
+    goto done;
+  }
+  size_t first = 0;
+  for ( grpIndx = 0; grpIndx < snap->grpCnt; grpIndx++ ) {
+    snap->groups[grpIndx].first = (uint32_t)first;
+    first += snap->groups[grpIndx].count;
+    snap->groups[grpIndx].count = 0;
+  }
+  for ( pairIndx = 0; pairIndx < candCnt; pairIndx++ ) {
+    rdkcertcfgGroup_t *grp = &snap->groups[pairGrp[pairIndx]];
+    snap->cand[grp->first + grp->count++] = pairRow[pairIndx];
+  }
+  EXTRA_DEBUG_LOG( " %s:%zu groups, %zu candidates\n", __FUNCTION__, snap->grpCnt, candCnt );
+  retval = 0;
+
+done:
+  free( pairGrp );
+  free( pairRow );
+  return retval;
+} // certcfg_buildGroups( )
+
+// candidate list of a group in a published list, NULL if not built yet
+static certcfg_grpCand_t *certcfg_findGrpCand( certcfg_grpCand_t *grpCand, const char *group, size_t grplen ) {
+  while ( grpCand != NULL && ( grpCand->nameLen != grplen || memcmp( grpCand->name, group, grplen ) != 0 ) ) {
+    grpCand = grpCand->next;
+  }
+  return grpCand;
+} // certcfg_findGrpCand( )
+
+// list the rows of a text image that include group, in file order; a group listed more than once on a row is one candidate
+// NULL on memory error
+static certcfg_grpCand_t *certcfg_buildGrpCand( const rdkcertcfgSnap_t *snap, const char *group, size_t grplen ) {
+  certcfg_grpCand_t *grpCand = (certcfg_grpCand_t *)calloc( 1, sizeof(certcfg_grpCand_t) + grplen + 1 );
+  if ( grpCand == NULL ) {
+    return NULL;
+  }
+  memcpy( grpCand->name, group, grplen );
+  grpCand->nameLen = grplen;
+  size_t candMax = 0, rowIndx;
+  for ( rowIndx = 0; rowIndx < snap->rowCnt; rowIndx++ ) {
+    if ( !rdkcertcfg_rowHasGroup( snap, &snap->rows[rowIndx], grpCand->name ) ) {
+      continue;
+    }
+    if ( grpCand->count == candMax ) {
+      candMax = ( candMax == 0 ) ? 16 : candMax * 2;
+      uint32_t *newCand = (uint32_t *)realloc( grpCand->cand, candMax * sizeof(uint32_t) );
+      if ( newCand == NULL ) {
+        free( grpCand->cand );
+        free( grpCand );
+        return NULL;
+      }
+      grpCand->cand = newCand;
+    }
+    grpCand->cand[grpCand->count++] = (uint32_t)rowIndx;
+  }
+  return grpCand;
+} // certcfg_buildGrpCand( )
+
+// slot of group in a group index, either holding the group or the empty slot it would go in
+// NULL if the image has no group index
+static uint32_t *certcfg_groupSlot( const rdkcertcfgSnap_t *snap, const uint32_t *grpIndex, size_t indexsz,
+                                    const char *group, size_t grplen ) {
+  if ( grpIndex == NULL ) {
+    return NULL;
+  }
+  size_t mask = indexsz - 1;
+  size_t slot = rdkcertcfg_binHash( group, grplen, 0 ) & mask;
+  while ( grpIndex[slot] != 0 ) {
+    const rdkcertcfgGroup_t *grp = &snap->groups[grpIndex[slot]-1];
+    if ( grp->nameLen == grplen && memcmp( snap->pool + grp->nameOff, group, grplen ) == 0 ) {
+      break;
+    }
+    slot = ( slot + 1 ) & mask;
+  }
+  return (uint32_t *)&grpIndex[slot];
+} // certcfg_groupSlot( )
+
+// next group of a '|' separated group field slice, skipping empty groups
+// returns the group and its length, NULL at end of field
+static const char *certcfg_nextGroup( const char **grpfield, const char *fldend, size_t *grplen ) {
+  const char *grp = *grpfield;
+  while ( grp < fldend && *grp == GRPDELIM_CHAR ) {
+    grp++;
+  }
+  if ( grp >= fldend ) {
+    return NULL;
+  }
+  const char *grpend = (const char *)memchr( grp, GRPDELIM_CHAR, fldend - grp );
+  *grplen = ( grpend != NULL ) ? (size_t)(grpend - grp) : (size_t)(fldend - grp);
+  *grpfield = grp + *grplen;
+  return grp;
+} // certcfg_nextGroup( )
+
+// FNV-1a, seeded, with a final mix so different seeds give independent values
+uint32_t rdkcertcfg_binHash( const void *data, size_t len, uint32_t seed ) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  uint32_t hash = 2166136261u ^ ( seed * 0x9e3779b9u );
+  while ( len-- > 0 ) {
+    hash ^= *bytes++;
+    hash *= 16777619u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+} // rdkcertcfg_binHash( )
+
+// compiled config file for path, "certsel.cfg" -> "certsel.bin", otherwise "path.bin"
+char *rdkcertcfg_binPath( const char *path ) {
+  size_t pathlen = strlen( path );
+  size_t sfxlen = sizeof(CFG_SUFFIX)-1;
+  if ( pathlen >= sfxlen && strcmp( path + pathlen - sfxlen, CFG_SUFFIX ) == 0 ) {
+    pathlen -= sfxlen;
+  }
+  char *binpath = (char *)malloc( pathlen + sizeof(BIN_SUFFIX) );
+  if ( binpath != NULL ) {
+    memcpy( binpath, path, pathlen );
+    strcpy( binpath + pathlen, BIN_SUFFIX );
+  }
+  return binpath;
+} // rdkcertcfg_binPath( )
+
+/**
+ * Read a compiled config file and validate it.
+ * Everything is range checked, so a corrupted file is rejected rather than trusted.
+ * The file is read into the heap, not mapped, so it can be rewritten in place while an image is in use
+ * without faulting its readers; the image is what was validated, whatever happens to the file.
+ * In @param binpath; compiled config file
+ * @return new image with refCnt 1, rows and pool point into its copy of the file; NULL if missing or invalid
+**/
+rdkcertcfgSnap_t *rdkcertcfg_loadBin( const char *binpath ) {
+  int fd = certcfg_open( binpath, O_RDONLY | O_CLOEXEC );
+  if ( fd < 0 ) {
+    return NULL;
+  }
+  struct stat binStat;
+  if ( certcfg_fstat( fd, &binStat ) != 0 || binStat.st_size < (off_t)sizeof(rdkcertcfgBinHdr_t) || binStat.st_size > UINT32_MAX ) {
+    ERROR_LOG( " %s:bad size, %s\n", __FUNCTION__, binpath );
+    close( fd );
+    return NULL;
+  }
+  size_t fileLen = (size_t)binStat.st_size;
+  void *image = malloc( fileLen );  // malloc alignment covers the 4 byte aligned tables
+  ssize_t readLen = ( image != NULL ) ? read( fd, image, fileLen ) : -1;
+  close( fd );
+  if ( readLen < 0 || (size_t)readLen != fileLen ) {
+    // a short read is a file changed since fstat; the checksum would reject it anyway
+    ERROR_LOG( " %s:%s error, %s\n", __FUNCTION__, ( image == NULL ) ? "memory" : "read", binpath );
+    free( image );
+    return NULL;
+  }
+
+  const rdkcertcfgBinHdr_t *bin = (const rdkcertcfgBinHdr_t *)image;
+  const char *base = (const char *)image;
+  const char *err = NULL;
+  uint32_t indx;
+
+  if ( memcmp( bin->magic, CERTCFG_BIN_MAGIC, sizeof(bin->magic) ) != 0 || bin->version != CERTCFG_BIN_VERSION ) {
+    err = "format";
+  } else if ( bin->bom != CERTCFG_BIN_BOM ) {
+    err = "byte order";
+  } else if ( bin->fileSize != fileLen ||
+              bin->checksum != rdkcertcfg_binHash( base + sizeof(*bin), fileLen - sizeof(*bin), 0 ) ) {
+    err = "checksum";
+  } else if ( !certcfg_binRange( fileLen, bin->rowOff, bin->rowCnt, sizeof(rdkcertcfgRow_t) ) ||
+              !certcfg_binRange( fileLen, bin->poolOff, bin->poolSz, 1 ) ||
+              !certcfg_binRange( fileLen, bin->candOff, bin->candCnt, sizeof(uint32_t) ) ||
+              !certcfg_binRange( fileLen, bin->grpOff, bin->grpCnt, sizeof(rdkcertcfgBinKey_t) ) ||
+              !certcfg_binRange( fileLen, bin->grpDispOff, bin->grpDispCnt, sizeof(uint32_t) ) ||
+              !certcfg_binRange( fileLen, bin->refOff, bin->refCnt, sizeof(rdkcertcfgBinKey_t) ) ||
+              !certcfg_binRange( fileLen, bin->refDispOff, bin->refDispCnt, sizeof(uint32_t) ) ||
+              ( bin->grpCnt != 0 && bin->grpDispCnt == 0 ) || ( bin->refCnt != 0 && bin->refDispCnt == 0 ) ||
+              ( bin->rowCnt != 0 && ( bin->poolSz == 0 || base[bin->poolOff + bin->poolSz - 1] != '\0' ) ) ||
+              ( bin->endStat != certcfgFileNotFound && bin->endStat != certcfgFileError ) ) {
+    err = "table range";
+  }
+
+  const rdkcertcfgRow_t *rows = (const rdkcertcfgRow_t *)( base + bin->rowOff );
+  for ( indx = 0; err == NULL && indx < bin->rowCnt; indx++ ) {
+    uint16_t fld;
+    if ( rows[indx].fieldCnt == 0 || rows[indx].fieldCnt > CERTCFG_FLD_CNT ) {
+      err = "row";
+    }
+    for ( fld = 0; err == NULL && fld < rows[indx].fieldCnt; fld++ ) {
+      if ( rows[indx].fieldOff[fld] >= bin->poolSz || rows[indx].fieldLen[fld] > bin->poolSz - rows[indx].fieldOff[fld] ) {
+        err = "row field";
+      }
+    }
+  }
+  const uint32_t *cand = (const uint32_t *)( base + bin->candOff );
+  for ( indx = 0; err == NULL && indx < bin->candCnt; indx++ ) {
+    if ( cand[indx] >= bin->rowCnt ) err = "candidate";
+  }
+  const rdkcertcfgBinKey_t *keys = (const rdkcertcfgBinKey_t *)( base + bin->grpOff );
+  for ( indx = 0; err == NULL && indx < bin->grpCnt; indx++ ) {
+    if ( keys[indx].nameOff != CERTCFG_BIN_EMPTY &&
+         ( keys[indx].nameOff >= bin->poolSz || keys[indx].first > bin->candCnt || keys[indx].count > bin->candCnt - keys[indx].first ) ) {
+      err = "group";
+    }
+  }
+  keys = (const rdkcertcfgBinKey_t *)( base + bin->refOff );
+  for ( indx = 0; err == NULL && indx < bin->refCnt; indx++ ) {
+    if ( keys[indx].nameOff != CERTCFG_BIN_EMPTY &&
+         ( keys[indx].nameOff >= bin->poolSz || keys[indx].first >= bin->rowCnt ) ) {
+      err = "cert ref";
+    }
+  }
+
+  rdkcertcfgSnap_t *snap = NULL;
+  if ( err == NULL ) {
+    snap = (rdkcertcfgSnap_t *)calloc( 1, sizeof(rdkcertcfgSnap_t) );
+    if ( snap == NULL ) {
+      err = "memory";
+    }
+  }
+  if ( err != NULL ) {
+    ERROR_LOG( " %s:%s error, %s\n", __FUNCTION__, err, binpath );
+    free( image );
+    return NULL;
+  }
+
+  snap->refCnt = 1;
+  snap->endStat = (rdkcertcfgStatus_t)bin->endStat;
+  snap->rowCnt = bin->rowCnt;
+  snap->rows = (rdkcertcfgRow_t *)( base + bin->rowOff );
+  snap->pool = (char *)( base + bin->poolOff );
+  snap->binState = CERTCFG_BIN_USED;
+  snap->bin = bin;
+  snap->binLen = fileLen;
+  certcfg_setFileId( &snap->binId, &binStat );
+  EXTRA_DEBUG_LOG( " %s:%zu rows, %u groups, %u refs in %s\n", __FUNCTION__, snap->rowCnt, bin->grpCnt, bin->refCnt, binpath );
+  return snap;
+} // rdkcertcfg_loadBin( )
+
+// compiled file must be strictly newer than the config file
+static int certcfg_newer( const struct stat *binStat, const struct stat *cfgStat ) {
+  if ( binStat->st_mtim.tv_sec != cfgStat->st_mtim.tv_sec ) {
+    return binStat->st_mtim.tv_sec > cfgStat->st_mtim.tv_sec;
+  }
+  return binStat->st_mtim.tv_nsec > cfgStat->st_mtim.tv_nsec;
+}
+
+// check a table of cnt elements at off fits in the file after the header
+static int certcfg_binRange( size_t fileLen, uint32_t off, uint32_t cnt, size_t elsz ) {
+  return ( off % sizeof(uint32_t) == 0 && off >= sizeof(rdkcertcfgBinHdr_t) && off <= fileLen &&
+           cnt <= ( fileLen - off ) / elsz );
+}
+
+// perfect hash lookup in a compiled file key table
+static const rdkcertcfgBinKey_t *certcfg_binLookup( const rdkcertcfgSnap_t *snap, uint32_t keyOff, uint32_t keyCnt,
+                                                    uint32_t dispOff, uint32_t dispCnt, const char *key ) {
+  if ( keyCnt == 0 ) {
+    return NULL;
+  }
+  const char *base = (const char *)snap->bin;
+  const rdkcertcfgBinKey_t *keys = (const rdkcertcfgBinKey_t *)( base + keyOff );
+  const uint32_t *disp = (const uint32_t *)( base + dispOff );
+  size_t keylen = strlen( key );
+
+  uint32_t bucket = rdkcertcfg_binHash( key, keylen, 0 ) % dispCnt;
+  const rdkcertcfgBinKey_t *slot = &keys[rdkcertcfg_binHash( key, keylen, disp[bucket] ) % keyCnt];
+  if ( slot->nameOff != CERTCFG_BIN_EMPTY && strcmp( snap->pool + slot->nameOff, key ) == 0 ) {
+    return slot;
+  }
+  return NULL;
+} // certcfg_binLookup( )
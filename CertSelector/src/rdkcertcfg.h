@@ -0,0 +1,303 @@
+#ifndef __RDKCERTCFG__
+#define __RDKCERTCFG__
+
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// internal api, shared by the cert selector and cert locator
+// process wide cache of parsed config (certsel.cfg) and hrot properties files
+// files are keyed by path and reference counted; every handle using the same file
+// shares one parsed image, which is only re-read when the file changes
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// values match rdkcertselectorStatus_t and rdkcertlocatorStatus_t
+typedef enum {
+    certcfgOk=0,
+    certcfgGeneralFailure=1,
+    certcfgBadPointer=2,
+    certcfgFileError=3,
+    certcfgFileNotFound=4,
+    certcfgBadArgument=5,
+} rdkcertcfgStatus_t;
+
+// config file fields as follows:
+// <group>,<label/certref>,<type>,<uri>,<credref>
+#define CERTCFG_FLD_GROUP 0
+#define CERTCFG_FLD_LABEL 1
+#define CERTCFG_FLD_TYPE 2
+#define CERTCFG_FLD_URI 3
+#define CERTCFG_FLD_CREDREF 4
+#define CERTCFG_FLD_CNT 5
+
+// one non-empty line of the config file; fields are slices of the image pool, not null terminated
+typedef struct rdkcertcfgRow_s {
+  uint16_t fieldCnt;                     // number of fields found on the line, up to CERTCFG_FLD_CNT
+  uint16_t fieldLen[CERTCFG_FLD_CNT];    // lines are shorter than 1024 bytes
+  uint32_t fieldOff[CERTCFG_FLD_CNT];
+} rdkcertcfgRow_t;
+
+// identity of a file, used to detect changes
+typedef struct rdkcertcfgFileId_s {
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  struct timespec mtime;
+} rdkcertcfgFileId_t;
+
+// compiled config file, certsel.bin, built from certsel.cfg by certselc
+// all integers are native byte order, all offsets are from the start of the file and 4 byte aligned
+// rows are rdkcertcfgRow_t with field offsets into the string pool
+// groups and cert refs are perfect hash tables of rdkcertcfgBinKey_t, (hash-displace):
+//   bucket = hash( key, 0 ) % dispCnt, slot = hash( key, disp[bucket] ) % keyCnt, then compare key name
+#define CERTCFG_BIN_MAGIC "CERTSELB"
+#define CERTCFG_BIN_VERSION 3
+#define CERTCFG_BIN_BOM 0x01020304u
+#define CERTCFG_BIN_EMPTY 0xffffffffu  // name offset of an unused hash slot
+
+typedef struct rdkcertcfgBinHdr_s {
+  char magic[8];
+  uint32_t version;
+  uint32_t bom;                // byte order mark, CERTCFG_BIN_BOM
+  uint32_t fileSize;
+  uint32_t checksum;           // FNV-1a of the file following the header
+  uint32_t endStat;            // rdkcertcfgSnap_t endStat
+  uint32_t rowCnt, rowOff;     // rdkcertcfgRow_t[rowCnt]
+  uint32_t poolSz, poolOff;    // interned strings, null terminated so keys can be compared as strings
+  uint32_t candCnt, candOff;   // uint32_t row indices, candidate rows of each group in file order
+  uint32_t grpCnt, grpOff;     // rdkcertcfgBinKey_t[grpCnt], first/count index the candidate rows
+  uint32_t grpDispCnt, grpDispOff;  // uint32_t[grpDispCnt]
+  uint32_t refCnt, refOff;     // rdkcertcfgBinKey_t[refCnt], first is the first row with the cert ref
+  uint32_t refDispCnt, refDispOff;  // uint32_t[refDispCnt]
+} rdkcertcfgBinHdr_t;
+
+typedef struct rdkcertcfgBinKey_s {
+  uint32_t nameOff;            // offset of key in string pool, CERTCFG_BIN_EMPTY if unused
+  uint32_t first;
+  uint32_t count;
+} rdkcertcfgBinKey_t;
+
+// distinct group of a text config image, interned by rdkcertcfg_groupIndex
+// its candidate rows are cand[first] to cand[first+count-1] of the image
+typedef struct rdkcertcfgGroup_s {
+  uint32_t nameOff;            // group name, a slice of the image pool
+  uint32_t nameLen;
+  uint32_t first;
+  uint32_t count;
+} rdkcertcfgGroup_t;
+
+// parsed image of a config file; rows are never modified once published
+// the cert ref index and group candidate lists are added on first lookup; freed when the last reference is released
+typedef struct rdkcertcfgSnap_s {
+  unsigned int refCnt;
+  rdkcertcfgFileId_t fileId;
+  rdkcertcfgStatus_t endStat;  // certcfgFileNotFound, or certcfgFileError if a line was too long to parse
+  size_t rowCnt;
+  rdkcertcfgRow_t *rows;
+  char *pool;                  // copy of the parsed part of the text file, or the compiled file string pool
+  uint32_t *refIndex;          // open addressing hash of cert ref (field 2) to row index+1, 0 if empty slot
+  size_t refIndexSz;           // power of 2
+  struct certcfg_grpCand_s *grpCands;  // text image candidate lists built on lookup, see rdkcertcfg_groupCand
+  int grpBuilt;                // groups, grpIndex and cand are built, see rdkcertcfg_groupIndex
+  rdkcertcfgGroup_t *groups;   // text image groups, in order of first use; NULL for compiled
+  size_t grpCnt;
+  uint32_t *grpIndex;          // open addressing hash of group name to group index+1, 0 if empty slot
+  size_t grpIndexSz;           // power of 2
+  uint32_t *cand;              // row indices, candidate rows of each group in file order
+  int binState;                // CERTCFG_BIN_NONE, _USED or _REJECTED
+  rdkcertcfgFileId_t binId;    // compiled file considered, if binState is not CERTCFG_BIN_NONE
+  const rdkcertcfgBinHdr_t *bin;  // copy of the compiled file, rows and pool point into it; NULL for text
+  size_t binLen;
+} rdkcertcfgSnap_t;
+
+#define CERTCFG_BIN_NONE 0       // no compiled file newer than the config file
+#define CERTCFG_BIN_USED 1
+#define CERTCFG_BIN_REJECTED 2   // compiled file is newer but invalid, text file used
+
+// shared, path keyed cache entry
+typedef struct rdkcertcfg_s rdkcertcfg_t;
+
+// attach to the cache entry for a file, creating it if needed; NULL on memory error
+rdkcertcfg_t *rdkcertcfg_attach( const char *path );
+// drop the reference taken by rdkcertcfg_attach, NULLs the pointer
+void rdkcertcfg_detach( rdkcertcfg_t **cfg );
+// path the entry was attached with
+const char *rdkcertcfg_getPath( const rdkcertcfg_t *cfg );
+
+// make sure *cfg is attached to path and *snap references the current image of the config file
+// re-parses the file only if it changed; replaces *snap, releasing the previous reference
+// returns certcfgOk, certcfgFileNotFound if the file is missing (*snap is released)
+rdkcertcfgStatus_t rdkcertcfg_refresh( rdkcertcfg_t **cfg, const char *path, rdkcertcfgSnap_t **snap );
+// release a reference to an image, NULLs the pointer
+void rdkcertcfg_release( rdkcertcfgSnap_t **snap );
+
+// get field of a row as a slice, NULL if not present; the field is not null terminated
+const char *rdkcertcfg_field( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, int fld, size_t *fldlen );
+// compare field of a row to str; return 1(true) or 0(false), 0 if not present
+int rdkcertcfg_fieldIs( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, int fld, const char *str );
+// find the first row whose cert ref (field 2) is certRef; NULL if not found
+// builds the cert ref index of the image on first use
+const rdkcertcfgRow_t *rdkcertcfg_findRef( rdkcertcfgSnap_t *snap, const char *certRef );
+// get the candidate list of a group, row indices in file order, pointing into the image; returns the number of rows
+// the list is valid while the image is referenced, *cand is NULL if the group has no rows
+// a text image builds the list of a group on its first lookup
+size_t rdkcertcfg_groupCand( rdkcertcfgSnap_t *snap, const char *group, const uint32_t **cand );
+// intern all groups of a text image into groups, grpIndex and cand, to list them; returns 0, -1 on memory error
+// not needed for lookups; a compiled image has its own group table
+int rdkcertcfg_groupIndex( rdkcertcfgSnap_t *snap );
+// get the candidate rows for a group, in file order; returns the total number of rows in the group
+// up to maxrows are stored in rows
+size_t rdkcertcfg_groupRows( rdkcertcfgSnap_t *snap, const char *group, const rdkcertcfgRow_t **rows, size_t maxrows );
+// check if the '|' separated group field of a row includes group; return 1(true) or 0(false)
+int rdkcertcfg_rowHasGroup( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row, const char *group );
+// check that a row has all fields, and uri and credref are shorter than urimax and credmax
+// then copy them, null terminated, into uri and credref if not NULL; buffers must hold urimax and credmax bytes
+// returns certcfgOk or certcfgFileError
+rdkcertcfgStatus_t rdkcertcfg_rowCert( const rdkcertcfgSnap_t *snap, const rdkcertcfgRow_t *row,
+                                       char *uri, size_t urimax, char *credref, size_t credmax );
+
+// path of the compiled config file for a config file; ".cfg" is replaced or ".bin" is appended
+// returns allocated string, NULL on memory error
+char *rdkcertcfg_binPath( const char *path );
+// parse a text config file into a new image, NULL if not found; release with rdkcertcfg_release
+// the file is read through a read only mapping and split into field slices without copying lines
+// the candidate rows of a group are listed on its first lookup, see rdkcertcfg_groupCand
+rdkcertcfgSnap_t *rdkcertcfg_parseFile( const char *path );
+// read and validate a compiled config file into a new image, NULL if not found or invalid
+rdkcertcfgSnap_t *rdkcertcfg_loadBin( const char *binpath );
+// hash used for compiled file keys and checksum
+uint32_t rdkcertcfg_binHash( const void *data, size_t len, uint32_t seed );
+
+// watch a file with inotify from a shared watcher thread; a config file is re-parsed by the watcher when it
+// changes and rdkcertcfg_refresh no longer checks the file, an hrot properties file has its engine re-read
+// the directories of the cert files named in the config are watched too; watched until the entry is freed
+// returns certcfgOk, certcfgGeneralFailure if the file can't be watched
+rdkcertcfgStatus_t rdkcertcfg_watch( rdkcertcfg_t *cfg );
+// check if an entry is watched and the watcher has not lost track of changes; 1(true) or 0(false)
+int rdkcertcfg_watching( const rdkcertcfg_t *cfg );
+// count of changes seen in watched directories; a cert file can only have changed if this changed
+unsigned long rdkcertcfg_certSeq( void );
+
+// metadata of a cert file, from the cert metadata cache
+typedef struct rdkcertcfgCertMeta_s {
+  int found;                   // 1(true) if the file exists, id is only valid if found
+  rdkcertcfgFileId_t id;
+} rdkcertcfgCertMeta_t;
+
+// get the metadata of a cert file named in the config file of cfg, from the process wide cache keyed by path
+// if cfg is watched, an entry is reused without a syscall while its directory is watched and no change was seen
+// there, see rdkcertcfg_certSeq; any entry is reused for the ttl set with rdkcertcfg_setMetaTtl
+// otherwise the file is stat'ed; cfg may be NULL
+// returns certcfgOk, certcfgFileNotFound if the file is missing (meta->found is 0)
+rdkcertcfgStatus_t rdkcertcfg_certMeta( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgCertMeta_t *meta );
+// get a 64 bit hash of the content of a cert file, and the metadata of the file as it was hashed
+// the hash is cached with the metadata, the file is only read again when its metadata changes
+// returns certcfgOk, certcfgFileNotFound if the file is missing, certcfgFileError if it can't be read
+rdkcertcfgStatus_t rdkcertcfg_certHash( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgCertMeta_t *meta, uint64_t *hash );
+// in memory copy of a cert file, reference counted; data is not null terminated
+typedef struct rdkcertcfgBlob_s {
+  unsigned int refCnt;
+  rdkcertcfgFileId_t id;       // metadata of the file as read
+  size_t len;
+  unsigned char data[];
+} rdkcertcfgBlob_t;
+
+#define CERTCFG_BLOB_MAX (1024*1024)  // larger cert files are not copied
+
+// get the content of a cert file, from a copy cached with the metadata; the file is only read again when
+// its metadata changes; the blob is released with rdkcertcfg_releaseBlob
+// returns certcfgOk, certcfgFileNotFound if the file is missing, certcfgFileError if it can't be read or is too large
+rdkcertcfgStatus_t rdkcertcfg_certBlob( const rdkcertcfg_t *cfg, const char *file, rdkcertcfgBlob_t **blob );
+// release a blob from rdkcertcfg_certBlob, and set the pointer to NULL
+void rdkcertcfg_releaseBlob( rdkcertcfgBlob_t **blob );
+// check if two file identities are the same; 1(true) or 0(false)
+int rdkcertcfg_sameId( const rdkcertcfgFileId_t *id1, const rdkcertcfgFileId_t *id2 );
+// set how long, in milliseconds, cert metadata of a file in an unwatched directory is reused; 0, the default, never
+void rdkcertcfg_setMetaTtl( unsigned int ttlMs );
+
+// passcode cache, process wide, keyed by credential reference; opt in with rdkcertcfg_setPassTtl
+// entries are kept in locked memory left out of core dumps, and wiped when they expire, when purged,
+// when no handle holds the credential reference any more, see rdkcertcfg_passHold,
+// and when the last config entry is detached, i.e. the last selector or locator handle is freed
+#define CERTCFG_PASS_MAX 32     // credential references cached, the oldest entry is replaced
+#define CERTCFG_PASS_LEN 128    // longest credential reference and passcode cached, with the terminator
+// set how long, in milliseconds, a passcode is reused; 0, the default, disables the cache and wipes it
+// returns certcfgOk, certcfgGeneralFailure if the memory can't be locked; the cache is then disabled
+rdkcertcfgStatus_t rdkcertcfg_setPassTtl( unsigned int ttlMs );
+// copy the cached passcode of a credential reference into pass, null terminated
+// returns certcfgOk, certcfgFileNotFound if not cached, expired or the cache is disabled
+rdkcertcfgStatus_t rdkcertcfg_passGet( const char *credRef, char *pass, size_t passsz );
+// cache the passcode of a credential reference; ignored if the cache is disabled or either is too long
+void rdkcertcfg_passPut( const char *credRef, const char *pass );
+// check if the passcode cache is enabled; 1(true) or 0(false)
+int rdkcertcfg_passEnabled( void );
+// check if the passcode of a credential reference is cached and not expired, without counting a hit or miss; 1(true) or 0(false)
+int rdkcertcfg_passCached( const char *credRef );
+// wipe the passcode of a credential reference, or all passcodes if credRef is NULL
+void rdkcertcfg_passPurge( const char *credRef );
+// credential references a handle uses through the passcode cache, owned by the handle, zeroed to start
+// an open addressing hash set of the process wide hold entries, keyed by credential reference hash
+typedef struct rdkcertcfgPassHolds_s {
+  struct certcfg_hold_s **slots;  // NULL if empty
+  size_t slotCnt;                 // power of 2
+  size_t cnt;
+} rdkcertcfgPassHolds_t;
+// hold a credential reference for a handle, once per handle; nothing is held while the cache is disabled
+// not thread safe for the same holds
+void rdkcertcfg_passHold( rdkcertcfgPassHolds_t *holds, const char *credRef );
+// drop the holds of a handle, when it is freed; the passcode of a credential reference no other handle holds is wiped
+void rdkcertcfg_passRelease( rdkcertcfgPassHolds_t *holds );
+
+// file syscalls made by the cache and the libraries on the lookup paths, and cert metadata cache use
+typedef struct rdkcertcfgCounters_s {
+  unsigned long statCalls;     // stat and fstat
+  unsigned long openCalls;     // open and fopen, each followed by reads and a close
+  unsigned long metaHits;      // cert metadata reused from the cache
+  unsigned long metaMisses;    // cert metadata read from the file
+  unsigned long hashReads;     // cert files read to hash their content
+  unsigned long blobReads;     // cert files read to copy their content
+  unsigned long passHits;      // passcodes answered from the passcode cache
+  unsigned long passMisses;    // passcodes not in the cache while it is enabled
+} rdkcertcfgCounters_t;
+
+// copy the counters, totals since the process started
+void rdkcertcfg_getCounters( rdkcertcfgCounters_t *counters );
+
+// offline compiler, certselc.c
+// compile a text config file to a compiled config file, written atomically; returns certcfgOk on success
+rdkcertcfgStatus_t rdkcertcfg_compile( const char *path, const char *binpath );
+// validate a compiled config file and, if path is not NULL, check it matches the text config file
+rdkcertcfgStatus_t rdkcertcfg_verify( const char *binpath, const char *path );
+
+// copy the hrot engine from the hrot properties file into engine, truncating to enginesz-1
+// engine is empty if no engine tag is found
+// returns certcfgOk, certcfgFileNotFound if the file is missing
+rdkcertcfgStatus_t rdkcertcfg_getEngine( rdkcertcfg_t *cfg, char *engine, size_t enginesz );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RDKCERTCFG__
@@ -55,6 +55,11 @@
 #else
 #include "rdkconfig.h"
 #endif
+#include "rdkcertcfg.h"
+// rdkconfig_getInto and rdkconfig_getMany are missing from older rdkconfig libraries, rdkconfig_getStr is used then
+#pragma weak rdkconfig_getInto
+#pragma weak rdkconfig_getMany
+#pragma weak rdkconfig_freeMany
 
 
 // cert locator object
@@ -65,11 +70,13 @@ typedef struct rdkcertlocator_s {
   char certCredRef[PARAM_MAX+1];
   char certPass[PARAM_MAX+1];
   char hrotEngine[ENGINE_MAX+1];
+  rdkcertcfg_t *certCfg;         // shared config file entry, attached on first locate
+  rdkcertcfgSnap_t *certSnap;    // config image last used
+  rdkcertcfg_t *hrotCfg;         // shared hrot properties file entry
+  rdkcertcfgPassHolds_t passHolds;  // credential references used, their passcodes are wiped with the last holder
   long reserved1;
 } rdkcertlocator_t;
 
-#define MAX_LINE_LENGTH 1024
-
 #define CHK_RESERVED1 (0x12345678)
 
 // default locations for config and properties files
@@ -81,9 +88,16 @@ typedef struct rdkcertlocator_s {
 #define DEFAULT_HROTPROP_PATH RT "/etc/ssl/certsel/hrot.properties"
 #endif
 
-#define ENGINETAG "hrotengine="
 
 static rdkcertlocatorStatus_t certloc_locateCert( rdkcertlocator_h thiscertloc, const char *certRef );
+static rdkcertlocatorStatus_t certloc_refresh( rdkcertlocator_h thiscertloc );
+static rdkcertlocatorStatus_t certloc_findCert( rdkcertcfgSnap_t *snap, const char *certRef,
+                                                char *certUri, size_t urimax, char *certCredRef, size_t credmax );
+static rdkcertlocatorStatus_t certloc_certExists( rdkcertlocator_h thiscertloc, const char *certUri );
+static rdkcertlocatorStatus_t certloc_getPass( const char *certCredRef, char *certPass, size_t passsz );
+static rdkcertlocatorStatus_t certloc_fetchPass( const char *certCredRef, char *certPass, size_t passsz );
+static rdkcertlocatorStatus_t certloc_setPass( const char *certCredRef, const uint8_t *pc, size_t pclen, char *certPass, size_t passsz );
+static void certloc_fetchPasses( rdkcertlocatorResult_t *results, const size_t *fetchIndx, size_t fetchCnt );
 static void memwipe( volatile void *mem, size_t sz );
 static int includesChar( const char *str, char ch1 );
 
@@ -129,48 +143,22 @@ rdkcertlocator_h rdkcertlocator_new(const char *certsel_path, const char *hrotpr
   // hardware root of trust properties file path from argument or use default
   if ( hrotprop_path == DEFAULT_HROT ) hrotprop_path = DEFAULT_HROTPROP_PATH;
 
-  // open config file and look for cert group in first column
   thiscertloc->certUri[0] = '\0';
   thiscertloc->certCredRef[0] = '\0';
   thiscertloc->certPass[0] = '\0';
   thiscertloc->hrotEngine[0] = '\0';
-
-  // get engine from hrot properties
-  // grab the hrot engine
-  char hrotline[MAX_LINE_LENGTH + 2];
-  hrotline[MAX_LINE_LENGTH + 1]='1';
-
-  FILE *hrotfp = fopen( hrotprop_path, "r" );
-  if ( hrotfp == NULL) {
+  thiscertloc->certCfg = NULL;
+  thiscertloc->certSnap = NULL;
+  memset( &thiscertloc->passHolds, 0, sizeof(thiscertloc->passHolds) );
+
+  // get engine from hrot properties, shared with other handles using the same file
+  // if no file, then no engine expected
+  thiscertloc->hrotCfg = rdkcertcfg_attach( hrotprop_path );
+  if ( rdkcertcfg_getEngine( thiscertloc->hrotCfg, thiscertloc->hrotEngine, sizeof(thiscertloc->hrotEngine) ) == certcfgFileNotFound ) {
     DEBUG_LOG( " %s:hrot file not found [%s]\n", __FUNCTION__, hrotprop_path );
-    // if no file, then no engine expected
   } else {
-
-    // find the hrot tag, should probably be on the first line, but can be later
-    while ( fgets( hrotline, sizeof(hrotline), hrotfp ) ) {
-
-      // check if line from file was truncated
-      if ( hrotline[MAX_LINE_LENGTH + 1] != '1' ) {
-        ERROR_LOG( " %s: hrot line too long\n", __FUNCTION__ );
-        continue;
-      } else {
-
-        // remove terminal newline
-        char *nl = strchr( hrotline, '\n' );
-        if ( nl != NULL ) *nl = '\0';
-
-        // compare first part of line for engine tag
-        if ( strncmp( hrotline, ENGINETAG, sizeof(ENGINETAG)-1 ) == 0 ) {
-          strncpy( thiscertloc->hrotEngine, (hrotline+sizeof(ENGINETAG)-1), sizeof(thiscertloc->hrotEngine) );
-          thiscertloc->hrotEngine[ENGINE_MAX] = '\0'; // terminate if necessary to truncate
-          EXTRA_DEBUG_LOG( " %s:hroteng[%s], hrotpath[%s]\n", __FUNCTION__, thiscertloc->hrotEngine, hrotprop_path );
-          break;
-        }
-      } // end else line read ok
-    } // end while
-
-    fclose( hrotfp );
-  } // end else
+    EXTRA_DEBUG_LOG( " %s:hroteng[%s], hrotpath[%s]\n", __FUNCTION__, thiscertloc->hrotEngine, hrotprop_path );
+  }
 
   return thiscertloc;
 } // rdkcertlocator_new( )
@@ -186,6 +174,10 @@ void rdkcertlocator_free( rdkcertlocator_h *thiscertloc ) {
     }
     memwipe( (*thiscertloc)->certPass, sizeof( (*thiscertloc)->certPass ) );
     memwipe( (*thiscertloc)->certCredRef, sizeof( (*thiscertloc)->certCredRef ) );
+    rdkcertcfg_passRelease( &(*thiscertloc)->passHolds );
+    rdkcertcfg_release( &(*thiscertloc)->certSnap );
+    rdkcertcfg_detach( &(*thiscertloc)->certCfg );
+    rdkcertcfg_detach( &(*thiscertloc)->hrotCfg );
     (*thiscertloc)->reserved1 = 0;
     free( *thiscertloc );
     *thiscertloc = NULL;
@@ -207,6 +199,11 @@ char *rdkcertlocator_getEngine( rdkcertlocator_h thiscertloc ) {
     return NULL;
   }
 
+  // with auto reload, the engine may have changed; it is kept up to date by the watcher
+  if ( rdkcertcfg_watching( thiscertloc->hrotCfg ) ) {
+    rdkcertcfg_getEngine( thiscertloc->hrotCfg, thiscertloc->hrotEngine, sizeof(thiscertloc->hrotEngine) );
+  }
+
   // use engine we already have or NULL if empty
   if ( thiscertloc->hrotEngine[0] != '\0' ) {
     hroteng = thiscertloc->hrotEngine;
@@ -217,6 +214,78 @@ char *rdkcertlocator_getEngine( rdkcertlocator_h thiscertloc ) {
 
 } // rdkcertlocator_getEngine( )
 
+/**
+ *  Enables automatic reload of the config file and hrot properties file of a cert locator.
+ *  The files, and the directories of the certs named in the config file, are watched with inotify.
+ *  Changes are loaded by a background thread, so locateCert no longer checks the config file on each call.
+ *  Applies to every handle in the process using the same files; stays enabled until they are all freed.
+ *  In @param thiscertloc; cert locator handle.
+ *  @return 0/certlocatorOk for success, non-zero values for the failure; files are then checked on each call.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_enableAutoReload( rdkcertlocator_h thiscertloc ) {
+  if ( thiscertloc == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certlocatorBadPointer;
+  }
+
+  // the config entry is attached when the config file is first used
+  rdkcertlocatorStatus_t retval = certloc_refresh( thiscertloc );
+  if ( retval != certlocatorOk ) {
+    ERROR_LOG( " %s:config file not loaded (%u)\n", __FUNCTION__, retval );
+    return retval;
+  }
+  if ( rdkcertcfg_watch( thiscertloc->certCfg ) != certcfgOk ) {
+    return certlocatorGeneralFailure;
+  }
+  // the hrot properties file is optional; if it can't be watched, the engine read at startup is kept
+  rdkcertcfg_watch( thiscertloc->hrotCfg );
+  return certlocatorOk;
+} // rdkcertlocator_enableAutoReload( )
+
+/**
+ *  Sets how long cert file metadata may be reused before the cert file is checked again.
+ *  In @param ttl_ms; time to reuse metadata in milliseconds, 0 checks the file on every use.
+**/
+void rdkcertlocator_setCertMetaTtl( unsigned int ttl_ms ) {
+  rdkcertcfg_setMetaTtl( ttl_ms );
+} // rdkcertlocator_setCertMetaTtl( )
+
+/**
+ *  Sets how long a passcode may be reused before it is fetched from rdkconfig again.
+ *  In @param ttl_ms; time to reuse a passcode in milliseconds, 0 disables the cache and wipes it.
+ *  @return 0/certlocatorOk for success, certlocatorGeneralFailure if the memory can't be locked.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_setPassCacheTtl( unsigned int ttl_ms ) {
+  return (rdkcertlocatorStatus_t)rdkcertcfg_setPassTtl( ttl_ms );
+} // rdkcertlocator_setPassCacheTtl( )
+
+/**
+ *  Wipes the cached passcodes.
+**/
+void rdkcertlocator_purgePassCache( void ) {
+  rdkcertcfg_passPurge( NULL );
+} // rdkcertlocator_purgePassCache( )
+
+/**
+ *  Gets the file syscall and cert metadata cache counters.
+ *  Out @param counters; counters.
+**/
+void rdkcertlocator_getCounters( rdkcertlocatorCounters_t *counters ) {
+  if ( counters == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return;
+  }
+  rdkcertcfgCounters_t cfgCounters;
+  rdkcertcfg_getCounters( &cfgCounters );
+  counters->statCalls = cfgCounters.statCalls;
+  counters->openCalls = cfgCounters.openCalls;
+  counters->metaHits = cfgCounters.metaHits;
+  counters->metaMisses = cfgCounters.metaMisses;
+  counters->hashReads = cfgCounters.hashReads;
+  counters->passHits = cfgCounters.passHits;
+  counters->passMisses = cfgCounters.passMisses;
+} // rdkcertlocator_getCounters( )
+
 
 // to convert Uri to file path, skip past the "file://" scheme
 // the scheme expects 3 slashes, but the third one is the root of the file path
@@ -258,49 +327,14 @@ rdkcertlocatorStatus_t rdkcertlocator_locateCert( rdkcertlocator_h thiscertloc,
 
   if ( retval == certlocatorOk ) {
     // if cert file does not exist, return file error
-
-    char *certFile = thiscertloc->certUri;
-    // strip off uri scheme "file://"
-    if ( strncmp( certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
-      certFile += (sizeof(FILESCHEME)-1);
-    }
-
-    // does file exist
-    struct stat fileStat;
-    int statret = stat( certFile, &fileStat );
-
-    if ( statret != 0 ) {  // file error
-      DEBUG_LOG( " %s:cert file not found [%s]\n", __FUNCTION__, certFile );
-      retval = certlocatorFileNotFound;
-    }
+    retval = certloc_certExists( thiscertloc, thiscertloc->certUri );
   }
 
   if ( retval == certlocatorOk ) {
     EXTRA_DEBUG_LOG( " %s:get passcode (%u)\n", __FUNCTION__, retval );
     // file exists and is not the same as bad (or was not marked as bad), so get the passcode and return them
-    char *pc = NULL;
-    size_t pcsz = 0;
-    retval = certlocatorFileError; // look for cred file, error out if not found
-    if ( rdkconfig_getStr( &pc, &pcsz, thiscertloc->certCredRef ) == RDKCONFIG_OK ) {
-      if ( pc != NULL ) {
-        // don't include any newline at end and don't add an additional null terminator
-        if ( pc[pcsz-2] == '\n' ) {
-          pc[pcsz-2] = '\0';
-          --pcsz;
-        }
-
-        if ( pcsz < (sizeof(thiscertloc->certPass)-1) ) {
-          memcpy( thiscertloc->certPass, pc, pcsz );
-          thiscertloc->certPass[pcsz] = '\0'; // data coming in does not assume string so need to null terminate
-          rdkconfig_freeStr( &pc, pcsz );
-          retval = certlocatorOk; // found it
-          EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
-        } else {
-          ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pcsz );
-          rdkconfig_freeStr( &pc, pcsz );
-        }
-      } // pc not null
-    } // rdkconfig_getStr ok
+    rdkcertcfg_passHold( &thiscertloc->passHolds, thiscertloc->certCredRef );
+    retval = certloc_getPass( thiscertloc->certCredRef, thiscertloc->certPass, sizeof(thiscertloc->certPass) );
   } else {
     DEBUG_LOG( " %s:cert reference [%s] not found (%u)\n", __FUNCTION__, certRef, retval );
     return retval;
@@ -319,18 +353,152 @@ rdkcertlocatorStatus_t rdkcertlocator_locateCert( rdkcertlocator_h thiscertloc,
   return retval;
 } // rdkcertlocator_locateCert( )
 
+/**
+ *  API for locating a set of certs in one call, such as all the cert references a device uses.
+ *  The config file is checked once and every reference is looked up in the same image of it;
+ *  each distinct credential reference is fetched once and shared by the references that use it,
+ *  and the credentials not in the passcode cache are fetched together in one rdkconfig call.
+ *  In @param thiscertloc; cert locator handle.
+ *  In @param certRefs; array of refCnt cert references.
+ *  In @param refCnt; number of cert references.
+ *  Out @param results; array of refCnt results, one per cert reference, in the same order.
+ *         certPass of each result must be wiped with rdkcertlocator_wipeResults after use.
+ *  @return 0/certlocatorOk if every cert was located, otherwise the status of the first one that was not.
+**/
+rdkcertlocatorStatus_t rdkcertlocator_locateCerts( rdkcertlocator_h thiscertloc, const char **certRefs, size_t refCnt,
+                                                   rdkcertlocatorResult_t *results ) {
+  if ( thiscertloc == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certlocatorBadPointer;
+  }
+  if ( refCnt > 0 && ( certRefs == NULL || results == NULL ) ) {
+    ERROR_LOG( " %s:null argument(s)\n", __FUNCTION__ );
+    return certlocatorBadArgument;
+  }
+
+  size_t refIndx, prevIndx;
+  for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+    memwipe( &results[refIndx], sizeof(results[refIndx]) );
+  }
+
+  // one check of the config file for the whole set
+  rdkcertlocatorStatus_t retval = certloc_refresh( thiscertloc );
+  if ( retval != certlocatorOk ) {
+    for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+      results[refIndx].status = retval;
+    }
+    return retval;
+  }
+  rdkcertcfgSnap_t *snap = thiscertloc->certSnap;
+
+  // passFrom is the result holding the passcode of each located result,
+  // fetchIndx the results whose passcodes are fetched after the lookups
+  size_t *passFrom = (size_t *)calloc( refCnt * 2, sizeof(size_t) );
+  if ( passFrom == NULL ) {
+    ERROR_LOG( " %s:no memory\n", __FUNCTION__ );
+    for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+      results[refIndx].status = certlocatorGeneralFailure;
+    }
+    return ( refCnt > 0 ) ? certlocatorGeneralFailure : certlocatorOk;
+  }
+  size_t *fetchIndx = passFrom + refCnt;
+  size_t fetchCnt = 0;
+
+  for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+    rdkcertlocatorResult_t *result = &results[refIndx];
+    const char *certRef = certRefs[refIndx];
+    if ( certRef == NULL ) {
+      ERROR_LOG( " %s:null cert reference [%zu]\n", __FUNCTION__, refIndx );
+      result->status = certlocatorBadArgument;
+    } else {
+      result->status = certloc_findCert( snap, certRef, result->certUri, sizeof(result->certUri)-1,
+                                         result->certCredRef, sizeof(result->certCredRef)-1 );
+    }
+    if ( result->status != certlocatorOk ) {
+      DEBUG_LOG( " %s:cert reference [%s] not found (%u)\n", __FUNCTION__, certRef != NULL ? certRef : "", result->status );
+      continue;
+    }
+
+    // reuse the cert file check and passcode of an earlier result for the same uri or credential
+    // a device has a handful of references, so a linear search of the earlier results is enough
+    const rdkcertlocatorResult_t *sameUri = NULL, *sameCred = NULL;
+    for ( prevIndx = 0; prevIndx < refIndx && ( sameUri == NULL || sameCred == NULL ); prevIndx++ ) {
+      const rdkcertlocatorResult_t *prev = &results[prevIndx];
+      if ( prev->status != certlocatorOk ) {
+        continue;
+      }
+      if ( sameUri == NULL && strcmp( prev->certUri, result->certUri ) == 0 ) {
+        sameUri = prev;
+      }
+      if ( sameCred == NULL && strcmp( prev->certCredRef, result->certCredRef ) == 0 ) {
+        sameCred = prev;
+      }
+    }
+
+    if ( sameUri == NULL ) {
+      result->status = certloc_certExists( thiscertloc, result->certUri );
+    }
+    if ( result->status == certlocatorOk ) {
+      if ( sameCred != NULL ) {
+        passFrom[refIndx] = sameCred - results;
+      } else {
+        passFrom[refIndx] = refIndx;
+        rdkcertcfg_passHold( &thiscertloc->passHolds, result->certCredRef );
+        if ( rdkcertcfg_passGet( result->certCredRef, result->certPass, sizeof(result->certPass) ) != certcfgOk ) {
+          fetchIndx[fetchCnt++] = refIndx;
+        }
+      }
+    }
+  }
+
+  certloc_fetchPasses( results, fetchIndx, fetchCnt );
+  for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+    rdkcertlocatorResult_t *result = &results[refIndx];
+    if ( result->status == certlocatorOk && passFrom[refIndx] != refIndx ) {
+      const rdkcertlocatorResult_t *sameCred = &results[passFrom[refIndx]];
+      result->status = sameCred->status;
+      memcpy( result->certPass, sameCred->certPass, sizeof(result->certPass) );
+    }
+    EXTRA_DEBUG_LOG( " %s:[%s] returning [%s:%s] %d\n", __FUNCTION__, certRefs[refIndx] ? certRefs[refIndx] : "",
+                     result->certUri, "****", result->status );
+  }
+  memwipe( passFrom, refCnt * 2 * sizeof(size_t) );
+  free( passFrom );
+
+  for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+    if ( results[refIndx].status != certlocatorOk ) {
+      retval = results[refIndx].status;
+      break;
+    }
+  }
+  return retval;
+} // rdkcertlocator_locateCerts( )
+
+/**
+ *  Wipe the passcodes of results returned by rdkcertlocator_locateCerts.
+ *  In @param results; array of refCnt results.
+ *  In @param refCnt; number of results.
+**/
+void rdkcertlocator_wipeResults( rdkcertlocatorResult_t *results, size_t refCnt ) {
+  if ( results != NULL ) {
+    size_t refIndx;
+    for ( refIndx = 0; refIndx < refCnt; refIndx++ ) {
+      memwipe( &results[refIndx], sizeof(results[refIndx]) );
+    }
+  }
+} // rdkcertlocator_wipeResults( )
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // INTERNAL STATIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// fix this to always wipe without getting optimized out
+// memwipe - wipe memory holding a passcode; explicit_bzero is not optimized out before a free
 static void memwipe( volatile void *mem, size_t sz ) {
-  memset( (void *)mem, 0, sz );
+  explicit_bzero( (void *)mem, sz );
 }
 
-#define DELIM_STR ","
 #define DELIM_CHAR ','
 
 // includesChars- check if a char string includes the char provided
@@ -346,129 +514,203 @@ static int includesChar( const char *str, char ch1 ) {
   return 0;
 } // includesChar( )
 
+// check the cert file of a uri exists, usually without a syscall, see rdkcertcfg_certMeta
+// returns certlocatorOk or certlocatorFileNotFound
+static rdkcertlocatorStatus_t certloc_certExists( rdkcertlocator_h thiscertloc, const char *certUri ) {
+  const char *certFile = certUri;
+  // strip off uri scheme "file://"
+  if ( strncmp( certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
+    certFile += (sizeof(FILESCHEME)-1);
+  }
 
-// locate cert based on info in the certloc instance
-// use config file path to open file, search for the cert reference in the file
-// update the certUri and certCredRef fields, which will be used by the api function
-static rdkcertlocatorStatus_t certloc_locateCert( rdkcertlocator_h thiscertloc, const char *certRef ) {
-  if ( thiscertloc == NULL ) {
-    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
-    return certlocatorBadPointer;
+  // does file exist
+  rdkcertcfgCertMeta_t certMeta;
+  if ( rdkcertcfg_certMeta( thiscertloc->certCfg, certFile, &certMeta ) != certcfgOk ) {  // file error
+    DEBUG_LOG( " %s:cert file not found [%s]\n", __FUNCTION__, certFile );
+    return certlocatorFileNotFound;
   }
-  if ( certRef == NULL ) {
-    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
-    return certlocatorBadPointer;
+  return certlocatorOk;
+} // certloc_certExists( )
+
+// get the passcode of a credential reference into certPass, null terminated
+// from the passcode cache if enabled, see rdkcertlocator_setPassCacheTtl, otherwise from rdkconfig
+// returns certlocatorOk, or certlocatorFileError if not found or it does not fit
+static rdkcertlocatorStatus_t certloc_getPass( const char *certCredRef, char *certPass, size_t passsz ) {
+  if ( rdkcertcfg_passGet( certCredRef, certPass, passsz ) == certcfgOk ) {
+    EXTRA_DEBUG_LOG( " %s:cached passcode\n", __FUNCTION__ );
+    return certlocatorOk;
   }
-  if ( includesChar( certRef, DELIM_CHAR ) == 1 ) {
-    ERROR_LOG( " %s:bad argument\n", __FUNCTION__ );
-    return certlocatorBadArgument;
+  return certloc_fetchPass( certCredRef, certPass, passsz );
+} // certloc_getPass( )
+
+// get the passcode of a credential reference from rdkconfig into certPass, null terminated,
+// and put it in the passcode cache if enabled
+// returns certlocatorOk, or certlocatorFileError if not found or it does not fit
+static rdkcertlocatorStatus_t certloc_fetchPass( const char *certCredRef, char *certPass, size_t passsz ) {
+  rdkcertlocatorStatus_t retval = certlocatorFileError; // look for cred file, error out if not found
+  if ( rdkconfig_getInto != NULL ) {
+    // decrypt straight into certPass, no heap copy of the passcode
+    size_t pclen = 0;
+    if ( rdkconfig_getInto( certCredRef, (uint8_t *)certPass, passsz-1, &pclen ) == RDKCONFIG_OK ) {
+      // don't include any newline at end
+      if ( pclen >= 1 && certPass[pclen-1] == '\n' ) {
+        --pclen;
+      }
+      certPass[pclen] = '\0'; // data coming in does not assume string so need to null terminate
+      rdkcertcfg_passPut( certCredRef, certPass );
+      retval = certlocatorOk; // found it
+      EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
+    } else if ( pclen != 0 ) {
+      ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pclen );
+    }
+    return retval;
+  }
+  // rdkconfig without rdkconfig_getInto
+  char *pc = NULL;
+  size_t pcsz = 0;
+  if ( rdkconfig_getStr( &pc, &pcsz, certCredRef ) == RDKCONFIG_OK ) {
+    if ( pc != NULL ) {
+      // don't include any newline at end and don't add an additional null terminator
+      if ( pc[pcsz-2] == '\n' ) {
+        pc[pcsz-2] = '\0';
+        --pcsz;
+      }
+
+      if ( pcsz < (passsz-1) ) {
+        memcpy( certPass, pc, pcsz );
+        certPass[pcsz] = '\0'; // data coming in does not assume string so need to null terminate
+        rdkconfig_freeStr( &pc, pcsz );
+        rdkcertcfg_passPut( certCredRef, certPass );
+        retval = certlocatorOk; // found it
+        EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
+      } else {
+        ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pcsz );
+        rdkconfig_freeStr( &pc, pcsz );
+      }
+    } // pc not null
+  } // rdkconfig_getStr ok
+  return retval;
+} // certloc_fetchPass( )
+
+// copy a passcode of pclen bytes from rdkconfig into certPass, null terminated, without a newline at the end,
+// and put it in the passcode cache if enabled
+// returns certlocatorOk, or certlocatorFileError if it does not fit
+static rdkcertlocatorStatus_t certloc_setPass( const char *certCredRef, const uint8_t *pc, size_t pclen, char *certPass, size_t passsz ) {
+  if ( pclen >= 1 && pc[pclen-1] == '\n' ) {
+    --pclen;
+  }
+  if ( pclen >= passsz ) {
+    ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pclen );
+    return certlocatorFileError;
+  }
+  memcpy( certPass, pc, pclen );
+  certPass[pclen] = '\0';
+  rdkcertcfg_passPut( certCredRef, certPass );
+  return certlocatorOk;
+} // certloc_setPass( )
+
+#define CERTLOC_FETCH_MAX 16  // credentials per rdkconfig_getMany call
+
+// fetch the passcodes of the results listed in fetchIndx from rdkconfig and set their status
+// with rdkconfig_getMany the backend is opened once per CERTLOC_FETCH_MAX credentials instead of once per credential
+static void certloc_fetchPasses( rdkcertlocatorResult_t *results, const size_t *fetchIndx, size_t fetchCnt ) {
+  size_t fetched, indx;
+  if ( fetchCnt < 2 || rdkconfig_getMany == NULL || rdkconfig_freeMany == NULL ) {
+    for ( indx = 0; indx < fetchCnt; indx++ ) {
+      rdkcertlocatorResult_t *result = &results[fetchIndx[indx]];
+      result->status = certloc_fetchPass( result->certCredRef, result->certPass, sizeof(result->certPass) );
+      if ( result->status != certlocatorOk ) {
+        ERROR_LOG( " %s:credential reference [%s] not found (%u)\n", __FUNCTION__, result->certCredRef, result->status );
+      }
+    }
+    return;
+  }
+  for ( fetched = 0; fetched < fetchCnt; fetched += CERTLOC_FETCH_MAX ) {
+    const char *refnames[CERTLOC_FETCH_MAX];
+    rdkconfig_buf_t pcs[CERTLOC_FETCH_MAX];
+    size_t chunk = ( fetchCnt - fetched < CERTLOC_FETCH_MAX ) ? fetchCnt - fetched : CERTLOC_FETCH_MAX;
+    for ( indx = 0; indx < chunk; indx++ ) {
+      refnames[indx] = results[fetchIndx[fetched+indx]].certCredRef;
+    }
+    rdkconfig_getMany( refnames, chunk, pcs ); // status of each is checked below
+    for ( indx = 0; indx < chunk; indx++ ) {
+      rdkcertlocatorResult_t *result = &results[fetchIndx[fetched+indx]];
+      result->status = certlocatorFileError;
+      if ( pcs[indx].status == RDKCONFIG_OK && pcs[indx].buf != NULL ) {
+        result->status = certloc_setPass( result->certCredRef, pcs[indx].buf, pcs[indx].len,
+                                          result->certPass, sizeof(result->certPass) );
+      }
+      if ( result->status != certlocatorOk ) {
+        ERROR_LOG( " %s:credential reference [%s] not found (%u)\n", __FUNCTION__, result->certCredRef, result->status );
+      }
+    }
+    rdkconfig_freeMany( pcs, chunk );
   }
+} // certloc_fetchPasses( )
 
-  rdkcertlocatorStatus_t retval = certlocatorGeneralFailure;
 
+// make sure the certloc instance references the current image of the config file
+// the config file is only re-parsed if it changed
+static rdkcertlocatorStatus_t certloc_refresh( rdkcertlocator_h thiscertloc ) {
   char *certSelCfg = thiscertloc->certSelPath;
   if ( certSelCfg[0] == '\0' ) {
     ERROR_LOG( " %s:argument error [%s]\n", __FUNCTION__, certSelCfg );
     return certlocatorBadArgument;
   }
 
-  FILE *cfgfp = fopen( certSelCfg, "r" );
-  if ( cfgfp == NULL) {
-    ERROR_LOG( " %s:config file, %s, not found\n", __FUNCTION__, certSelCfg );
-    return certlocatorFileNotFound;
-  }
+  rdkcertcfgStatus_t cfgstat = rdkcertcfg_refresh( &thiscertloc->certCfg, certSelCfg, &thiscertloc->certSnap );
+  return (rdkcertlocatorStatus_t)cfgstat;
+} // certloc_refresh( rdkcertlocator_h thiscertloc )
 
-  size_t reflen = strnlen( certRef, PARAM_MAX );
-
-  char cfgline[MAX_LINE_LENGTH+1];
-  char *cfgfield = NULL;
-  char *savetok1;
+// search an image of the config file for the cert reference
+// on match copy the uri and credential reference, null terminated; urimax and credmax do not include the terminator
+static rdkcertlocatorStatus_t certloc_findCert( rdkcertcfgSnap_t *snap, const char *certRef,
+                                                char *certUri, size_t urimax, char *certCredRef, size_t credmax ) {
+  if ( includesChar( certRef, DELIM_CHAR ) == 1 ) {
+    ERROR_LOG( " %s:bad argument\n", __FUNCTION__ );
+    return certlocatorBadArgument;
+  }
 
   // config file fields as follows:
   // <group>,<certref>,<type>,<uri>,<credref>
 
-  // look for certref in field 2 and then on match store fields 4 and 5
-
-  cfgline[MAX_LINE_LENGTH-1] = '\0'; // if this bytes gets overwritten, then line was too long
-
-  while ( fgets( cfgline, sizeof(cfgline), cfgfp ) ) {
-
-    // check if line from file was truncated
-    if ( cfgline[MAX_LINE_LENGTH-1] != '\0' ) {
-      ERROR_LOG( " %s: config line too long\n", __FUNCTION__ );
-      retval = certlocatorFileError;
-      break;
-    }
-
-    // remove terminal newline
-    char *nl = strchr( cfgline, '\n' );
-    if ( nl != NULL ) *nl = '\0';
-
-    // look for cert ref in second field
-    // do not allow unexpected whitespace
-
-    cfgfield = strtok_r( cfgline, DELIM_STR, &savetok1 ); // 1st field is group
-    if ( cfgfield != NULL ) {
-      cfgfield = strtok_r( NULL, DELIM_STR, &savetok1 ); // 2nd field is cert ref
-    }
-
-    if ( cfgfield != NULL && strncmp( cfgfield, certRef, reflen+1 ) == 0 ) {
-
-      // extract cert info
-
-      // skip field 3=type
-      cfgfield = strtok_r( NULL, DELIM_STR, &savetok1 ); // skip 3rd field
-
-      if ( cfgfield == NULL ) {
-        ERROR_LOG( " %s:missing field (3)\n", __FUNCTION__ );
-        retval = certlocatorFileError;
-        break;
-      }
-
-      // copy uri and cred reference fields into object
-      // an error here is probably a corruption of the config file
-      cfgfield = strtok_r( NULL, DELIM_STR, &savetok1 ); // 4th field is URI
-      if ( cfgfield != NULL ) {
-        size_t fieldlen = strlen( cfgfield );
-        if ( fieldlen < (sizeof(thiscertloc->certUri)-1) ) {
-          strcpy( thiscertloc->certUri, cfgfield );
-          cfgfield = strtok_r( NULL, DELIM_STR, &savetok1 ); // 5th field is Cred reference
-          if ( cfgfield != NULL ) {
-            fieldlen = strlen( cfgfield );
-            if ( fieldlen < (sizeof(thiscertloc->certCredRef)-1) ) {
-              strcpy( thiscertloc->certCredRef, cfgfield );
-            } else {
-              cfgfield = NULL; // 5th field error
-              thiscertloc->certUri[0] = '\0'; // 5th field failure so empty 4th
-            }
-          }
-        } else {
-          cfgfield = NULL; // 4th field error
-        }
-      }
-      // check for error
-      if ( cfgfield == NULL ) {
-        ERROR_LOG( " %s:missing fields (4/5)\n", __FUNCTION__ );
-        retval = certlocatorFileError;
-        break;
-      }
+  // look up certref (field 2) in the image index, then on match store fields 4 and 5
+  rdkcertlocatorStatus_t retval = (rdkcertlocatorStatus_t)snap->endStat;
+  const rdkcertcfgRow_t *row = rdkcertcfg_findRef( snap, certRef );
 
-      // found one and saved the cert info
-      retval = certlocatorOk;
-      break;
+  if ( row != NULL ) {
+    // extract cert info
+    // an error here is probably a corruption of the config file
+    retval = (rdkcertlocatorStatus_t)rdkcertcfg_rowCert( snap, row, certUri, urimax, certCredRef, credmax );
+  }
 
-    } // end if matches cert ref
+  if ( retval == certlocatorFileNotFound ) {
+    EXTRA_DEBUG_LOG( " %s:match not found for %s\n", __FUNCTION__, certRef );
+  }
 
-  } // end while
+  return retval;
+} // certloc_findCert( )
 
-  fclose( cfgfp );
+// locate cert based on info in the certloc instance
+// use the shared image of the config file, search for the cert reference
+// update the certUri and certCredRef fields, which will be used by the api function
+static rdkcertlocatorStatus_t certloc_locateCert( rdkcertlocator_h thiscertloc, const char *certRef ) {
+  if ( thiscertloc == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certlocatorBadPointer;
+  }
+  if ( certRef == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certlocatorBadPointer;
+  }
 
-  if ( retval == certlocatorGeneralFailure ) {
-    EXTRA_DEBUG_LOG( " %s:match not found for %s\n", __FUNCTION__, certRef );
-    retval = certlocatorFileNotFound;
+  rdkcertlocatorStatus_t retval = certloc_refresh( thiscertloc );
+  if ( retval != certlocatorOk ) {
+    return retval;
   }
 
-  return retval;
+  return certloc_findCert( thiscertloc->certSnap, certRef, thiscertloc->certUri, sizeof(thiscertloc->certUri)-1,
+                           thiscertloc->certCredRef, sizeof(thiscertloc->certCredRef)-1 );
 } // certloc_locateCert( rdkcertlocator_h thiscertloc, const char *certRef )
 
 
@@ -502,9 +744,12 @@ static rdkcertlocatorStatus_t certloc_locateCert( rdkcertlocator_h thiscertloc,
 
 // MOCKS
 
+static int ut_getStrCnt = 0;  // number of credential fetches
+
 // rdkconfig_getStr - get string credential, allocate space, fill buffer
 int rdkconfig_getStr( char **sbuff, size_t *sbuffsz, const char *refname ) { // MOCK
   int retval = RDKCONFIG_OK;
+  ut_getStrCnt++;
   char *membuff = (char *)malloc( 50 );
   if ( membuff == NULL ) {
     return RDKCONFIG_FAIL;
@@ -535,6 +780,50 @@ int rdkconfig_freeStr( char **sbuff, size_t sbuffsz ) { // MOCK
   return RDKCONFIG_OK;
 }
 
+// rdkconfig_getInto - get credential into caller buffer, same credentials as rdkconfig_getStr
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len ) { // MOCK
+  char *pc = NULL;
+  size_t pcsz = 0;
+  *len = 0;
+  if ( rdkconfig_getStr( &pc, &pcsz, refname ) != RDKCONFIG_OK ) {
+    return RDKCONFIG_FAIL;
+  }
+  *len = pcsz - 1; // without null terminator
+  int retval = ( *len <= cap ) ? RDKCONFIG_OK : RDKCONFIG_FAIL;
+  if ( retval == RDKCONFIG_OK ) {
+    memcpy( buf, pc, *len );
+  }
+  rdkconfig_freeStr( &pc, pcsz );
+  return retval;
+}
+
+static int ut_getManyCnt = 0;  // number of batch credential fetches
+
+// rdkconfig_getMany - get credentials in one call, same credentials as rdkconfig_getStr
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] ) { // MOCK
+  int retval = RDKCONFIG_OK;
+  ut_getManyCnt++;
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    char *pc = NULL;
+    size_t pcsz = 0;
+    out[indx].status = rdkconfig_getStr( &pc, &pcsz, refnames[indx] );
+    out[indx].buf = (uint8_t *)pc;
+    out[indx].len = ( pc != NULL ) ? pcsz - 1 : 0;
+    if ( out[indx].status != RDKCONFIG_OK ) {
+      out[indx].buf = NULL;
+      retval = RDKCONFIG_FAIL;
+    }
+  }
+  return retval;
+}
+
+int rdkconfig_freeMany( rdkconfig_buf_t out[], size_t n ) { // MOCK
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    rdkconfig_freeStr( (char **)&out[indx].buf, out[indx].len + 1 );
+  }
+  return RDKCONFIG_OK;
+}
+
 
 // used throughout tests
 static const char *certsel_path = CERTSEL_CFG;
@@ -871,6 +1160,49 @@ static void ut_rdkcertlocator_locateCert( void ) {
   UT_END( __FUNCTION__ );
 } // end ut_rdkcertlocator_locateCert( void )
 
+// unit tests for rdkcertlocator_locateCerts( rdkcertlocator_h thiscertloc, const char **certRefs, size_t refCnt, rdkcertlocatorResult_t *results )
+static void ut_rdkcertlocator_locateCerts( void ) {
+  UT_BEGIN( __FUNCTION__ );
+
+  const char *refs[] = { "FRST", "SCND", "NOREF", "THRD", "NOPC", "FRST", "ALPHA" };
+  rdkcertlocatorResult_t results[sizeof(refs)/sizeof(refs[0])];
+  size_t refCnt = sizeof(refs)/sizeof(refs[0]);
+
+  UT_LOG( "Expect 2 error messages for arguments" );
+  UT_INTCMP( rdkcertlocator_locateCerts( NULL, refs, refCnt, results ), certlocatorBadPointer );
+  rdkcertlocator_h tstcl1 = rdkcertlocator_new( certsel_path, DEFAULT_HROT );
+  UT_INTCMP( rdkcertlocator_locateCerts( tstcl1, NULL, refCnt, results ), certlocatorBadArgument );
+  UT_INTCMP( rdkcertlocator_locateCerts( tstcl1, refs, 0, NULL ), certlocatorOk );
+
+  UT_LOG( "Expect 1 error message for missing pc" );
+  // the second FRST reuses the first passcode
+  ut_getStrCnt = 0;
+  ut_getManyCnt = 0;
+  UT_INTCMP( rdkcertlocator_locateCerts( tstcl1, refs, refCnt, results ), certlocatorFileNotFound );
+  UT_INTCMP( ut_getStrCnt, 5 );
+  UT_INTCMP( ut_getManyCnt, 1 );  // together in one call
+  UT_INTCMP( results[0].status, certlocatorOk );
+  UT_STRCMP( results[0].certUri, "file://./ut/tst1first.tmp", PATH_MAX );
+  UT_STRCMP( results[0].certPass, "pc1pass", PARAM_MAX );
+  UT_INTCMP( results[1].status, certlocatorOk );
+  UT_STRCMP( results[1].certPass, "pc2pass", PARAM_MAX );
+  UT_INTCMP( results[2].status, certlocatorFileNotFound );
+  UT_INTCMP( results[3].status, certlocatorOk );
+  UT_STRCMP( results[3].certUri, "file://./ut/tst1third.tmp", PATH_MAX );
+  UT_STRCMP( results[3].certPass, "pc3pass", PARAM_MAX );
+  UT_INTCMP( results[4].status, certlocatorFileError );
+  UT_INTCMP( results[5].status, certlocatorOk );
+  UT_STRCMP( results[5].certPass, "pc1pass", PARAM_MAX );
+  UT_INTCMP( results[6].status, certlocatorOk );
+  UT_STRCMP( results[6].certPass, "pcalphapass", PARAM_MAX );
+
+  rdkcertlocator_wipeResults( results, refCnt );
+  UT_STRCMP( results[0].certPass, "", PARAM_MAX );
+  rdkcertlocator_free( &tstcl1 );
+
+  UT_END( __FUNCTION__ );
+} // end ut_rdkcertlocator_locateCerts( void )
+
 
 int main( int argc, char *argv[] ) {
 
@@ -883,6 +1215,7 @@ int main( int argc, char *argv[] ) {
   ut_certloc_free( );
   ut_certloc_new( );
   ut_rdkcertlocator_locateCert( );
+  ut_rdkcertlocator_locateCerts( );
   ut_rdkcertlocator_getEngine( );
 
   fprintf( stderr, "\n" );
@@ -52,6 +52,40 @@
 #include "rdkconfig.h"
 #endif
 
+#include "rdkcertcfg.h"
+// rdkconfig_getInto and rdkconfig_getMany are missing from older rdkconfig libraries, rdkconfig_getStr is used then
+#pragma weak rdkconfig_getInto
+#pragma weak rdkconfig_getMany
+#pragma weak rdkconfig_freeMany
+
+#include <pthread.h>
+#ifdef RDKCERT_VALIDATION
+#include "rdkcertval.h"
+#endif
+
+// candidate certs for the cert group, rows of the shared config image
+// rebuilt only when the config image or the cert group changes
+typedef struct certselTable_s {
+  rdkcertcfg_t *cfg;                 // shared config file entry
+  rdkcertcfg_t *hrot;                // shared hrot properties file entry
+  rdkcertcfgSnap_t *snap;            // config image the candidates point into
+  char cfgGroup[PARAM_MAX+1];
+  uint32_t candCnt;
+  rdkcertselectorStatus_t endStat;   // returned for index >= candCnt; FileNotFound, or FileError if parse stopped early
+  const uint32_t *cand;              // row indices of the candidates, the group's list in the config image
+  int validate;                      // candidates are checked before use, see rdkcertselector_enableValidation
+  int prefetch;                      // next candidate's passcode is fetched ahead, see rdkcertselector_enablePrefetch
+  rdkcertcfgBlob_t *certBlob;        // content of the cert returned by getCert, see rdkcertselector_getCertBlob
+  rdkcertcfgPassHolds_t passHolds;   // credential references of the candidates used, their passcodes are wiped with the last holder
+} certselTable_t;
+
+// fingerprint of a cert when it was marked bad; a touched cert with the same content stays bad
+typedef struct certselPrint_s {
+  unsigned long mark;                // certStat value the fingerprint was taken for
+  rdkcertcfgFileId_t id;             // size, inode and mtime of the file as hashed
+  uint64_t hash;                     // content hash, see rdkcertcfg_certHash
+} certselPrint_t;
+
 // cert selector object
 // internal states for managing the cert selector api
 typedef struct rdkcertselector_s {
@@ -61,9 +95,12 @@ typedef struct rdkcertselector_s {
   char certCredRef[PARAM_MAX+1];
   char certPass[PARAM_MAX+1];
   char hrotEngine[ENGINE_MAX+1];
-  uint16_t certIndx;
+  uint32_t certIndx;
   uint16_t state;
-  unsigned long certStat[LIST_MAX];  // 0 if ok, file date if cert found to be bad
+  uint32_t certStatCnt;              // entries in certStat, at least LIST_MAX once the table is loaded
+  unsigned long *certStat;           // per candidate, 0 if ok, file date if cert found to be bad
+  certselPrint_t *certPrint;         // per candidate, fingerprint of the cert when marked bad
+  certselTable_t *certTable;         // candidate certs, NULL until first lookup
   long reserved1;
 } rdkcertselector_t;
 
@@ -75,8 +112,6 @@ typedef enum {
     cssNoCert=203,
 } certselState_t;
 
-#define MAX_LINE_LENGTH 1024
-
 #define CHK_RESERVED1 (0x12345678)
 #define CERTSTAT_NOTBAD 0          // NOTBAD means either ok, missing, or unknown
 
@@ -89,21 +124,32 @@ typedef enum {
 #define DEFAULT_HROTPROP_PATH RT "/etc/ssl/certsel/hrot.properties"
 #endif
 
-#define ENGINETAG "hrotengine="
-#define DELIM_STR ","
 #define DELIM_CHAR ','
-#define GRPDELIM_STR "|"
 #define GRPDELIM_CHAR '|'
 
 #define CURLERR_LOCALCERT 58
 #define CURLERR_NONCERT 1
 
 static rdkcertselectorStatus_t certsel_findCert( rdkcertselector_h thiscertsel );
+static rdkcertselectorStatus_t certsel_loadTable( rdkcertselector_h thiscertsel );
+static void certsel_freeTable( rdkcertselector_h thiscertsel );
 static rdkcertselectorStatus_t certsel_findNextCert( rdkcertselector_h thiscertsel );
+static int certsel_certChanged( rdkcertselector_h thiscertsel, uint32_t certIndx, const char *certFile, rdkcertcfgCertMeta_t *certMeta );
+static void certsel_markBad( rdkcertselector_h thiscertsel, uint32_t certIndx, const char *certFile );
+static rdkcertselectorStatus_t certsel_getPass( rdkcertselector_h thiscertsel, const char *certCredRef, char *certPass, size_t passsz );
+static rdkcertselectorStatus_t certsel_fetchPass( const char *certCredRef, char *certPass, size_t passsz );
+static rdkcertselectorStatus_t certsel_setPass( const char *certCredRef, const uint8_t *pc, size_t pclen, char *certPass, size_t passsz );
+static int certsel_startWorker( void );
+static int certsel_queueJob( certselTable_t *table, uint32_t candIndx, int validate );
+#ifdef RDKCERT_VALIDATION
+static void certsel_queueValidation( rdkcertselector_h thiscertsel );
+#endif
+static void certsel_queuePrefetch( rdkcertselector_h thiscertsel, uint32_t candIndx );
 static void memwipe( volatile void *mem, size_t sz );
 static int includesChars( const char *str, char ch1, char ch2 );
 static rdkcertselectorRetry_t certsel_chkCertError( int curlStat );
-static unsigned long filetime( const char *fname );
+
+static unsigned long certsel_prefetches = 0;   // passcodes fetched ahead, see rdkcertselector_enablePrefetch
 
 /**
  * Constructs an instance of the rdkcertselector_t
@@ -167,52 +213,30 @@ rdkcertselector_h rdkcertselector_new(const char *certsel_path, const char *hrot
   thiscertsel->certCredRef[0] = '\0';
   thiscertsel->certPass[0] = '\0';
   thiscertsel->hrotEngine[0] = '\0';
-  memset( thiscertsel->certStat, 0, sizeof(thiscertsel->certStat) );
+  thiscertsel->certStatCnt = 0;
+  thiscertsel->certStat = NULL;  // sized to the cert group when the table is loaded
+  thiscertsel->certPrint = NULL;
+  thiscertsel->certTable = NULL;
 
   // first look for a cert belonging to cert group, if not found then fail
+  // this also attaches to the shared config image, parsing the config file if no other handle has
   rdkcertselectorStatus_t certstat = certsel_findCert( thiscertsel );
 
   if ( certstat != certselectorOk ) {
     ERROR_LOG( " %s:cert not found for %s\n", __FUNCTION__, cert_group );
+    certsel_freeTable( thiscertsel );
     free( thiscertsel );
     return NULL;
   }
 
-  // get engine from hrot properties
-  // grab the hrot engine
-  char hrotline[MAX_LINE_LENGTH + 2]; // one extra to check for trunctation
-  hrotline[MAX_LINE_LENGTH + 1]='1';
-  FILE *hrotfp = fopen( hrotprop_path, "r" );
-  if ( hrotfp == NULL) {
+  // get engine from hrot properties, shared with other handles using the same file
+  // if no file, then no engine expected
+  thiscertsel->certTable->hrot = rdkcertcfg_attach( hrotprop_path );
+  if ( rdkcertcfg_getEngine( thiscertsel->certTable->hrot, thiscertsel->hrotEngine, sizeof(thiscertsel->hrotEngine) ) == certcfgFileNotFound ) {
     ERROR_LOG( " %s:hrot file, %s, not found\n", __FUNCTION__, hrotprop_path );
-    // if no file, then no engine expected
   } else {
-
-    // find the hrot tag, should probably be on the first line
-    while ( fgets( hrotline, sizeof(hrotline), hrotfp ) ) {
-
-      // check if line from file was truncated
-      if ( hrotline[MAX_LINE_LENGTH + 1] != '1' ) {
-        ERROR_LOG( " %s: hrot line too long\n", __FUNCTION__ );
-        continue;
-      } else {
-
-        // remove terminal newline
-        char *nl = strchr( hrotline, '\n' );
-        if ( nl != NULL ) *nl = '\0';
-
-        // compare first part of line for engine tag
-        if ( strncmp( hrotline, ENGINETAG, sizeof(ENGINETAG)-1 ) == 0 ) {
-          strncpy( thiscertsel->hrotEngine, (hrotline+sizeof(ENGINETAG)-1), sizeof(thiscertsel->hrotEngine)-1 );
-          thiscertsel->hrotEngine[ENGINE_MAX] = '\0'; // terminate if necessary to truncate
-          EXTRA_DEBUG_LOG( " %s:hroteng[%s], hrotpath[%s]\n", __FUNCTION__, thiscertsel->hrotEngine, hrotprop_path );
-          break;
-        }
-      } // end else line read ok
-    } // end while
-
-    fclose( hrotfp );
-  } // end else
+    EXTRA_DEBUG_LOG( " %s:hroteng[%s], hrotpath[%s]\n", __FUNCTION__, thiscertsel->hrotEngine, hrotprop_path );
+  }
 
   thiscertsel->state = cssReadyToGiveCert;
   return thiscertsel;
@@ -229,6 +253,7 @@ void rdkcertselector_free( rdkcertselector_h *thiscertsel ) {
     }
     memwipe( (*thiscertsel)->certPass, sizeof( (*thiscertsel)->certPass ) );
     memwipe( (*thiscertsel)->certCredRef, sizeof( (*thiscertsel)->certCredRef ) );
+    certsel_freeTable( *thiscertsel );
     (*thiscertsel)->reserved1 = 0;
     free( *thiscertsel );
     *thiscertsel = NULL;
@@ -250,6 +275,11 @@ char *rdkcertselector_getEngine( rdkcertselector_h thiscertsel ) {
     return NULL;
   }
 
+  // with auto reload, the engine may have changed; it is kept up to date by the watcher
+  if ( thiscertsel->certTable != NULL && rdkcertcfg_watching( thiscertsel->certTable->hrot ) ) {
+    rdkcertcfg_getEngine( thiscertsel->certTable->hrot, thiscertsel->hrotEngine, sizeof(thiscertsel->hrotEngine) );
+  }
+
   // use engine we already have or NULL if empty
   if ( thiscertsel->hrotEngine[0] != '\0' ) {
     hroteng = thiscertsel->hrotEngine;
@@ -260,6 +290,145 @@ char *rdkcertselector_getEngine( rdkcertselector_h thiscertsel ) {
 
 } // rdkcertselector_getEngine( )
 
+/**
+ *  Enables automatic reload of the config file and hrot properties file of a cert selector.
+ *  The files, and the directories of the certs named in the config file, are watched with inotify.
+ *  Changes are loaded by a background thread, so getCert no longer checks the files on each call.
+ *  Applies to every handle in the process using the same files; stays enabled until they are all freed.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure; files are then checked on each call.
+**/
+rdkcertselectorStatus_t rdkcertselector_enableAutoReload( rdkcertselector_h thiscertsel ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+
+  // the config entry is attached when the table is first loaded
+  rdkcertselectorStatus_t retval = certsel_loadTable( thiscertsel );
+  if ( retval != certselectorOk ) {
+    ERROR_LOG( " %s:config file not loaded (%u)\n", __FUNCTION__, retval );
+    return retval;
+  }
+  certselTable_t *table = thiscertsel->certTable;
+  if ( rdkcertcfg_watch( table->cfg ) != certcfgOk ) {
+    return certselectorGeneralFailure;
+  }
+  // the hrot properties file is optional; if it can't be watched, the engine read at startup is kept
+  rdkcertcfg_watch( table->hrot );
+  return certselectorOk;
+} // rdkcertselector_enableAutoReload( )
+
+/**
+ *  Enables checking of the certs of a cert selector before they are returned by getCert.
+ *  Certs that are corrupt, can't be opened with their passcode, have a key not matching the cert,
+ *  are expired or not yet valid are skipped. The certs of the cert group are checked ahead by a background thread.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure, e.g. if not built with openssl.
+**/
+rdkcertselectorStatus_t rdkcertselector_enableValidation( rdkcertselector_h thiscertsel ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+#ifdef RDKCERT_VALIDATION
+  rdkcertselectorStatus_t retval = certsel_loadTable( thiscertsel );
+  if ( retval != certselectorOk ) {
+    ERROR_LOG( " %s:config file not loaded (%u)\n", __FUNCTION__, retval );
+    return retval;
+  }
+  thiscertsel->certTable->validate = 1;
+  certsel_queueValidation( thiscertsel );
+  return certselectorOk;
+#else
+  ERROR_LOG( " %s:cert validation not supported\n", __FUNCTION__ );
+  return certselectorGeneralFailure;
+#endif
+} // rdkcertselector_enableValidation( )
+
+/**
+ *  Enables fetching the passcode of the next candidate cert while the caller connects with the current one.
+ *  The passcode is held in the passcode cache, which must be enabled.
+ *  In @param thiscertsel; cert selector handle.
+ *  @return 0/certselectorOk for success, certselectorGeneralFailure if the passcode cache is not enabled.
+**/
+rdkcertselectorStatus_t rdkcertselector_enablePrefetch( rdkcertselector_h thiscertsel ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+  if ( !rdkcertcfg_passEnabled() ) {
+    ERROR_LOG( " %s:passcode cache not enabled\n", __FUNCTION__ );
+    return certselectorGeneralFailure;
+  }
+  rdkcertselectorStatus_t retval = certsel_loadTable( thiscertsel );
+  if ( retval != certselectorOk ) {
+    ERROR_LOG( " %s:config file not loaded (%u)\n", __FUNCTION__, retval );
+    return retval;
+  }
+  thiscertsel->certTable->prefetch = 1;
+  // the cert the next getCert hands out
+  certsel_queuePrefetch( thiscertsel, thiscertsel->certIndx );
+  return certselectorOk;
+} // rdkcertselector_enablePrefetch( )
+
+/**
+ *  Sets how long cert file metadata may be reused before the cert file is checked again.
+ *  In @param ttl_ms; time to reuse metadata in milliseconds, 0 checks the file on every use.
+**/
+void rdkcertselector_setCertMetaTtl( unsigned int ttl_ms ) {
+  rdkcertcfg_setMetaTtl( ttl_ms );
+} // rdkcertselector_setCertMetaTtl( )
+
+/**
+ *  Sets how long a passcode may be reused before it is fetched from rdkconfig again.
+ *  In @param ttl_ms; time to reuse a passcode in milliseconds, 0 disables the cache and wipes it.
+ *  @return 0/certselectorOk for success, certselectorGeneralFailure if the memory can't be locked.
+**/
+rdkcertselectorStatus_t rdkcertselector_setPassCacheTtl( unsigned int ttl_ms ) {
+  return (rdkcertselectorStatus_t)rdkcertcfg_setPassTtl( ttl_ms );
+} // rdkcertselector_setPassCacheTtl( )
+
+/**
+ *  Wipes the cached passcodes.
+**/
+void rdkcertselector_purgePassCache( void ) {
+  rdkcertcfg_passPurge( NULL );
+} // rdkcertselector_purgePassCache( )
+
+/**
+ *  Gets the file syscall and cert metadata cache counters.
+ *  Out @param counters; counters.
+**/
+void rdkcertselector_getCounters( rdkcertselectorCounters_t *counters ) {
+  if ( counters == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return;
+  }
+  rdkcertcfgCounters_t cfgCounters;
+  rdkcertcfg_getCounters( &cfgCounters );
+  counters->statCalls = cfgCounters.statCalls;
+  counters->openCalls = cfgCounters.openCalls;
+  counters->metaHits = cfgCounters.metaHits;
+  counters->metaMisses = cfgCounters.metaMisses;
+  counters->hashReads = cfgCounters.hashReads;
+  counters->blobReads = cfgCounters.blobReads;
+  counters->passHits = cfgCounters.passHits;
+  counters->passMisses = cfgCounters.passMisses;
+  counters->passPrefetches = __atomic_load_n( &certsel_prefetches, __ATOMIC_RELAXED );
+#ifdef RDKCERT_VALIDATION
+  rdkcertvalCounters_t valCounters;
+  rdkcertval_getCounters( &valCounters );
+  counters->certChecks = valCounters.checks;
+  counters->certParses = valCounters.parses;
+  counters->certRejects = valCounters.rejects;
+#else
+  counters->certChecks = 0;
+  counters->certParses = 0;
+  counters->certRejects = 0;
+#endif
+} // rdkcertselector_getCounters( )
+
 
 // to convert Uri to file path, skip past the "file://" scheme
 // the scheme expects 3 slashes, but the third one is the root of the file path
@@ -304,6 +473,10 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
   char *thisCertUri = thiscertsel->certUri;
   char *thisCertCredRef = thiscertsel->certCredRef;
 
+  if ( thiscertsel->certTable != NULL ) {
+    rdkcertcfg_releaseBlob( &thiscertsel->certTable->certBlob );  // for the previous cert
+  }
+
   if ( thisCertUri[0] == '\0' || thisCertCredRef[0] == '\0' ) {
     ERROR_LOG( " %s:invalid argument(s) [%s|%s]\n", __FUNCTION__, thisCertUri, thisCertCredRef );
     return certselectorBadArgument;
@@ -311,7 +484,8 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
 
   rdkcertselectorStatus_t retval = certselectorGeneralFailure;
   rdkcertselectorStatus_t findval = certselectorGeneralFailure; // used when looking for next cert
-  uint16_t certIndx = 0;
+  uint32_t certIndx = 0;
+  uint32_t skipIndx = UINT32_MAX;  // first cert skipped for its validity period, used if nothing else is found
 
   // while checking certs in config file, break if cert found or if no more certs available
   //                                      continue if this cert is not ok and more certs available
@@ -323,11 +497,10 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
       certFile += (sizeof(FILESCHEME)-1);
     }
 
-    // get date from file
-    struct stat fileStat;
-    int statret = stat( certFile, &fileStat );
-
-    if ( statret != 0 ) {  // file error
+    // get date from file, usually without a syscall, see rdkcertcfg_certMeta
+    rdkcertcfgCertMeta_t certMeta;
+    rdkcertcfg_t *cfg = ( thiscertsel->certTable != NULL ) ? thiscertsel->certTable->cfg : NULL;
+    if ( rdkcertcfg_certMeta( cfg, certFile, &certMeta ) != certcfgOk ) {  // file error
       DEBUG_LOG( " %s:cert file not found [%s]\n", __FUNCTION__, certFile );
       EXTRA_DEBUG_LOG( " %s:cert file not found, clear stat [%u], continue?\n", __FUNCTION__, certIndx );
 
@@ -349,12 +522,12 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
     } else if ( thiscertsel->certStat[certIndx] != CERTSTAT_NOTBAD ) {
 
       // file exists, check time stamp
-      time_t modTime = fileStat.st_mtime;
+      time_t modTime = certMeta.id.mtime.tv_sec;
       EXTRA_DEBUG_LOG( " %s:cert file was bad[%s|%lu]\n", __FUNCTION__, certFile, (unsigned long)modTime );
 
       // file was bad, see if it has changed
       unsigned long badTime = thiscertsel->certStat[certIndx];
-      if ( badTime == modTime ) {
+      if ( !certsel_certChanged( thiscertsel, certIndx, certFile, &certMeta ) ) {
         // file did not change, find next cert and continue
         EXTRA_DEBUG_LOG( " %s:cert file unchanged[%s|%lu]\n", __FUNCTION__, certFile, (unsigned long)modTime );
 
@@ -388,30 +561,34 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
     if ( retval == certselectorOk ) {
       EXTRA_DEBUG_LOG( " %s:get passcode (%u)\n", __FUNCTION__, retval );
       // file exists and is not the same as bad (or was not marked as bad), so get the passcode and return them
-      char *pc = NULL;
-      size_t pcsz = 0;
-      retval = certselectorFileError; // look for cred file, error out if not found
-      if ( rdkconfig_getStr( &pc, &pcsz, thisCertCredRef ) == RDKCONFIG_OK ) {
-        if ( pc != NULL ) {
-          // don't include any newline at end and don't add an additional null terminator
-          if ( pc[pcsz-2] == '\n' ) {
-            pc[pcsz-2] = '\0';
-            --pcsz;
+      retval = certsel_getPass( thiscertsel, thisCertCredRef, thiscertsel->certPass, sizeof(thiscertsel->certPass) );
+      if ( retval == certselectorOk ) {
+#ifdef RDKCERT_VALIDATION
+        rdkcertvalVerdict_t verdict = certvalOk;
+        if ( thiscertsel->certTable != NULL && thiscertsel->certTable->validate ) {
+          verdict = rdkcertval_check( cfg, certFile, thiscertsel->certPass );
+        }
+        if ( verdict != certvalOk && verdict != certvalUnknown ) {
+          // don't hand curl a cert that is sure to fail; content problems are remembered like a cert error
+          ERROR_LOG( "cert skipped, %s [%s]\n", rdkcertval_name( verdict ), certFile );
+          memwipe( thiscertsel->certPass, sizeof(thiscertsel->certPass) );
+          if ( !rdkcertval_timeBound( verdict ) ) {
+            certsel_markBad( thiscertsel, certIndx, certFile );
+          } else if ( skipIndx == UINT32_MAX ) {
+            skipIndx = certIndx;
           }
-
-          if ( pcsz < (sizeof(thiscertsel->certPass)-1) ) {
-            memcpy( thiscertsel->certPass, pc, pcsz );
-            thiscertsel->certPass[pcsz] = '\0';  // data coming in does not assume string so need to null terminate
-            rdkconfig_freeStr( &pc, pcsz );
-            retval = certselectorOk; // found it
-            EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
-            break; // found it, finish up
-          } else {
-            ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pcsz );
-            rdkconfig_freeStr( &pc, pcsz );
+          retval = certsel_findNextCert( thiscertsel );
+          if ( retval != certselectorOk ) {
+            retval = certselectorFileNotFound;
+            break; // give up, may fall back below
           }
-        } // pc not null
-      } // if rdkconfig_get is ok
+          thisCertUri = thiscertsel->certUri;
+          thisCertCredRef = thiscertsel->certCredRef;
+          continue;  // evaluate this next cert
+        }
+#endif
+        break; // found it, finish up
+      }
 
       DEBUG_LOG( " %s:credential reference not found (%u)\n", __FUNCTION__, retval );
       // could not retrieve the passcode, get next cert
@@ -434,7 +611,7 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
   // If all certs were exhausted, fall back to the last attempted bad cert.
   if ( retval == certselectorFileNotFound ) {
     int foundFallback = 0;    
-    uint16_t lastIndx = thiscertsel->certIndx;
+    uint32_t lastIndx = thiscertsel->certIndx;
       
     while ( lastIndx > 0 ) {
       lastIndx--;
@@ -447,29 +624,21 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
         break;
       }    
     }
+    // otherwise a cert skipped for its validity period, the clock may be wrong
+    if ( !foundFallback && skipIndx != UINT32_MAX ) {
+      thiscertsel->certIndx = skipIndx;
+      if ( certsel_findCert( thiscertsel ) == certselectorOk ) {
+        certIndx = thiscertsel->certIndx;
+        foundFallback = 1;
+      }
+    }
 
     DEBUG_LOG( " %s:all certs exhausted; falling back to last bad cert [%s]\n", __FUNCTION__, thiscertsel->certUri );
 
     // attempt to retrieve the passcode for the fallback cert
     if( foundFallback ) {
-      char *pc = NULL;
-      size_t pcsz = 0;
-      if ( rdkconfig_getStr( &pc, &pcsz, thiscertsel->certCredRef ) == RDKCONFIG_OK ) {
-        if ( pc != NULL ) {
-          if ( pc[pcsz-2] == '\n' ) {
-            pc[pcsz-2] = '\0';
-            --pcsz;
-          }
-          if ( pcsz < (sizeof(thiscertsel->certPass)-1) ) {
-            memcpy( thiscertsel->certPass, pc, pcsz );
-            thiscertsel->certPass[pcsz] = '\0';
-            rdkconfig_freeStr( &pc, pcsz );
-            EXTRA_DEBUG_LOG( " %s:got passcode for fallback cert\n", __FUNCTION__ );
-          } else {
-            ERROR_LOG( " %s:fallback pc did not fit (%zu)\n", __FUNCTION__, pcsz );
-            rdkconfig_freeStr( &pc, pcsz );
-          }
-        }
+      if ( certsel_getPass( thiscertsel, thiscertsel->certCredRef, thiscertsel->certPass, sizeof(thiscertsel->certPass) ) == certselectorOk ) {
+        EXTRA_DEBUG_LOG( " %s:got passcode for fallback cert\n", __FUNCTION__ );
       } else {
         DEBUG_LOG( " %s:could not retrieve passcode for fallback cert\n", __FUNCTION__ );
       }
@@ -482,6 +651,9 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
     *certUri = thiscertsel->certUri;
     *certPass = thiscertsel->certPass;
     thiscertsel->state = cssReadyToCheckCert;
+    if ( thiscertsel->certTable != NULL && thiscertsel->certTable->prefetch ) {
+      certsel_queuePrefetch( thiscertsel, certIndx + 1 );  // while the caller connects with this cert
+    }
 
     if ( thiscertsel->certStat[certIndx] != CERTSTAT_NOTBAD ) {
       DEBUG_LOG( " %s:returning last bad cert [%s] index [%u]\n", __FUNCTION__, thiscertsel->certUri, certIndx );
@@ -493,6 +665,103 @@ rdkcertselectorStatus_t rdkcertselector_getCert( rdkcertselector_h thiscertsel,
 } // rdkcertselector_getCert( )
 
 
+/**
+ *  Gets the content of the cert file returned by the last getCert, from a copy kept in memory.
+ *  In @param thiscertsel; cert selector handle.
+ *  Out @param data; content, valid until the next getCert or the handle is freed.
+ *  Out @param len; length of the content.
+ *  @return 0/certselectorOk for success, non-zero values for the failure.
+**/
+rdkcertselectorStatus_t rdkcertselector_getCertBlob( rdkcertselector_h thiscertsel, const unsigned char **data, size_t *len ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+  if ( data == NULL || len == NULL ) {
+    ERROR_LOG( " %s:null argument(s)\n", __FUNCTION__ );
+    return certselectorBadArgument;
+  }
+  *data = NULL;
+  *len = 0;
+  certselTable_t *table = thiscertsel->certTable;
+  if ( thiscertsel->state != cssReadyToCheckCert || table == NULL ) {
+    ERROR_LOG( " %s:unexpected state, %d!=%d\n", __FUNCTION__, thiscertsel->state, cssReadyToCheckCert );
+    return certselectorGeneralFailure;
+  }
+  if ( table->certBlob == NULL ) {
+    char *certFile = thiscertsel->certUri;
+    // strip off uri scheme "file://"
+    if ( strncmp( certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
+      certFile += (sizeof(FILESCHEME)-1);
+    }
+    rdkcertcfgStatus_t cfgstat = rdkcertcfg_certBlob( table->cfg, certFile, &table->certBlob );
+    if ( cfgstat != certcfgOk ) {
+      ERROR_LOG( " %s:cert file not read (%u) [%s]\n", __FUNCTION__, cfgstat, certFile );
+      return (rdkcertselectorStatus_t)cfgstat;
+    }
+  }
+  *data = table->certBlob->data;
+  *len = table->certBlob->len;
+  return certselectorOk;
+} // rdkcertselector_getCertBlob( )
+
+/**
+ *  Gets the decoded private key, cert and CA chain of the cert returned by the last getCert.
+ *  In @param thiscertsel; cert selector handle.
+ *  Out @param keyMaterial; decoded objects, each with a reference of its own.
+ *  @return 0/certselectorOk for success, non-zero values for the failure.
+**/
+rdkcertselectorStatus_t rdkcertselector_getKeyMaterial( rdkcertselector_h thiscertsel, rdkcertselectorKeyMaterial_t *keyMaterial ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+  if ( keyMaterial == NULL ) {
+    ERROR_LOG( " %s:null argument(s)\n", __FUNCTION__ );
+    return certselectorBadArgument;
+  }
+  memset( keyMaterial, 0, sizeof(*keyMaterial) );
+#ifdef RDKCERT_VALIDATION
+  if ( thiscertsel->state != cssReadyToCheckCert ) {
+    ERROR_LOG( " %s:unexpected state, %d!=%d\n", __FUNCTION__, thiscertsel->state, cssReadyToCheckCert );
+    return certselectorGeneralFailure;
+  }
+  char *certFile = thiscertsel->certUri;
+  // strip off uri scheme "file://"
+  if ( strncmp( certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
+    certFile += (sizeof(FILESCHEME)-1);
+  }
+  rdkcertcfg_t *cfg = ( thiscertsel->certTable != NULL ) ? thiscertsel->certTable->cfg : NULL;
+  rdkcertvalVerdict_t verdict = rdkcertval_load( cfg, certFile, thiscertsel->certPass,
+                                                 &keyMaterial->pkey, &keyMaterial->cert, &keyMaterial->chain );
+  if ( keyMaterial->cert == NULL ) {
+    ERROR_LOG( " %s:cert not decoded, %s [%s]\n", __FUNCTION__, rdkcertval_name( verdict ), certFile );
+    return certselectorFileError;
+  }
+  return certselectorOk;
+#else
+  ERROR_LOG( " %s:key material not supported\n", __FUNCTION__ );
+  return certselectorGeneralFailure;
+#endif
+} // rdkcertselector_getKeyMaterial( )
+
+/**
+ *  Releases the objects from rdkcertselector_getKeyMaterial.
+ *  In/Out @param keyMaterial; decoded objects, set to NULL.
+**/
+void rdkcertselector_freeKeyMaterial( rdkcertselectorKeyMaterial_t *keyMaterial ) {
+  if ( keyMaterial == NULL ) {
+    return;
+  }
+#ifdef RDKCERT_VALIDATION
+  sk_X509_pop_free( keyMaterial->chain, X509_free );
+  X509_free( keyMaterial->cert );
+  EVP_PKEY_free( keyMaterial->pkey );
+#endif
+  memset( keyMaterial, 0, sizeof(*keyMaterial) );
+} // rdkcertselector_freeKeyMaterial( )
+
+
 #define CURL_SUCCESS 0
 
 /**
@@ -520,8 +789,8 @@ rdkcertselectorRetry_t rdkcertselector_setCurlStatus( rdkcertselector_h thiscert
   // always wipe the password
   memwipe( thiscertsel->certPass, sizeof( thiscertsel->certPass ) );
 
-  uint16_t certIndx = thiscertsel->certIndx;
-  if ( certIndx >= LIST_MAX ) {
+  uint32_t certIndx = thiscertsel->certIndx;
+  if ( certIndx >= thiscertsel->certStatCnt ) {
     ERROR_LOG( " %s:INTERNAL ERROR: certIndx [%u]\n", __FUNCTION__, certIndx );
     return RETRY_ERROR;
   }
@@ -561,9 +830,8 @@ rdkcertselectorRetry_t rdkcertselector_setCurlStatus( rdkcertselector_h thiscert
       certFile += (sizeof(FILESCHEME)-1);
     }
 
-    // mark stat with file date
-    unsigned long modtime = filetime( certFile );
-    thiscertsel->certStat[certIndx] = (modtime!=0) ? modtime : CERTSTAT_NOTBAD;
+    // mark stat with file date, as getCert saw it
+    certsel_markBad( thiscertsel, certIndx, certFile );
 
     // find next cert; need to know if another one is available or not
     rdkcertselectorStatus_t retval = certsel_findNextCert( thiscertsel );
@@ -596,18 +864,28 @@ rdkcertselectorRetry_t rdkcertselector_setCurlStatus( rdkcertselector_h thiscert
   return NO_RETRY;
 } // rdkcertselector_setCurlStatus( )
 
+// rdkcertselector_releaseCert - give back the cert of the last getCert without a connection status
+// for a cert that was never used, e.g. rdkcertselector_applyToCurl could not set it on the curl handle;
+// the passcode is wiped, the cert is not marked bad and the next getCert starts from the same cert
+// used by rdkcertselector_curl.c, not in the header
+void rdkcertselector_releaseCert( rdkcertselector_h thiscertsel ) {
+  if ( thiscertsel == NULL || thiscertsel->state != cssReadyToCheckCert ) {
+    return;
+  }
+  memwipe( thiscertsel->certPass, sizeof( thiscertsel->certPass ) );
+  thiscertsel->state = cssReadyToGiveCert;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // INTERNAL STATIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// fix this to always wipe without getting optimized out
+// memwipe - wipe memory holding a passcode; explicit_bzero is not optimized out before a free
 static void memwipe( volatile void *mem, size_t sz ) {
-  memset( (void *)mem, 0, sz );
+  explicit_bzero( (void *)mem, sz );
 }
 
-#define MAX_GRP_CNT 10  // can fit this many groups on one line of config file
-
 // includesChars - check if a char string includes at least one of the two chars provided
 // ch1 or ch2 can be zero so that only the other char is searched for
 // return 1(true) or 0(false)
@@ -623,14 +901,14 @@ static int includesChars( const char *str, char ch1, char ch2 ) {
 } // includesChars( )
 
 // find cert based on info in the certsel instance
-// use config file path to open file, search for the certIndx'th instance of certGroup in the file
+// look up the certIndx'th instance of certGroup in the parsed config table
+// the table is (re)built from the config file only when the file has changed
 // update the certUri and certCredRef fields, which will be used by the get function
 static rdkcertselectorStatus_t certsel_findCert( rdkcertselector_h thiscertsel ) {
   if ( thiscertsel == NULL ) {
     DEBUG_LOG( " %s:null argument\n", __FUNCTION__ );
     return certselectorBadPointer;
   }
-  rdkcertselectorStatus_t retval = certselectorGeneralFailure;
 
   char *certSelCfg = thiscertsel->certSelPath;
   char *certGroup = thiscertsel->certGroup;
@@ -638,136 +916,248 @@ static rdkcertselectorStatus_t certsel_findCert( rdkcertselector_h thiscertsel )
     ERROR_LOG( " %s:argument error [%s|%s]\n", __FUNCTION__, certSelCfg, certGroup );
     return certselectorBadArgument;
   }
-  size_t grplen = strnlen( certGroup, sizeof( thiscertsel->certGroup ) );
 
-  // have we surpassed the max number of certs?
-  uint16_t certIndx = thiscertsel->certIndx;
-  if ( certIndx >= LIST_MAX ) {
-    DEBUG_LOG( " %s:cert index beyond max (%d) for %s\n", __FUNCTION__, LIST_MAX, thiscertsel->certGroup );
-    return certselectorFileNotFound;
+  uint32_t certIndx = thiscertsel->certIndx;
+  rdkcertselectorStatus_t retval = certsel_loadTable( thiscertsel );
+  if ( retval != certselectorOk ) {
+    return retval;
   }
 
-  FILE *cfgfp = fopen( certSelCfg, "r" );
-  if ( cfgfp == NULL) {
-    ERROR_LOG( " %s:config file, %s, not found\n", __FUNCTION__, certSelCfg );
-    return certselectorFileNotFound;
+  certselTable_t *table = thiscertsel->certTable;
+  if ( certIndx >= table->candCnt ) {
+    if ( table->endStat == certselectorFileNotFound ) {
+      EXTRA_DEBUG_LOG( " %s:match not found for %s\n", __FUNCTION__, certGroup );
+    }
+    return table->endStat;
   }
 
-  uint16_t loopIndx = 0;
-  char cfgline[MAX_LINE_LENGTH+1]; // one extra to check for trunctation
-  char *cfgfield = NULL, *cfggrp = NULL;
-  char *savetok_f, *savetok_g;
+  // check format and extract cert info
+  const rdkcertcfgRow_t *cand = &table->snap->rows[table->cand[certIndx]];
+  retval = (rdkcertselectorStatus_t)rdkcertcfg_rowCert( table->snap, cand, thiscertsel->certUri, sizeof(thiscertsel->certUri)-1,
+                                                        thiscertsel->certCredRef, sizeof(thiscertsel->certCredRef)-1 );
+  if ( retval != certselectorOk ) {
+    return retval;
+  }
 
-  // config file fields as follows:
-  // <group>,<label>,<type>,<uri>,<credref>
-  // look for group in field 1 and then on match store fields 4 and 5
+  EXTRA_DEBUG_LOG( " %s: uri [%s], credref [%s]\n", __FUNCTION__, thiscertsel->certUri, thiscertsel->certCredRef );
 
-  cfgline[MAX_LINE_LENGTH-1] = '\0'; // if this bytes gets overwritten, then line was too long
+  return certselectorOk;
+} // certsel_findCert( rdkcertselector_h thiscertsel )
 
-  while ( fgets( cfgline, sizeof(cfgline), cfgfp ) ) {
+// make sure the candidate table matches the current config file and cert group
+// the config image is shared by all handles using the same config file, and only re-parsed when the file changes
+// if the image or the cert group changed, use the image's candidate list for the cert group, which has no size limit
+// the per candidate status of the handle is grown to cover it, keeping the status of existing indices
+// returns certselectorOk if the table is usable, certselectorFileNotFound if the config file can't be opened
+static rdkcertselectorStatus_t certsel_loadTable( rdkcertselector_h thiscertsel ) {
+  char *certGroup = thiscertsel->certGroup;
+  certselTable_t *table = thiscertsel->certTable;
 
-    // check if line from file was truncated
-    if ( cfgline[MAX_LINE_LENGTH-1] != '\0' ) {
-      ERROR_LOG( " %s: config line too long (%c)\n", __FUNCTION__, cfgline[MAX_LINE_LENGTH-1] );
-      retval = certselectorFileError;
-      break;
+  if ( table == NULL ) {
+    table = (certselTable_t *)calloc( 1, sizeof(certselTable_t) );
+    if ( table == NULL ) {
+      ERROR_LOG( " %s:memory error\n", __FUNCTION__ );
+      return certselectorGeneralFailure;
     }
+    thiscertsel->certTable = table;
+  }
 
-    // remove terminal newline
-    char *nl = strchr( cfgline, '\n' );
-    if ( nl != NULL ) *nl = '\0';
+  rdkcertcfgSnap_t *oldsnap = table->snap;
+  rdkcertcfgStatus_t cfgstat = rdkcertcfg_refresh( &table->cfg, thiscertsel->certSelPath, &table->snap );
+  if ( cfgstat != certcfgOk ) {
+    table->candCnt = 0;
+    return (rdkcertselectorStatus_t)cfgstat;
+  }
 
-    // look for cert group in first field
-    // do not allow unexpected whitespace
+  if ( table->snap == oldsnap && strcmp( table->cfgGroup, certGroup ) == 0 ) {
+    return certselectorOk; // config and group unchanged
+  }
 
-    cfgfield = strtok_r( cfgline, DELIM_STR, &savetok_f ); // 1st field is group
+  // format errors are only reported if a candidate is used
+  const uint32_t *cand = NULL;
+  size_t candCnt = rdkcertcfg_groupCand( table->snap, certGroup, &cand );
+  if ( candCnt > thiscertsel->certStatCnt || thiscertsel->certStat == NULL || thiscertsel->certPrint == NULL ) {
+    size_t statCnt = ( candCnt > LIST_MAX ) ? candCnt : LIST_MAX;
+    unsigned long *certStat = (unsigned long *)realloc( thiscertsel->certStat, statCnt * sizeof(*certStat) );
+    if ( certStat != NULL ) {
+      thiscertsel->certStat = certStat;
+    }
+    certselPrint_t *certPrint = (certselPrint_t *)realloc( thiscertsel->certPrint, statCnt * sizeof(*certPrint) );
+    if ( certPrint != NULL ) {
+      thiscertsel->certPrint = certPrint;
+    }
+    if ( certStat == NULL || certPrint == NULL ) {
+      ERROR_LOG( " %s:memory error (%zu)\n", __FUNCTION__, candCnt );
+      table->candCnt = 0;
+      table->cfgGroup[0] = '\0';  // try again on next lookup
+      return certselectorGeneralFailure;
+    }
+    memset( certStat + thiscertsel->certStatCnt, 0, ( statCnt - thiscertsel->certStatCnt ) * sizeof(*certStat) );
+    memset( certPrint + thiscertsel->certStatCnt, 0, ( statCnt - thiscertsel->certStatCnt ) * sizeof(*certPrint) );
+    thiscertsel->certStatCnt = statCnt;
+  }
+  table->cand = cand;
+  table->candCnt = candCnt;
+  table->endStat = (rdkcertselectorStatus_t)table->snap->endStat;
+  strcpy( table->cfgGroup, certGroup );
+  EXTRA_DEBUG_LOG( " %s:%u candidates for %s\n", __FUNCTION__, table->candCnt, certGroup );
+#ifdef RDKCERT_VALIDATION
+  if ( table->validate ) {
+    certsel_queueValidation( thiscertsel );
+  }
+#endif
 
-    if ( cfgfield != NULL ) {
-      // look for group in first field
-      int maxcnt = MAX_GRP_CNT;
-      while ( NULL != ( cfggrp = strtok_r( cfgfield, GRPDELIM_STR, &savetok_g ) ) ) {
-        if ( strncmp( cfggrp, certGroup, grplen+1 ) == 0 ) {
-          break;
-        }
-        if ( --maxcnt <= 0 ) {
-          ERROR_LOG( " %s:get maxcnt reached\n", __FUNCTION__ );
-          cfggrp = NULL;
-          break;
-        }
-        cfgfield = NULL; // next strtok_r needs to continue on
+  return certselectorOk;
+} // certsel_loadTable( rdkcertselector_h thiscertsel )
+
+// drop the passcode holds, detach from the shared config and hrot entries and free the candidate table
+static void certsel_freeTable( rdkcertselector_h thiscertsel ) {
+  certselTable_t *table = thiscertsel->certTable;
+  if ( table != NULL ) {
+    rdkcertcfg_releaseBlob( &table->certBlob );
+    rdkcertcfg_passRelease( &table->passHolds );
+    rdkcertcfg_release( &table->snap );
+    rdkcertcfg_detach( &table->cfg );
+    rdkcertcfg_detach( &table->hrot );
+    free( table );
+    thiscertsel->certTable = NULL;
+  }
+  free( thiscertsel->certStat );
+  thiscertsel->certStat = NULL;
+  free( thiscertsel->certPrint );
+  thiscertsel->certPrint = NULL;
+  thiscertsel->certStatCnt = 0;
+} // certsel_freeTable( )
+
+// mark a cert bad with its file date, and fingerprint the content,
+// so touching the file without changing it does not clear the mark
+static void certsel_markBad( rdkcertselector_h thiscertsel, uint32_t certIndx, const char *certFile ) {
+  rdkcertcfg_t *cfg = ( thiscertsel->certTable != NULL ) ? thiscertsel->certTable->cfg : NULL;
+  rdkcertcfgCertMeta_t certMeta;
+  memset( &certMeta, 0, sizeof(certMeta) );
+  uint64_t certHash = 0;
+  unsigned long modtime = 0;
+  if ( rdkcertcfg_certHash( cfg, certFile, &certMeta, &certHash ) == certcfgOk ) {
+    modtime = (unsigned long)certMeta.id.mtime.tv_sec;
+  }
+  thiscertsel->certStat[certIndx] = (modtime!=0) ? modtime : CERTSTAT_NOTBAD;
+  thiscertsel->certPrint[certIndx].mark = thiscertsel->certStat[certIndx];
+  thiscertsel->certPrint[certIndx].id = certMeta.id;
+  thiscertsel->certPrint[certIndx].hash = certHash;
+  // the passcode may have been rotated, fetch it again for the next use
+  rdkcertcfg_passPurge( thiscertsel->certCredRef );
+} // certsel_markBad( )
+
+// get the passcode of a credential reference into certPass, null terminated
+// from the passcode cache if enabled, see rdkcertselector_setPassCacheTtl, otherwise from rdkconfig
+// the handle holds the credential reference until it is freed
+// returns certselectorOk, or certselectorFileError if not found or it does not fit
+static rdkcertselectorStatus_t certsel_getPass( rdkcertselector_h thiscertsel, const char *certCredRef, char *certPass, size_t passsz ) {
+  if ( thiscertsel->certTable != NULL ) {
+    rdkcertcfg_passHold( &thiscertsel->certTable->passHolds, certCredRef );
+  }
+  if ( rdkcertcfg_passGet( certCredRef, certPass, passsz ) == certcfgOk ) {
+    EXTRA_DEBUG_LOG( " %s:cached passcode\n", __FUNCTION__ );
+    return certselectorOk;
+  }
+  return certsel_fetchPass( certCredRef, certPass, passsz );
+} // certsel_getPass( )
+
+// get the passcode of a credential reference from rdkconfig into certPass, null terminated,
+// and put it in the passcode cache if enabled
+// returns certselectorOk, or certselectorFileError if not found or it does not fit
+static rdkcertselectorStatus_t certsel_fetchPass( const char *certCredRef, char *certPass, size_t passsz ) {
+  rdkcertselectorStatus_t retval = certselectorFileError; // look for cred file, error out if not found
+  if ( rdkconfig_getInto != NULL ) {
+    // decrypt straight into certPass, no heap copy of the passcode
+    size_t pclen = 0;
+    if ( rdkconfig_getInto( certCredRef, (uint8_t *)certPass, passsz-1, &pclen ) == RDKCONFIG_OK ) {
+      // don't include any newline at end
+      if ( pclen >= 1 && certPass[pclen-1] == '\n' ) {
+        --pclen;
       }
+      certPass[pclen] = '\0'; // data coming in does not assume string so need to null terminate
+      rdkcertcfg_passPut( certCredRef, certPass );
+      retval = certselectorOk; // found it
+      EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
+    } else if ( pclen != 0 ) {
+      ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pclen );
     }
-    if ( cfggrp != NULL ) { // it will be null if it didn't match any
-      // matches, is it correct index?
-      if ( loopIndx == certIndx ) {
-
-        // This looks like the right one, check format and extract cert info
-
-        // skip fields 2=label and 3=type
-        cfgfield = strtok_r( NULL, DELIM_STR, &savetok_f ); // skip 2nd field
-        if ( cfgfield != NULL ) {
-          cfgfield = strtok_r( NULL, DELIM_STR, &savetok_f ); // skip 3rd field
-        }
-        if ( cfgfield == NULL ) {
-          ERROR_LOG( " %s:missing fields (2/3)\n", __FUNCTION__ );
-          retval = certselectorFileError;
-          break;
-        }
-
-        // copy uri and cred reference fields into object
-        // an error here is probably a corruption of the config file
-        cfgfield = strtok_r( NULL, DELIM_STR, &savetok_f ); // 4th field is URI
-        if ( cfgfield != NULL ) {
-          size_t fieldlen = strlen( cfgfield );
-          if ( fieldlen < sizeof(thiscertsel->certUri)-1 ) {
-            strcpy( thiscertsel->certUri, cfgfield );
-            EXTRA_DEBUG_LOG( " %s: uri [%s]\n", __FUNCTION__, thiscertsel->certUri );
-            cfgfield = strtok_r( NULL, DELIM_STR, &savetok_f ); // 5th field is Cred reference
-            if ( cfgfield != NULL ) {
-              fieldlen = strlen( cfgfield );
-              if ( fieldlen < sizeof( thiscertsel->certCredRef)-1 ) {
-                strcpy( thiscertsel->certCredRef, cfgfield );
-                EXTRA_DEBUG_LOG( " %s: credref [%s]\n", __FUNCTION__, thiscertsel->certCredRef );
-              } else {
-                cfgfield = NULL; // 5th field error
-                thiscertsel->certUri[0] = '\0';
-              }
-            }
-          } else {
-            cfgfield = NULL; // 4th field error
-          }
-        }
-        // check for error
-        if ( cfgfield == NULL ) {
-          ERROR_LOG( " %s:missing fields (4/5)\n", __FUNCTION__ );
-          retval = certselectorFileError;
-          break;
-        }
-
-        // found one and saved the cert info
-        retval = certselectorOk;
-        break;
-      } // if correct indx
-
-      // correct group but not correct index so increment index and keep looking
-      loopIndx++;
-    } // end if matches group
-
-  } // end while
-
-  fclose( cfgfp );
-
-  if ( retval == certselectorGeneralFailure ) {
-    EXTRA_DEBUG_LOG( " %s:match not found for %s\n", __FUNCTION__, certGroup );
-    retval = certselectorFileNotFound;
+    return retval;
   }
+  // rdkconfig without rdkconfig_getInto
+  char *pc = NULL;
+  size_t pcsz = 0;
+  if ( rdkconfig_getStr( &pc, &pcsz, certCredRef ) == RDKCONFIG_OK ) {
+    if ( pc != NULL ) {
+      // don't include any newline at end and don't add an additional null terminator
+      if ( pcsz >= 2 && pc[pcsz-2] == '\n' ) {
+        pc[pcsz-2] = '\0';
+        --pcsz;
+      }
 
+      if ( pcsz < (passsz-1) ) {
+        memcpy( certPass, pc, pcsz );
+        certPass[pcsz] = '\0'; // data coming in does not assume string so need to null terminate
+        rdkconfig_freeStr( &pc, pcsz );
+        rdkcertcfg_passPut( certCredRef, certPass );
+        retval = certselectorOk; // found it
+        EXTRA_DEBUG_LOG( " %s:got the passcode\n", __FUNCTION__ );
+      } else {
+        ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pcsz );
+        rdkconfig_freeStr( &pc, pcsz );
+      }
+    } // pc not null
+  } // rdkconfig_getStr ok
   return retval;
-} // certsel_findCert( rdkcertselector_h thiscertsel )
+} // certsel_fetchPass( )
+
+// copy a passcode of pclen bytes from rdkconfig into certPass, null terminated, without a newline at the end,
+// and put it in the passcode cache if enabled
+// returns certselectorOk, or certselectorFileError if it does not fit
+static rdkcertselectorStatus_t certsel_setPass( const char *certCredRef, const uint8_t *pc, size_t pclen, char *certPass, size_t passsz ) {
+  if ( pclen >= 1 && pc[pclen-1] == '\n' ) {
+    --pclen;
+  }
+  if ( pclen >= passsz ) {
+    ERROR_LOG( " %s:pc did not fit (%zu)\n", __FUNCTION__, pclen );
+    return certselectorFileError;
+  }
+  memcpy( certPass, pc, pclen );
+  certPass[pclen] = '\0';
+  rdkcertcfg_passPut( certCredRef, certPass );
+  return certselectorOk;
+} // certsel_setPass( )
+
+// check if a cert marked bad has changed since, certMeta is its current metadata; 1(true) or 0(false)
+// same identity is unchanged; same size and content hash is unchanged even if touched or rewritten
+static int certsel_certChanged( rdkcertselector_h thiscertsel, uint32_t certIndx, const char *certFile, rdkcertcfgCertMeta_t *certMeta ) {
+  certselPrint_t *print = &thiscertsel->certPrint[certIndx];
+  if ( print->mark != thiscertsel->certStat[certIndx] ) {
+    // marked without a fingerprint, only the file date is known
+    return ( thiscertsel->certStat[certIndx] != (unsigned long)certMeta->id.mtime.tv_sec );
+  }
+  if ( rdkcertcfg_sameId( &print->id, &certMeta->id ) ) {
+    return 0;
+  }
+  if ( print->id.size != certMeta->id.size ) {
+    return 1;
+  }
+  rdkcertcfg_t *cfg = ( thiscertsel->certTable != NULL ) ? thiscertsel->certTable->cfg : NULL;
+  rdkcertcfgCertMeta_t hashMeta;
+  uint64_t certHash;
+  if ( rdkcertcfg_certHash( cfg, certFile, &hashMeta, &certHash ) != certcfgOk || certHash != print->hash ) {
+    return 1;
+  }
+  // same content, remember the new identity so the file is not hashed again
+  EXTRA_DEBUG_LOG( " %s:cert file touched, content unchanged[%s]\n", __FUNCTION__, certFile );
+  print->id = hashMeta.id;
+  return 0;
+} // certsel_certChanged( )
 
 // find next cert based on info in the certsel instance
 // increment index and clear previous uri and credref, then
-// use config file path to open file, search for the certIndx'th instance of certGroup in the file
+// look up the certIndx'th instance of certGroup in the parsed config table
 // update the certUri and certCredRef fields, which will be used by the get function
 static rdkcertselectorStatus_t certsel_findNextCert( rdkcertselector_h thiscertsel ) {
   if ( thiscertsel == NULL ) {
@@ -783,6 +1173,207 @@ static rdkcertselectorStatus_t certsel_findNextCert( rdkcertselector_h thiscerts
   return certsel_findCert( thiscertsel );
 }
 
+// background worker, one thread for the process, started by the first rdkcertselector_enableValidation
+// or rdkcertselector_enablePrefetch; jobs are copies of the candidate uri and credref, so the thread never touches a handle
+typedef struct certsel_workJob_s {
+  char certFile[PATH_MAX+1];
+  char certCredRef[PARAM_MAX+1];
+  char certPass[PARAM_MAX+1];      // passcode for the job, see certsel_batchPass; wiped with the job
+  int passState;                   // CERTSEL_PASS_*
+  int validate;                    // 1 to check the cert, 0 to only fetch the passcode into the passcode cache
+  struct certsel_workJob_s *passFrom;  // earlier job of the batch with the same credential
+  struct certsel_workJob_s *next;
+} certsel_workJob_t;
+
+#define CERTSEL_PASS_NONE 0        // no passcode; not found, or for a prefetch, already cached
+#define CERTSEL_PASS_CACHED 1      // from the passcode cache, or shared with an earlier job
+#define CERTSEL_PASS_FETCHED 2     // fetched from rdkconfig
+#define CERTSEL_BATCH_MAX 32       // credentials per rdkconfig_getMany call
+
+#define CERTSEL_WORKJOBS_MAX 1024  // jobs beyond this are dropped, getCert does the work itself
+
+static pthread_mutex_t certsel_workLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t certsel_workCond = PTHREAD_COND_INITIALIZER;
+static certsel_workJob_t *certsel_workJobs = NULL;
+static certsel_workJob_t **certsel_workTail = &certsel_workJobs;
+static unsigned int certsel_workPending = 0;   // queued or being worked on
+static int certsel_workStarted = 0;
+
+// get the passcodes of a batch of jobs: from the passcode cache, otherwise from rdkconfig,
+// each credential once, with rdkconfig_getMany one backend call per CERTSEL_BATCH_MAX credentials
+// a prefetch job whose passcode is already cached is left without one, there is nothing to do for it
+static void certsel_batchPass( certsel_workJob_t *batch ) {
+  certsel_workJob_t *fetchJobs[CERTSEL_BATCH_MAX];
+  const char *refnames[CERTSEL_BATCH_MAX];
+  rdkconfig_buf_t pcs[CERTSEL_BATCH_MAX];
+  size_t fetchCnt = 0, indx;
+  int getMany = ( rdkconfig_getMany != NULL && rdkconfig_freeMany != NULL );
+  certsel_workJob_t *job;
+  for ( job = batch; job != NULL; job = job->next ) {
+    job->passState = CERTSEL_PASS_NONE;
+    job->passFrom = NULL;
+    if ( job->validate ? rdkcertcfg_passGet( job->certCredRef, job->certPass, sizeof(job->certPass) ) == certcfgOk
+                       : rdkcertcfg_passCached( job->certCredRef ) ) {
+      job->passState = job->validate ? CERTSEL_PASS_CACHED : CERTSEL_PASS_NONE;
+      continue;
+    }
+    for ( indx = 0; indx < fetchCnt && strcmp( refnames[indx], job->certCredRef ) != 0; indx++ );
+    if ( indx < fetchCnt ) {
+      job->passFrom = fetchJobs[indx];
+    } else if ( getMany && fetchCnt < CERTSEL_BATCH_MAX ) {
+      fetchJobs[fetchCnt] = job;
+      refnames[fetchCnt++] = job->certCredRef;
+    } else if ( certsel_fetchPass( job->certCredRef, job->certPass, sizeof(job->certPass) ) == certselectorOk ) {
+      job->passState = CERTSEL_PASS_FETCHED;  // no rdkconfig_getMany, or the batch is full
+    }
+  }
+  if ( fetchCnt == 1 ) {
+    // decrypt straight into the job, see certsel_fetchPass
+    if ( certsel_fetchPass( refnames[0], fetchJobs[0]->certPass, sizeof(fetchJobs[0]->certPass) ) == certselectorOk ) {
+      fetchJobs[0]->passState = CERTSEL_PASS_FETCHED;
+    }
+  } else if ( fetchCnt > 1 ) {
+    rdkconfig_getMany( refnames, fetchCnt, pcs ); // status of each is checked below
+    for ( indx = 0; indx < fetchCnt; indx++ ) {
+      job = fetchJobs[indx];
+      if ( pcs[indx].status == RDKCONFIG_OK && pcs[indx].buf != NULL &&
+           certsel_setPass( job->certCredRef, pcs[indx].buf, pcs[indx].len, job->certPass, sizeof(job->certPass) ) == certselectorOk ) {
+        job->passState = CERTSEL_PASS_FETCHED;
+      }
+    }
+    rdkconfig_freeMany( pcs, fetchCnt );
+  }
+  for ( job = batch; job != NULL; job = job->next ) {
+    if ( job->passFrom != NULL && job->passFrom->passState != CERTSEL_PASS_NONE ) {
+      memcpy( job->certPass, job->passFrom->certPass, sizeof(job->certPass) );
+      job->passState = CERTSEL_PASS_CACHED;
+    }
+  }
+} // certsel_batchPass( )
+
+static void *certsel_workThread( void *arg ) {
+  pthread_mutex_lock( &certsel_workLock );
+  while ( 1 ) {
+    while ( certsel_workJobs == NULL ) {
+      pthread_cond_wait( &certsel_workCond, &certsel_workLock );
+    }
+    // take every queued job, their passcodes are fetched together
+    certsel_workJob_t *batch = certsel_workJobs;
+    certsel_workJobs = NULL;
+    certsel_workTail = &certsel_workJobs;
+    pthread_mutex_unlock( &certsel_workLock );
+
+    certsel_batchPass( batch );
+    unsigned int jobCnt = 0;
+    while ( batch != NULL ) {
+      certsel_workJob_t *job = batch;
+      batch = job->next;
+      if ( !job->validate ) {
+        // the passcode is held in the passcode cache, getCert finds it there
+        if ( job->passState == CERTSEL_PASS_FETCHED ) {
+          __atomic_add_fetch( &certsel_prefetches, 1, __ATOMIC_RELAXED );
+          EXTRA_DEBUG_LOG( " %s:prefetched [%s]\n", __FUNCTION__, job->certCredRef );
+        }
+      }
+#ifdef RDKCERT_VALIDATION
+      // the verdict is cached, getCert finds it there
+      else if ( job->passState != CERTSEL_PASS_NONE ) {
+        rdkcertvalVerdict_t verdict = rdkcertval_check( NULL, job->certFile, job->certPass );
+        EXTRA_DEBUG_LOG( " %s:checked [%s] %s\n", __FUNCTION__, job->certFile, rdkcertval_name( verdict ) );
+      }
+#endif
+      memwipe( job, sizeof(*job) );
+      free( job );
+      jobCnt++;
+    }
+
+    pthread_mutex_lock( &certsel_workLock );
+    certsel_workPending -= jobCnt;
+  }
+  return NULL;
+} // certsel_workThread( )
+
+// start the worker if not started yet, caller holds certsel_workLock; returns 1 if it is running
+static int certsel_startWorker( void ) {
+  if ( !certsel_workStarted ) {
+    pthread_t tid;
+    pthread_attr_t attr;
+    pthread_attr_init( &attr );
+    pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+    if ( pthread_create( &tid, &attr, certsel_workThread, NULL ) != 0 ) {
+      ERROR_LOG( " %s:worker thread not started, getCert does the work\n", __FUNCTION__ );
+      pthread_attr_destroy( &attr );
+      return 0;
+    }
+    pthread_attr_destroy( &attr );
+    certsel_workStarted = 1;
+  }
+  return 1;
+} // certsel_startWorker( )
+
+// queue a job for a candidate, caller holds certsel_workLock; returns 1 if queued
+static int certsel_queueJob( certselTable_t *table, uint32_t candIndx, int validate ) {
+  if ( certsel_workPending >= CERTSEL_WORKJOBS_MAX ) {
+    return 0;
+  }
+  certsel_workJob_t *job = (certsel_workJob_t *)malloc( sizeof(certsel_workJob_t) );
+  if ( job == NULL ) {
+    return 0;
+  }
+  const rdkcertcfgRow_t *cand = &table->snap->rows[table->cand[candIndx]];
+  if ( rdkcertcfg_rowCert( table->snap, cand, job->certFile, sizeof(job->certFile)-1,
+                           job->certCredRef, sizeof(job->certCredRef)-1 ) != certcfgOk ) {
+    free( job );
+    return 0;
+  }
+  rdkcertcfg_passHold( &table->passHolds, job->certCredRef );  // the job may put the passcode in the cache
+  if ( strncmp( job->certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
+    memmove( job->certFile, job->certFile + sizeof(FILESCHEME)-1, strlen( job->certFile ) - (sizeof(FILESCHEME)-1) + 1 );
+  }
+  job->validate = validate;
+  job->next = NULL;
+  *certsel_workTail = job;
+  certsel_workTail = &job->next;
+  certsel_workPending++;
+  return 1;
+} // certsel_queueJob( )
+
+#ifdef RDKCERT_VALIDATION
+// queue the candidates of the handle's cert group for checking
+static void certsel_queueValidation( rdkcertselector_h thiscertsel ) {
+  certselTable_t *table = thiscertsel->certTable;
+  uint32_t candIndx;
+  pthread_mutex_lock( &certsel_workLock );
+  if ( certsel_startWorker() ) {
+    for ( candIndx = 0; candIndx < table->candCnt && certsel_workPending < CERTSEL_WORKJOBS_MAX; candIndx++ ) {
+      certsel_queueJob( table, candIndx, 1 );
+    }
+    pthread_cond_signal( &certsel_workCond );
+  }
+  pthread_mutex_unlock( &certsel_workLock );
+} // certsel_queueValidation( )
+#endif
+
+// queue fetching the passcode of the first candidate from candIndx on that is not marked bad,
+// the one getCert hands out if the current cert fails
+static void certsel_queuePrefetch( rdkcertselector_h thiscertsel, uint32_t candIndx ) {
+  certselTable_t *table = thiscertsel->certTable;
+  if ( table == NULL || table->snap == NULL ) {
+    return;
+  }
+  while ( candIndx < table->candCnt && thiscertsel->certStat[candIndx] != CERTSTAT_NOTBAD ) {
+    candIndx++;
+  }
+  if ( candIndx >= table->candCnt ) {
+    return;
+  }
+  pthread_mutex_lock( &certsel_workLock );
+  if ( certsel_startWorker() && certsel_queueJob( table, candIndx, 0 ) ) {
+    pthread_cond_signal( &certsel_workCond );
+  }
+  pthread_mutex_unlock( &certsel_workLock );
+} // certsel_queuePrefetch( )
+
 
 #define countof(array) (sizeof(array) / sizeof(array[0]))
 
@@ -813,19 +1404,6 @@ static rdkcertselectorRetry_t certsel_chkCertError( int curlStat ) {
   return retval;
 }
 
-// get the file date in seconds since epoc or return 0 on error
-static unsigned long filetime( const char *fname ) {
-  unsigned long retval = 0;
-  // get date from file
-  struct stat fileStat;
-  int statret = stat( fname, &fileStat );
-  if ( statret == 0 ) {
-    time_t modTime = fileStat.st_mtime;
-    retval = (unsigned long)modTime;
-  }
-  return retval;
-}
-
 
 #if defined(UNIT_TESTS) || defined(GTEST_ENABLE)
 #include "unit_test.h"
@@ -898,6 +1476,50 @@ int rdkconfig_freeStr( char **sbuff, size_t sbuffsz ) { // MOCK
   return RDKCONFIG_OK;
 }
 
+// rdkconfig_getInto - get credential into caller buffer, same credentials as rdkconfig_getStr
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len ) { // MOCK
+  char *pc = NULL;
+  size_t pcsz = 0;
+  *len = 0;
+  if ( rdkconfig_getStr( &pc, &pcsz, refname ) != RDKCONFIG_OK ) {
+    return RDKCONFIG_FAIL;
+  }
+  *len = pcsz - 1; // without null terminator
+  int retval = ( *len <= cap ) ? RDKCONFIG_OK : RDKCONFIG_FAIL;
+  if ( retval == RDKCONFIG_OK ) {
+    memcpy( buf, pc, *len );
+  }
+  rdkconfig_freeStr( &pc, pcsz );
+  return retval;
+}
+
+static int ut_getManyCnt = 0;  // number of batch credential fetches
+
+// rdkconfig_getMany - get credentials in one call, same credentials as rdkconfig_getStr
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] ) { // MOCK
+  int retval = RDKCONFIG_OK;
+  ut_getManyCnt++;
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    char *pc = NULL;
+    size_t pcsz = 0;
+    out[indx].status = rdkconfig_getStr( &pc, &pcsz, refnames[indx] );
+    out[indx].buf = (uint8_t *)pc;
+    out[indx].len = ( pc != NULL ) ? pcsz - 1 : 0;
+    if ( out[indx].status != RDKCONFIG_OK ) {
+      out[indx].buf = NULL;
+      retval = RDKCONFIG_FAIL;
+    }
+  }
+  return retval;
+}
+
+int rdkconfig_freeMany( rdkconfig_buf_t out[], size_t n ) { // MOCK
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    rdkconfig_freeStr( (char **)&out[indx].buf, out[indx].len + 1 );
+  }
+  return RDKCONFIG_OK;
+}
+
 
 // used throughout tests
 static const char *certsel_path = CERTSEL_CFG;
@@ -905,6 +1527,19 @@ static const char *hrotprop_path = HROT_PROP;
 
 // Unit test support functions
 
+// get the file date in seconds since epoc or return 0 on error
+static unsigned long filetime( const char *fname ) {
+  unsigned long retval = 0;
+  // get date from file
+  struct stat fileStat;
+  int statret = stat( fname, &fileStat );
+  if ( statret == 0 ) {
+    time_t modTime = fileStat.st_mtime;
+    retval = (unsigned long)modTime;
+  }
+  return retval;
+}
+
 // initialize or reinitialize a certsel test object
 static void ut_initcs( rdkcertselector_t *tstcs ) {
   UT_NOTNULL( tstcs ); // memory error
@@ -915,7 +1550,10 @@ static void ut_initcs( rdkcertselector_t *tstcs ) {
   tstcs->certGroup[ PARAM_MAX-1 ] = '\0';
   tstcs->certIndx = 0;
   tstcs->certUri[0] = tstcs->certCredRef[0] = tstcs->certPass[0] = '\0';
-  memset( tstcs->certStat, 0, sizeof(tstcs->certStat) );
+  if ( tstcs->certStat != NULL ) {
+    memset( tstcs->certStat, 0, tstcs->certStatCnt * sizeof(*tstcs->certStat) );
+    memset( tstcs->certPrint, 0, tstcs->certStatCnt * sizeof(*tstcs->certPrint) );
+  }
 }
 
 // allocate and initialize a certsel test object
@@ -928,10 +1566,15 @@ static rdkcertselector_t *ut_newcs( void ) {
   return tstcs;
 }
 
-static char statstr[PARAM_MAX] = "";
+static char statstr[LIST_MAX*21] = "";  // "|" and up to 20 characters per entry
 char *ut_statstr( rdkcertselector_h cs ) {
-  sprintf( statstr, "%ld|%ld|%ld|%ld|%ld|%ld",
-           cs->certStat[0],cs->certStat[1],cs->certStat[2],cs->certStat[3],cs->certStat[4],cs->certStat[5]);
+  // first LIST_MAX entries, always allocated once the table is loaded
+  size_t statlen = 0;
+  uint32_t indx;
+  statstr[0] = '\0';
+  for ( indx = 0; indx < LIST_MAX && indx < cs->certStatCnt; indx++ ) {
+    statlen += snprintf( statstr + statlen, sizeof(statstr) - statlen, indx == 0 ? "%ld" : "|%ld", cs->certStat[indx] );
+  }
   return statstr;
 }
 
@@ -1109,8 +1752,8 @@ static void ut_certsel_findCert( void ) {
   ut_initcs( tstcs );
   strncpy( tstcs->certSelPath, UTDIR "/tst1miss5.cfg", PATH_MAX );
   UT_INTCMP( certsel_findCert( tstcs ), certselectorFileError );
-  // beyond max
-  UT_LOG( "Expect 1 error messages for max" );
+  // beyond the last candidate
+  UT_LOG( "Expect 0 error messages for beyond last" );
   ut_initcs( tstcs );
   tstcs->certIndx = LIST_MAX;
   UT_INTCMP( certsel_findCert( tstcs ), certselectorFileNotFound );
@@ -1141,7 +1784,7 @@ static void ut_certsel_findCert( void ) {
   tstcs->certIndx = 3;
   UT_INTCMP( certsel_findCert( tstcs ), certselectorFileNotFound );
 
-  free( tstcs );
+  rdkcertselector_free( &tstcs );
 
   UT_END( __FUNCTION__ );
 } // ut_certsel_findCert( void )
@@ -1461,7 +2104,7 @@ static void ut_rdkcertselector_getCert( void ) {
   UT_STRCMP( certPass, "pc3pass", PARAM_MAX );
   rdkcertselector_free( &tstcs1 );
 
-  // up to 10 groups in the first field
+  // several groups in the first field
   UT_LOG( "multi group" );
   tstcs1 = rdkcertselector_new(  certsel_path, DEFAULT_HROT, "A1" );
   UT_INTCMP( rdkcertselector_getCert( tstcs1, &certUri, &certPass ), certselectorOk );
@@ -1593,6 +2236,19 @@ static void ut_rdkcertselector_setCurlStatus( void ) {
   UT_STRCMP( tstcs1->certCredRef, UTCRED1, PARAM_MAX );
   rdkcertselector_free( &tstcs1 );
 
+  // cert released without a status, e.g. hrot engine not found; not marked bad
+  tstcs1 = rdkcertselector_new(  certsel_path, DEFAULT_HROT, GRP1 );
+  tstcs1->state = cssReadyToCheckCert;
+  tstcs1->certPass[0] = 'P';
+  rdkcertselector_releaseCert( tstcs1 );
+  UT_INTCMP( tstcs1->certStat[0], CERTSTAT_NOTBAD );
+  UT_INTCMP( tstcs1->certPass[0], 0 ); // password wiped
+  UT_INTCMP( tstcs1->certIndx, 0 );
+  UT_INTCMP( tstcs1->state, cssReadyToGiveCert );
+  rdkcertselector_releaseCert( tstcs1 ); // wrong state, no change
+  UT_INTCMP( tstcs1->state, cssReadyToGiveCert );
+  rdkcertselector_free( &tstcs1 );
+
   UT_END( __FUNCTION__ );
 }
 
@@ -1714,7 +2370,7 @@ static void ut_rdkcertselector_seq3( void ) {
 
   // 2) first renewed, uses first
   sleep( 1 ); // delay so file time is "old"
-  UT_SYSTEM0( "touch " UTCERT1 ); // first renewed
+  UT_SYSTEM0( "echo renewed >> " UTCERT1 ); // first renewed, content changed
   UT_TST( ut_getThenSet( seq1cs, CURL_SUCCESS, FILESCHEME UTCERT1, UTPASS1, NO_RETRY ) );
 
   // 3) uses first
@@ -1744,7 +2400,7 @@ static void ut_rdkcertselector_seq4( void ) {
   UT_TST( ut_getThenSet( seq1cs, CURL_SUCCESS, FILESCHEME UTCERT3, UTPASS3, NO_RETRY ) );
 
   // 2) second restored, use second
-  UT_SYSTEM0( "touch " UTCERT2 );
+  UT_SYSTEM0( "echo renewed >> " UTCERT2 );
   UT_TST( ut_getThenSet( seq1cs, CURL_SUCCESS, FILESCHEME UTCERT2, UTPASS2, NO_RETRY ) );
 
   // 3) next try skips first, uses second
@@ -0,0 +1,449 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef RDKLOGGER
+    #include "rdk_debug.h"
+    #define LOG_LIB "LOG.RDK.CERTSELECTOR"
+#else
+    #define RDK_LOG(a1, a2, args...) fprintf(stderr, args)
+    #define RDK_LOG_INFO 0
+    #define RDK_LOG_ERROR 0
+    #define RDK_LOG_DEBUG 0
+    #define LOG_LIB 0
+#endif
+
+#define ERROR_LOG(...) RDK_LOG(RDK_LOG_ERROR, LOG_LIB, __VA_ARGS__)
+#define DEBUG_LOG(...) RDK_LOG(RDK_LOG_INFO, LOG_LIB, __VA_ARGS__)
+#define EXTRA_DEBUG_LOG(...) RDK_LOG(RDK_LOG_DEBUG, LOG_LIB, __VA_ARGS__)
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "rdkcertselector_curl.h"
+
+#define FILESCHEME "file://"
+#define PEM_BEGIN "-----BEGIN"
+
+static pthread_mutex_t perfLock = PTHREAD_MUTEX_INITIALIZER;
+static rdkcertselectorPerformCounters_t perfCounters;  // protected by perfLock
+
+// tls session cache of a cert, a curl share handle sharing ssl sessions; curl keys the sessions by host and port
+// an entry is for one version of a cert file; when the file changes, or the cert is rejected, the entry is retired
+// and its sessions are freed once no transfer uses them
+#define SESSION_MAX 32
+typedef struct certcurlSession_s {
+  char certFile[PATH_MAX+1];
+  uint64_t print;                    // content hash of the cert file, see certcurl_print
+  CURLSH *share;
+  pthread_mutex_t shareLock;         // for the curl lock callbacks
+  unsigned int refCnt;               // transfers using the share
+  int retired;                       // not in the table, freed when refCnt drops to 0
+  unsigned long lastUse;
+} certcurlSession_t;
+
+static pthread_mutex_t sessLock = PTHREAD_MUTEX_INITIALIZER;
+static certcurlSession_t *sessions[SESSION_MAX];       // protected by sessLock
+static unsigned long sessClock;                        // protected by sessLock
+
+// rdkcertselector_releaseCert - from rdkcertselector.c.  Not exposed in header
+void rdkcertselector_releaseCert( rdkcertselector_h thiscertsel );
+static rdkcertselectorStatus_t certcurl_apply( rdkcertselector_h thiscertsel, CURL *easy, const char **certFileOut, uint64_t *printOut );
+static uint64_t certcurl_print( const unsigned char *data, size_t len );
+static certcurlSession_t *certcurl_sessionGet( const char *certFile, uint64_t print );
+static void certcurl_sessionPut( certcurlSession_t *sess, int drop );
+static void certcurl_sessionFree( certcurlSession_t *sess );
+static void certcurl_lock( CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr );
+static void certcurl_unlock( CURL *handle, curl_lock_data data, void *userptr );
+static CURLcode certcurl_setFile( CURL *easy, const char *certFile );
+#if LIBCURL_VERSION_NUM >= 0x074700  // 7.71.0, CURLOPT_SSLCERT_BLOB
+static int certcurl_isPem( const unsigned char *data, size_t len );
+static CURLcode certcurl_setBlob( CURL *easy, const unsigned char *data, size_t len );
+#endif
+
+/**
+ *  Selects a cert and sets it, its passcode and the hrot engine on a curl easy handle.
+ *  In @param thiscertsel; cert selector handle.
+ *  In @param easy; curl easy handle.
+ *  @return 0/certselectorOk for success, non-zero values for the failure.
+**/
+rdkcertselectorStatus_t rdkcertselector_applyToCurl( rdkcertselector_h thiscertsel, CURL *easy ) {
+  const char *certFile = NULL;
+  uint64_t print = 0;
+  return certcurl_apply( thiscertsel, easy, &certFile, &print );
+} // rdkcertselector_applyToCurl( )
+
+/**
+ *  Performs a request with the certs of a cert selector, trying the next cert after a cert error.
+ *  In @param thiscertsel; cert selector handle.
+ *  In @param easy; curl easy handle, with the url and other options set.
+ *  Out @param httpCode; response code of the last attempt, 0 if none; may be NULL.
+ *  @return curl result of the last attempt, CURLE_SSL_CERTPROBLEM if no cert could be applied.
+**/
+CURLcode rdkcertselector_perform( rdkcertselector_h thiscertsel, CURL *easy, long *httpCode ) {
+  if ( httpCode != NULL ) {
+    *httpCode = 0;
+  }
+  if ( thiscertsel == NULL || easy == NULL ) {
+    ERROR_LOG( " %s:null argument(s)\n", __FUNCTION__ );
+    return CURLE_BAD_FUNCTION_ARGUMENT;
+  }
+
+  CURLcode rc = CURLE_SSL_CERTPROBLEM;
+  unsigned int attempt = 0;
+  rdkcertselectorRetry_t retry = NO_RETRY;
+  do {
+    const char *certFile = NULL;
+    uint64_t print = 0;
+    rdkcertselectorStatus_t certstat = certcurl_apply( thiscertsel, easy, &certFile, &print );
+    if ( certstat != certselectorOk ) {
+      ERROR_LOG( " %s:no cert applied (%d), attempt %u\n", __FUNCTION__, certstat, attempt+1 );
+      rc = CURLE_SSL_CERTPROBLEM;  // not the result of an earlier attempt
+      break;
+    }
+    attempt++;
+
+    // tls sessions of this cert, resumed by later transfers with the same cert and host
+    certcurlSession_t *sess = ( print != 0 ) ? certcurl_sessionGet( certFile, print ) : NULL;
+    if ( sess != NULL && curl_easy_setopt( easy, CURLOPT_SHARE, sess->share ) != CURLE_OK ) {
+      certcurl_sessionPut( sess, 0 );
+      sess = NULL;
+    }
+
+    // same easy handle for every attempt, curl keeps its connection cache and settings
+    struct timespec start, end;
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    rc = curl_easy_perform( easy );
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    unsigned long usec = (unsigned long)( (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000 );
+
+    long code = 0;
+    curl_easy_getinfo( easy, CURLINFO_RESPONSE_CODE, &code );
+    if ( httpCode != NULL ) {
+      *httpCode = code;
+    }
+    char *url = NULL;
+    curl_easy_getinfo( easy, CURLINFO_EFFECTIVE_URL, &url );
+    DEBUG_LOG( " %s:attempt %u, curl (%d), http %ld, %lu us [%s]\n", __FUNCTION__, attempt, (int)rc, code, usec, certFile );
+
+    pthread_mutex_lock( &perfLock );
+    perfCounters.attempts++;
+    if ( attempt > 1 ) {
+      perfCounters.retries++;
+    }
+    perfCounters.attemptUsec += usec;
+    if ( usec > perfCounters.maxAttemptUsec ) {
+      perfCounters.maxAttemptUsec = usec;
+    }
+    pthread_mutex_unlock( &perfLock );
+
+    retry = rdkcertselector_setCurlStatus( thiscertsel, (unsigned int)rc, url );
+    if ( sess != NULL ) {
+      curl_easy_setopt( easy, CURLOPT_SHARE, NULL );
+      certcurl_sessionPut( sess, retry == TRY_ANOTHER );  // cert rejected, its sessions go with it
+    }
+  } while ( retry == TRY_ANOTHER );
+
+  pthread_mutex_lock( &perfLock );
+  perfCounters.performs++;
+  pthread_mutex_unlock( &perfLock );
+  return rc;
+} // rdkcertselector_perform( )
+
+/**
+ *  Gets the rdkcertselector_perform counters, totals for the process.
+ *  Out @param counters; counter values.
+**/
+void rdkcertselector_getPerformCounters( rdkcertselectorPerformCounters_t *counters ) {
+  if ( counters == NULL ) {
+    return;
+  }
+  pthread_mutex_lock( &perfLock );
+  *counters = perfCounters;
+  pthread_mutex_unlock( &perfLock );
+} // rdkcertselector_getPerformCounters( )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// getCert and set the cert on the easy handle; certFileOut is the path of the cert, valid until the next getCert
+// printOut is the content hash of the cert, 0 if the file could not be read
+static rdkcertselectorStatus_t certcurl_apply( rdkcertselector_h thiscertsel, CURL *easy, const char **certFileOut, uint64_t *printOut ) {
+  if ( thiscertsel == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certselectorBadPointer;
+  }
+  if ( easy == NULL ) {
+    ERROR_LOG( " %s:null argument(s)\n", __FUNCTION__ );
+    return certselectorBadArgument;
+  }
+
+  char *certUri = NULL, *certPass = NULL;
+  rdkcertselectorStatus_t retval = rdkcertselector_getCert( thiscertsel, &certUri, &certPass );
+  if ( retval != certselectorOk ) {
+    return retval;
+  }
+  const char *certFile = certUri;
+  // strip off uri scheme "file://"
+  if ( strncmp( certFile, FILESCHEME, sizeof(FILESCHEME)-1 ) == 0 ) {
+    certFile += (sizeof(FILESCHEME)-1);
+  }
+
+  const unsigned char *data = NULL;
+  size_t len = 0;
+  if ( rdkcertselector_getCertBlob( thiscertsel, &data, &len ) != certselectorOk ) {
+    data = NULL;
+  }
+  *printOut = ( data != NULL ) ? certcurl_print( data, len ) : 0;
+
+  CURLcode rc = CURLE_OK;
+  char *engine = rdkcertselector_getEngine( thiscertsel );
+  if ( engine != NULL ) {
+    // the engine loads the key, give it the file
+    rc = curl_easy_setopt( easy, CURLOPT_SSLENGINE, engine );
+    if ( rc == CURLE_OK ) {
+      rc = curl_easy_setopt( easy, CURLOPT_SSLENGINE_DEFAULT, 1L );
+    }
+    if ( rc == CURLE_OK ) {
+      rc = certcurl_setFile( easy, certFile );
+    }
+  } else {
+#if LIBCURL_VERSION_NUM >= 0x074700
+    if ( data != NULL ) {
+      rc = certcurl_setBlob( easy, data, len );
+    } else {
+      rc = certcurl_setFile( easy, certFile );  // curl reports the file error
+    }
+#else
+    rc = certcurl_setFile( easy, certFile );
+#endif
+  }
+  if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_KEYPASSWD, certPass );
+  }
+
+  if ( rc != CURLE_OK ) {
+    ERROR_LOG( " %s:curl option not set (%d) [%s]\n", __FUNCTION__, (int)rc, certFile );
+    // not a status of the cert, e.g. engine not found; released without marking it bad
+    rdkcertselector_releaseCert( thiscertsel );
+    return certselectorGeneralFailure;
+  }
+  EXTRA_DEBUG_LOG( " %s:cert set [%s]\n", __FUNCTION__, certFile );
+  *certFileOut = certFile;
+  return certselectorOk;
+}
+
+// set the cert by path, for an hrot engine or a libcurl without blob support
+// a blob takes precedence over a path, so blobs from an earlier cert on the same handle are cleared
+static CURLcode certcurl_setFile( CURL *easy, const char *certFile ) {
+  CURLcode rc = CURLE_OK;
+#if LIBCURL_VERSION_NUM >= 0x074700
+  rc = curl_easy_setopt( easy, CURLOPT_SSLCERT_BLOB, NULL );
+  if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLKEY_BLOB, NULL );
+  }
+  if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLCERTTYPE, "P12" );
+  }
+#else
+  rc = curl_easy_setopt( easy, CURLOPT_SSLCERTTYPE, "P12" );
+#endif
+  if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLCERT, certFile );
+  }
+  return rc;
+}
+
+#if LIBCURL_VERSION_NUM >= 0x074700  // 7.71.0, CURLOPT_SSLCERT_BLOB
+// true if the file is PEM; a PEM file may start with bag attributes, PKCS#12 is binary DER
+static int certcurl_isPem( const unsigned char *data, size_t len ) {
+  size_t plen = sizeof(PEM_BEGIN)-1;
+  for ( size_t i = 0; i + plen <= len; i++ ) {
+    if ( data[i] == '-' && memcmp( data+i, PEM_BEGIN, plen ) == 0 ) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// set the cert from memory; a PEM file has the key too, a PKCS#12 file is decoded with the passcode
+static CURLcode certcurl_setBlob( CURL *easy, const unsigned char *data, size_t len ) {
+  struct curl_blob blob;
+  blob.data = (void *)data;
+  blob.len = len;
+  blob.flags = CURL_BLOB_COPY;
+  int pem = certcurl_isPem( data, len );
+
+  CURLcode rc = curl_easy_setopt( easy, CURLOPT_SSLCERTTYPE, pem ? "PEM" : "P12" );
+  if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLCERT_BLOB, &blob );
+  }
+  if ( rc == CURLE_OK && pem ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLKEYTYPE, "PEM" );
+    if ( rc == CURLE_OK ) {
+      rc = curl_easy_setopt( easy, CURLOPT_SSLKEY_BLOB, &blob );
+    }
+  } else if ( rc == CURLE_OK ) {
+    rc = curl_easy_setopt( easy, CURLOPT_SSLKEY_BLOB, NULL );  // from an earlier PEM cert
+  }
+  return rc;
+}
+#endif
+
+// FNV-1a 64 of the cert content, never 0
+static uint64_t certcurl_print( const unsigned char *data, size_t len ) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for ( size_t i = 0; i < len; i++ ) {
+    hash ^= data[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return ( hash != 0 ) ? hash : 1;
+}
+
+// get the session cache entry of a cert with a reference, creating it if needed
+// an entry for an older version of the cert file is retired; returns NULL if a share handle can't be made
+static certcurlSession_t *certcurl_sessionGet( const char *certFile, uint64_t print ) {
+  certcurlSession_t *sess = NULL, *old = NULL, *evicted = NULL;
+  int slot = -1, lru = -1;
+  unsigned long drops = 0, created = 0;
+
+  pthread_mutex_lock( &sessLock );
+  sessClock++;
+  for ( int indx = 0; indx < SESSION_MAX; indx++ ) {
+    certcurlSession_t *entry = sessions[indx];
+    if ( entry == NULL ) {
+      if ( slot < 0 ) slot = indx;
+      continue;
+    }
+    if ( strcmp( entry->certFile, certFile ) == 0 ) {
+      if ( entry->print == print ) {
+        sess = entry;
+        break;
+      }
+      // cert renewed, sessions of the old cert are not resumed
+      EXTRA_DEBUG_LOG( " %s:cert changed, sessions dropped [%s]\n", __FUNCTION__, certFile );
+      sessions[indx] = NULL;
+      entry->retired = 1;
+      if ( entry->refCnt == 0 ) old = entry;
+      drops++;
+      if ( slot < 0 ) slot = indx;
+      continue;
+    }
+    if ( entry->refCnt == 0 && ( lru < 0 || entry->lastUse < sessions[lru]->lastUse ) ) {
+      lru = indx;
+    }
+  }
+  if ( sess == NULL ) {
+    if ( slot < 0 && lru >= 0 ) {
+      evicted = sessions[lru];
+      sessions[lru] = NULL;
+      slot = lru;
+    }
+    if ( slot >= 0 ) {
+      sess = (certcurlSession_t *)calloc( 1, sizeof(certcurlSession_t) );
+      if ( sess != NULL ) {
+        snprintf( sess->certFile, sizeof(sess->certFile), "%s", certFile );
+        sess->print = print;
+        pthread_mutex_init( &sess->shareLock, NULL );
+        sess->share = curl_share_init();
+        if ( sess->share == NULL ||
+             curl_share_setopt( sess->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION ) != CURLSHE_OK ||
+             curl_share_setopt( sess->share, CURLSHOPT_LOCKFUNC, certcurl_lock ) != CURLSHE_OK ||
+             curl_share_setopt( sess->share, CURLSHOPT_UNLOCKFUNC, certcurl_unlock ) != CURLSHE_OK ||
+             curl_share_setopt( sess->share, CURLSHOPT_USERDATA, sess ) != CURLSHE_OK ) {
+          ERROR_LOG( " %s:session cache not set up [%s]\n", __FUNCTION__, certFile );
+          certcurl_sessionFree( sess );
+          sess = NULL;
+        } else {
+          sessions[slot] = sess;
+          created++;
+        }
+      }
+    }
+  }
+  if ( sess != NULL ) {
+    sess->refCnt++;
+    sess->lastUse = sessClock;
+  }
+  pthread_mutex_unlock( &sessLock );
+
+  certcurl_sessionFree( old );
+  certcurl_sessionFree( evicted );
+  if ( drops != 0 || created != 0 ) {
+    pthread_mutex_lock( &perfLock );
+    perfCounters.sessionCaches += created;
+    perfCounters.sessionDrops += drops;
+    pthread_mutex_unlock( &perfLock );
+  }
+  return sess;
+}
+
+// release a reference to a session cache entry; with drop, the entry is retired
+static void certcurl_sessionPut( certcurlSession_t *sess, int drop ) {
+  int dropped = 0, last = 0;
+  pthread_mutex_lock( &sessLock );
+  if ( drop && !sess->retired ) {
+    for ( int indx = 0; indx < SESSION_MAX; indx++ ) {
+      if ( sessions[indx] == sess ) {
+        sessions[indx] = NULL;
+        break;
+      }
+    }
+    sess->retired = 1;
+    dropped = 1;
+  }
+  sess->refCnt--;
+  last = ( sess->retired && sess->refCnt == 0 );
+  pthread_mutex_unlock( &sessLock );
+
+  if ( dropped ) {
+    EXTRA_DEBUG_LOG( " %s:cert rejected, sessions dropped [%s]\n", __FUNCTION__, sess->certFile );
+    pthread_mutex_lock( &perfLock );
+    perfCounters.sessionDrops++;
+    pthread_mutex_unlock( &perfLock );
+  }
+  if ( last ) {
+    certcurl_sessionFree( sess );
+  }
+}
+
+// free an entry no transfer uses; NULL is ignored
+static void certcurl_sessionFree( certcurlSession_t *sess ) {
+  if ( sess == NULL ) {
+    return;
+  }
+  if ( sess->share != NULL ) {
+    curl_share_cleanup( sess->share );
+  }
+  pthread_mutex_destroy( &sess->shareLock );
+  free( sess );
+}
+
+static void certcurl_lock( CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr ) {
+  (void)handle; (void)data; (void)access;
+  pthread_mutex_lock( &((certcurlSession_t *)userptr)->shareLock );
+}
+
+static void certcurl_unlock( CURL *handle, curl_lock_data data, void *userptr ) {
+  (void)handle; (void)data;
+  pthread_mutex_unlock( &((certcurlSession_t *)userptr)->shareLock );
+}
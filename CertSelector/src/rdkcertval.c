@@ -0,0 +1,397 @@
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifdef RDKLOGGER
+    #include "rdk_debug.h"
+    #define LOG_LIB "LOG.RDK.CERTSELECTOR"
+#else
+    #define RDK_LOG(a1, a2, args...) fprintf(stderr, args)
+    #define RDK_LOG_INFO 0
+    #define RDK_LOG_ERROR 0
+    #define RDK_LOG_DEBUG 0
+    #define LOG_LIB 0
+#endif
+
+#define ERROR_LOG(...) RDK_LOG(RDK_LOG_ERROR, LOG_LIB, __VA_ARGS__)
+#define DEBUG_LOG(...) RDK_LOG(RDK_LOG_INFO, LOG_LIB, __VA_ARGS__)
+#define EXTRA_DEBUG_LOG(...) RDK_LOG(RDK_LOG_DEBUG, LOG_LIB, __VA_ARGS__)
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/pem.h>
+#include <openssl/pkcs12.h>
+#include <openssl/rand.h>
+#include <openssl/x509.h>
+
+#include "rdkcertval.h"
+
+// what parsing a cert file found, the verdict is computed from it against the current time
+typedef struct certval_ent_s {
+  char *path;
+  uint32_t pathHash;
+  uint64_t contentHash;         // content the result is for, see rdkcertcfg_certHash
+  uint64_t passHash;            // passcode the result is for, keyed hash, see certval_passHash
+  rdkcertvalVerdict_t result;   // certvalOk, certvalCorrupt or certvalKeyMismatch
+  time_t notBefore;
+  time_t notAfter;
+  EVP_PKEY *pkey;               // decoded objects if the result is certvalOk, handed out with a new reference
+  X509 *cert;
+  STACK_OF(X509) *chain;
+  struct certval_ent_s *next;
+} certval_ent_t;
+
+#define CERTVAL_MAX 256         // cache is emptied when it grows past this many paths
+#define CERTVAL_BUCKETS 64
+
+static pthread_mutex_t certval_lock = PTHREAD_MUTEX_INITIALIZER;
+static certval_ent_t *certval_ents[CERTVAL_BUCKETS];
+static unsigned int certval_entCnt = 0;
+static rdkcertvalCounters_t certval_counters;
+
+#define CERTVAL_COUNT( ctr ) __atomic_add_fetch( &certval_counters.ctr, 1, __ATOMIC_RELAXED )
+
+// key of the passcode hash, random per process, in a page left out of core dumps and locked if it can be
+#define CERTVAL_KEYSZ 32
+static pthread_once_t certval_keyOnce = PTHREAD_ONCE_INIT;
+static unsigned char *certval_key;
+
+static void certval_keyInit( void ) {
+  long pagesz = sysconf( _SC_PAGESIZE );
+  void *map = mmap( NULL, pagesz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+  if ( map == MAP_FAILED ) {
+    ERROR_LOG( " %s:key not mapped (%d)\n", __FUNCTION__, errno );
+    return;
+  }
+#ifdef MADV_DONTDUMP
+  madvise( map, pagesz, MADV_DONTDUMP );
+#endif
+  mlock( map, pagesz );
+  if ( RAND_bytes( (unsigned char *)map, CERTVAL_KEYSZ ) != 1 ) {
+    ERROR_LOG( " %s:no random key\n", __FUNCTION__ );
+    munmap( map, pagesz );
+    return;
+  }
+  certval_key = (unsigned char *)map;
+}
+
+// keyed hash of a passcode, so the cache can tell passcodes apart without a digest that can be brute forced offline
+// returns 0, or -1 if there is no key; the result is not cached then
+static int certval_passHash( const char *certPass, uint64_t *passHash ) {
+  pthread_once( &certval_keyOnce, certval_keyInit );
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int mdLen = 0;
+  if ( certval_key == NULL ||
+       HMAC( EVP_sha256(), certval_key, CERTVAL_KEYSZ, (const unsigned char *)certPass, strlen( certPass ), md, &mdLen ) == NULL ||
+       mdLen < sizeof(*passHash) ) {
+    return -1;
+  }
+  memcpy( passHash, md, sizeof(*passHash) );
+  return 0;
+}
+
+static uint64_t certval_hash( const char *str ) {
+  uint64_t hash = 14695981039346656037ull;  // FNV-1a
+  while ( *str != '\0' ) {
+    hash ^= (unsigned char)*str++;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// convert a cert time to seconds since the epoch; 0 if it can't be converted
+static time_t certval_time( const ASN1_TIME *asn1Time ) {
+  struct tm tm;
+  memset( &tm, 0, sizeof(tm) );
+  if ( asn1Time == NULL || ASN1_TIME_to_tm( asn1Time, &tm ) != 1 ) {
+    return 0;
+  }
+  return timegm( &tm );
+}
+
+static void certval_freeObjs( EVP_PKEY *pkey, X509 *cert, STACK_OF(X509) *chain ) {
+  sk_X509_pop_free( chain, X509_free );
+  X509_free( cert );
+  EVP_PKEY_free( pkey );
+}
+
+// new references to the objects of a cache entry, called with certval_lock held
+static void certval_refObjs( certval_ent_t *ent, EVP_PKEY **pkey, X509 **cert, STACK_OF(X509) **chain ) {
+  if ( ent->pkey != NULL && EVP_PKEY_up_ref( ent->pkey ) == 1 ) {
+    *pkey = ent->pkey;
+  }
+  if ( X509_up_ref( ent->cert ) == 1 ) {
+    *cert = ent->cert;
+  }
+  if ( ent->chain != NULL ) {
+    *chain = X509_chain_up_ref( ent->chain );
+  }
+}
+
+// parse the content of a cert file as PKCS#12, or failing that as PEM, and check the key against the cert
+// if the result is certvalOk, the decoded objects are returned, otherwise they are freed
+static rdkcertvalVerdict_t certval_parse( const rdkcertcfgBlob_t *blob, const char *certPass, time_t *notBefore, time_t *notAfter,
+                                          EVP_PKEY **pkeyOut, X509 **certOut, STACK_OF(X509) **chainOut ) {
+  BIO *bio = BIO_new_mem_buf( blob->data, (int)blob->len );
+  if ( bio == NULL ) {
+    ERR_clear_error();
+    return certvalUnknown;
+  }
+  X509 *cert = NULL;
+  EVP_PKEY *pkey = NULL;
+  STACK_OF(X509) *ca = NULL;
+  int keyChecked = 1;
+  rdkcertvalVerdict_t result = certvalCorrupt;
+
+  PKCS12 *p12 = d2i_PKCS12_bio( bio, NULL );
+  if ( p12 != NULL ) {
+    if ( PKCS12_parse( p12, certPass, &pkey, &cert, &ca ) != 1 ) {
+      cert = NULL;
+      pkey = NULL;
+    }
+    PKCS12_free( p12 );
+  } else if ( BIO_reset( bio ) == 0 && ( cert = PEM_read_bio_X509( bio, NULL, NULL, NULL ) ) != NULL ) {
+    // the rest of the certs are the chain; the key may be before the cert in the file, or not in the file at all
+    X509 *caCert;
+    while ( ( caCert = PEM_read_bio_X509( bio, NULL, NULL, NULL ) ) != NULL ) {
+      if ( ca == NULL ) {
+        ca = sk_X509_new_null();
+      }
+      if ( ca == NULL || sk_X509_push( ca, caCert ) == 0 ) {
+        X509_free( caCert );
+        break;
+      }
+    }
+    ERR_clear_error();
+    if ( BIO_reset( bio ) == 0 ) {
+      pkey = PEM_read_bio_PrivateKey( bio, NULL, NULL, (void *)certPass );
+    }
+    if ( pkey == NULL && ERR_GET_REASON( ERR_peek_last_error() ) == PEM_R_NO_START_LINE ) {
+      keyChecked = 0;
+    }
+  }
+
+  if ( cert != NULL && ( pkey != NULL || !keyChecked ) ) {
+    *notBefore = certval_time( X509_get0_notBefore( cert ) );
+    *notAfter = certval_time( X509_get0_notAfter( cert ) );
+    if ( keyChecked && X509_check_private_key( cert, pkey ) != 1 ) {
+      result = certvalKeyMismatch;
+    } else {
+      result = certvalOk;
+    }
+  }
+
+  if ( result == certvalOk ) {
+    if ( ca != NULL && sk_X509_num( ca ) == 0 ) {
+      sk_X509_free( ca );
+      ca = NULL;
+    }
+    *pkeyOut = pkey;
+    *certOut = cert;
+    *chainOut = ca;
+  } else {
+    certval_freeObjs( pkey, cert, ca );
+  }
+  BIO_free( bio );
+  ERR_clear_error();
+  return result;
+} // certval_parse( )
+
+// check a cert file, from the cache if its content and passcode are unchanged; with pkey set, also get the objects
+static rdkcertvalVerdict_t certval_lookup( const rdkcertcfg_t *cfg, const char *certFile, const char *certPass,
+                                           EVP_PKEY **pkey, X509 **cert, STACK_OF(X509) **chain ) {
+  CERTVAL_COUNT( checks );
+
+  // the content hash is cached with the file metadata, so an unchanged file is not read again
+  rdkcertcfgCertMeta_t meta;
+  uint64_t contentHash;
+  if ( rdkcertcfg_certHash( cfg, certFile, &meta, &contentHash ) != certcfgOk ) {
+    return certvalUnknown;
+  }
+  uint64_t passHash = 0;
+  int passHashed = ( certval_passHash( certPass, &passHash ) == 0 );
+  uint32_t pathHash = (uint32_t)certval_hash( certFile );
+  certval_ent_t **bucket = &certval_ents[pathHash % CERTVAL_BUCKETS];
+
+  rdkcertvalVerdict_t result = certvalUnknown;
+  time_t notBefore = 0, notAfter = 0;
+  int cached = 0;
+  pthread_mutex_lock( &certval_lock );
+  certval_ent_t *ent = *bucket;
+  while ( ent != NULL && ( ent->pathHash != pathHash || strcmp( ent->path, certFile ) != 0 ) ) {
+    ent = ent->next;
+  }
+  if ( ent != NULL && passHashed && ent->contentHash == contentHash && ent->passHash == passHash ) {
+    result = ent->result;
+    notBefore = ent->notBefore;
+    notAfter = ent->notAfter;
+    if ( pkey != NULL && result == certvalOk ) {
+      certval_refObjs( ent, pkey, cert, chain );
+    }
+    cached = 1;
+  }
+  pthread_mutex_unlock( &certval_lock );
+
+  if ( !cached ) {
+    EVP_PKEY *newPkey = NULL;
+    X509 *newCert = NULL;
+    STACK_OF(X509) *newChain = NULL;
+    // parse the content that was hashed; if the file changed since, it is checked again next time
+    rdkcertcfgBlob_t *blob = NULL;
+    if ( rdkcertcfg_certBlob( cfg, certFile, &blob ) != certcfgOk || !rdkcertcfg_sameId( &blob->id, &meta.id ) ) {
+      rdkcertcfg_releaseBlob( &blob );
+      return certvalUnknown;  // not readable, or changed, not cached
+    }
+    CERTVAL_COUNT( parses );
+    result = certval_parse( blob, certPass, &notBefore, &notAfter, &newPkey, &newCert, &newChain );
+    rdkcertcfg_releaseBlob( &blob );
+    if ( result == certvalUnknown ) {
+      return result;  // not readable, not cached
+    }
+    EXTRA_DEBUG_LOG( " %s:parsed [%s] %s\n", __FUNCTION__, certFile, rdkcertval_name( result ) );
+
+    pthread_mutex_lock( &certval_lock );
+    ent = *bucket;
+    while ( ent != NULL && ( ent->pathHash != pathHash || strcmp( ent->path, certFile ) != 0 ) ) {
+      ent = ent->next;
+    }
+    if ( ent == NULL && passHashed ) {
+      if ( certval_entCnt >= CERTVAL_MAX ) {
+        size_t bucketIndx;
+        for ( bucketIndx = 0; bucketIndx < CERTVAL_BUCKETS; bucketIndx++ ) {
+          while ( certval_ents[bucketIndx] != NULL ) {
+            certval_ent_t *oldent = certval_ents[bucketIndx];
+            certval_ents[bucketIndx] = oldent->next;
+            certval_freeObjs( oldent->pkey, oldent->cert, oldent->chain );
+            free( oldent->path );
+            free( oldent );
+          }
+        }
+        certval_entCnt = 0;
+      }
+      ent = (certval_ent_t *)calloc( 1, sizeof(certval_ent_t) );
+      if ( ent != NULL && ( ent->path = strdup( certFile ) ) == NULL ) {
+        free( ent );
+        ent = NULL;
+      }
+      if ( ent != NULL ) {
+        ent->pathHash = pathHash;
+        ent->next = *bucket;
+        *bucket = ent;
+        certval_entCnt++;
+      }
+    }
+    if ( ent != NULL && passHashed ) {  // not cached if out of memory, or without a passcode hash
+      certval_freeObjs( ent->pkey, ent->cert, ent->chain );
+      ent->contentHash = contentHash;
+      ent->passHash = passHash;
+      ent->result = result;
+      ent->notBefore = notBefore;
+      ent->notAfter = notAfter;
+      ent->pkey = newPkey;
+      ent->cert = newCert;
+      ent->chain = newChain;
+      if ( pkey != NULL && result == certvalOk ) {
+        certval_refObjs( ent, pkey, cert, chain );
+      }
+    } else if ( pkey != NULL && result == certvalOk ) {
+      *pkey = newPkey;
+      *cert = newCert;
+      *chain = newChain;
+    } else {
+      certval_freeObjs( newPkey, newCert, newChain );
+    }
+    pthread_mutex_unlock( &certval_lock );
+  }
+
+  // the validity period is checked now, so a cached result does not go stale
+  if ( result == certvalOk ) {
+    time_t now = time( NULL );
+    if ( notBefore != 0 && now < notBefore ) {
+      result = certvalNotYetValid;
+    } else if ( notAfter != 0 && now > notAfter ) {
+      result = certvalExpired;
+    }
+  }
+  if ( result != certvalOk ) {
+    CERTVAL_COUNT( rejects );
+  }
+  return result;
+} // certval_lookup( )
+
+rdkcertvalVerdict_t rdkcertval_check( const rdkcertcfg_t *cfg, const char *certFile, const char *certPass ) {
+  if ( certFile == NULL || certPass == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certvalUnknown;
+  }
+  return certval_lookup( cfg, certFile, certPass, NULL, NULL, NULL );
+} // rdkcertval_check( )
+
+rdkcertvalVerdict_t rdkcertval_load( const rdkcertcfg_t *cfg, const char *certFile, const char *certPass,
+                                     EVP_PKEY **pkey, X509 **cert, STACK_OF(X509) **chain ) {
+  if ( certFile == NULL || certPass == NULL || pkey == NULL || cert == NULL || chain == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return certvalUnknown;
+  }
+  *pkey = NULL;
+  *cert = NULL;
+  *chain = NULL;
+  rdkcertvalVerdict_t result = certval_lookup( cfg, certFile, certPass, pkey, cert, chain );
+  if ( *cert == NULL ) {
+    return ( result == certvalOk ) ? certvalUnknown : result;  // out of memory
+  }
+  return result;
+} // rdkcertval_load( )
+
+int rdkcertval_timeBound( rdkcertvalVerdict_t verdict ) {
+  return ( verdict == certvalNotYetValid || verdict == certvalExpired );
+}
+
+const char *rdkcertval_name( rdkcertvalVerdict_t verdict ) {
+  switch ( verdict ) {
+    case certvalOk: return "ok";
+    case certvalUnknown: return "unknown";
+    case certvalCorrupt: return "corrupt";
+    case certvalKeyMismatch: return "key mismatch";
+    case certvalNotYetValid: return "not yet valid";
+    case certvalExpired: return "expired";
+  }
+  return "invalid";
+}
+
+void rdkcertval_getCounters( rdkcertvalCounters_t *counters ) {
+  if ( counters == NULL ) {
+    ERROR_LOG( " %s:null argument\n", __FUNCTION__ );
+    return;
+  }
+  counters->checks = __atomic_load_n( &certval_counters.checks, __ATOMIC_RELAXED );
+  counters->parses = __atomic_load_n( &certval_counters.parses, __ATOMIC_RELAXED );
+  counters->rejects = __atomic_load_n( &certval_counters.rejects, __ATOMIC_RELAXED );
+}
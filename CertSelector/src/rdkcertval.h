@@ -0,0 +1,76 @@
+#ifndef __RDKCERTVAL__
+#define __RDKCERTVAL__
+
+/*
+ * Copyright 2025 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// internal api, used by the cert selector when built with RDKCERT_VALIDATION
+// checks a cert file with openssl before it is handed to curl: the file parses as PKCS#12 or PEM
+// with the passcode, the cert is within its validity period and the private key matches the cert
+// the result, and the decoded key and certs, are cached process wide, keyed by path and checked
+// against the file fingerprint, see rdkcertcfg_certHash
+
+#include <stdint.h>
+#include <time.h>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "rdkcertcfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    certvalOk=0,
+    certvalUnknown=1,          // file could not be read, nothing known about the cert
+    certvalCorrupt=2,          // not PKCS#12 or PEM, or can't be decrypted with the passcode
+    certvalKeyMismatch=3,      // private key does not belong to the cert
+    certvalNotYetValid=4,
+    certvalExpired=5,
+} rdkcertvalVerdict_t;
+
+// check a cert file with its passcode; a PEM cert without a private key, e.g. with the key in the hrot engine,
+// only has its validity period checked; the validity period is checked against now on every call
+// cfg is the config entry naming the cert, for the metadata cache, and may be NULL
+rdkcertvalVerdict_t rdkcertval_check( const rdkcertcfg_t *cfg, const char *certFile, const char *certPass );
+// check a cert file as rdkcertval_check, and get its decoded key, cert and CA chain, each with its own reference
+// pkey is NULL for a PEM cert without a private key; chain is NULL if the file has no CA certs
+// the objects are set if the verdict is certvalOk, certvalNotYetValid or certvalExpired, otherwise they are NULL
+rdkcertvalVerdict_t rdkcertval_load( const rdkcertcfg_t *cfg, const char *certFile, const char *certPass,
+                                     EVP_PKEY **pkey, X509 **cert, STACK_OF(X509) **chain );
+// true if the verdict is for the time of the check only; the cert may become usable without changing
+int rdkcertval_timeBound( rdkcertvalVerdict_t verdict );
+// short name of a verdict, for logging
+const char *rdkcertval_name( rdkcertvalVerdict_t verdict );
+
+// validation counters, totals for the process
+typedef struct rdkcertvalCounters_s {
+  unsigned long checks;         // calls to rdkcertval_check and rdkcertval_load
+  unsigned long parses;         // cert files parsed with openssl, the rest were answered from the cache
+  unsigned long rejects;        // checks that did not return certvalOk or certvalUnknown
+} rdkcertvalCounters_t;
+
+void rdkcertval_getCounters( rdkcertvalCounters_t *counters );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __RDKCERTVAL__
@@ -40,18 +40,74 @@ int rdkconfig_get( uint8_t **sbuff, size_t *sbuffsz, const char *refname );
 // return value: RDKCONFIG_OK or RDKCONFIG_FAIL
 int rdkconfig_getStr( char **strbuff, size_t *strbuffsz, const char *refname );
 
+// rdkconfig_getInto - get credential by reference name into caller buffer, no allocation
+// fills up to cap bytes of buf, no null terminator is added; returns size of data in len
+// if the data does not fit, len is the size needed and buf is not filled, otherwise on failure len is 0
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len );
+
+// one credential returned by rdkconfig_getMany
+typedef struct rdkconfig_buf_s {
+  uint8_t *buf;   // new buffer, data followed by a '\0' as with rdkconfig_getStr; NULL if not found
+  size_t len;     // size of data, not including the null terminator
+  int status;     // RDKCONFIG_OK or RDKCONFIG_FAIL
+} rdkconfig_buf_t;
+
+// rdkconfig_getMany - get n credentials by reference name in one call
+// the backend is opened and unlocked once for the set, instead of once per credential
+// out[i] is filled for refnames[i]; buffers must be released with rdkconfig_freeMany
+// return value: RDKCONFIG_OK if every credential was found, otherwise RDKCONFIG_FAIL, see status of each
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] );
+
+// rdkconfig_freeMany - wipe and free the n buffers returned by rdkconfig_getMany
+int rdkconfig_freeMany( rdkconfig_buf_t out[], size_t n );
+
 // rdkconfig_set - store credential by reference name
 // return value: RDKCONFIG_OK or RDKCONFIG_FAIL
 // (for string data, the null terminator does not need to be included in sbuffsz as long as
 //   it is retrieved using rdkconfig_getStr)
 int rdkconfig_set( const char *refname, uint8_t *sbuff, size_t sbuffsz );
 
+// streaming, for credentials too large to hold in memory, e.g. full chains and P12 bundles
+// data goes through a fixed size buffer a chunk at a time, so memory use does not depend on the size of the credential
+// (backends without streaming support fall back to rdkconfig_get/rdkconfig_set, which hold the whole credential)
+
+// rdkconfig_getToFd - get credential by reference name and write the data to file descriptor fd
+// nothing is written if the credential fails its integrity check
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getToFd( const char *refname, int fd );
+
+// rdkconfig_setFromFd - store credential by reference name, data read from file descriptor fd to end of file
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_setFromFd( const char *refname, int fd );
+
+// rdkconfig_setManyFromFd - store n credentials in one call, refnames[i] read from fds[i] to end of file
+// the backend is opened and written once for the set, instead of once per credential
+// status[i] is set for refnames[i]; a credential with fds[i] of -1 is not stored
+// return value: RDKCONFIG_OK if every credential was stored, otherwise RDKCONFIG_FAIL, see status of each
+int rdkconfig_setManyFromFd( const char **refnames, const int *fds, size_t n, int status[] );
+
 // rdkconfig_free - wipe and free buffer
 int rdkconfig_free( uint8_t **sbuff, size_t sbuffsz );
 
 // rdkconfig_freeStr - wipe and free string buffer
 int rdkconfig_freeStr( char **strbuff, size_t strbuffsz );
 
+// credential buffer counters, totals for the process
+// buffers are allocated from a locked arena of fixed size slots, reused after they are wiped
+typedef struct rdkconfigArenaCounters_s {
+  unsigned long allocs;       // credential buffers allocated
+  unsigned long arenaAllocs;  // allocated from the arena
+  unsigned long reuses;       // arena slots used again, the reuse rate is reuses/arenaAllocs
+  unsigned long heapAllocs;   // allocated from the heap; too large, arena full, or arena unavailable
+  unsigned long inUse;        // arena slots in use now
+  unsigned long highWater;    // most arena slots in use at once
+  unsigned long arenaBytes;   // locked arena size, 0 if the arena could not be locked
+} rdkconfigArenaCounters_t;
+
+// rdkconfig_getArenaCounters - get credential buffer counters
+void rdkconfig_getArenaCounters( rdkconfigArenaCounters_t *counters );
+
 #ifdef __cplusplus
 }
 #endif
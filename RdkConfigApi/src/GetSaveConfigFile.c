@@ -22,17 +22,29 @@
 #include <string.h>
 #include <stdint.h>
 #include <libgen.h> // for basename
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <time.h>
 #include "rdkconfig.h"
+#include "rdkconfig_credname.h"
 #define CMD_GCF "GetConfigFile"
 #define CMD_SCF "SaveConfigFile"
 #define MAX_CREDPATH 64
 #define MIN_CREDNAME 18 // 16 bytes + 1 prefix letter + 1 null term
 #define CN_SWITCH "--cn"
+#define CN_DUMP_SWITCH "--cn-dump"
 #define MAX_CREDNAME 64
-// getcredname - from RdkConfig.  Not exposed in header
-char *getcredname( char *credname, unsigned int credname_sz, const char *refname );
+#define BATCH_SWITCH "--batch"
+#define BATCH_STDOUT "stdout"
+#define BATCH_GROUPMAX 256 // credentials saved in one backend update, each has an open file
 static int GetConfigFile( const char *arg1, const char *arg2 );
-static int SaveConfigFile( const char *refname );
+static int SaveConfigFile( const char *arg1, const char *arg2 );
+static int GetConfigItem( const char *refname, const char *path );
+static int SaveConfigItem( const char *refname, const char *path );
+static int SaveConfigGroup( const char **refnames, const char **paths, size_t n, int status[] );
+static int ConfigBatch( const char *cmd, const char *manifest, int (*item)( const char *refname, const char *path ),
+                        int (*group)( const char **refnames, const char **paths, size_t n, int status[] ) );
 // GetConfigFile/SaveConfigFile - cli for rdkconfig api
 static int gcfmain( int argc, char *argv[] ) {
   const char *thiscmd = basename( argv[0]);
@@ -46,7 +58,7 @@ static int gcfmain( int argc, char *argv[] ) {
   }
   cmd = CMD_SCF;
   if ( strcmp( thiscmd, cmd ) == 0 ) {
-    return SaveConfigFile( argv[1] );
+    return SaveConfigFile( argv[1], argc>2?argv[2]:NULL );
   }
   return 1; // general error
 }
@@ -56,14 +68,22 @@ static int gcfmain( int argc, char *argv[] ) {
 // GetConfigFile <refname>
 // GetConfigFile <refname> stdout
 // GetConfigFile --cn <credname>
+// GetConfigFile --cn-dump
+// GetConfigFile --batch <manifest>
 static int GetConfigFile( const char *arg1, const char *arg2 ) {
   if ( arg1 == NULL ) return 1;
   char credname[MAX_CREDNAME+1];
   const char *cmd = CMD_GCF;
   const char *refname = NULL;
   int exitcd = 1; // default to error
-  // check for credname switch
-  if ( strcmp( arg1, CN_SWITCH ) == 0 ) {
+  // check for credname switches
+  if ( strcmp( arg1, CN_DUMP_SWITCH ) == 0 ) {
+    // every refname->credname of the map, in one pass
+    exitcd = ( getcrednames_dump( stdout ) < 0 ) ? 1 : 0;
+    if ( exitcd != 0 ) {
+      fprintf( stderr, "%s %s: error, unable to read credname map\n", cmd, CN_DUMP_SWITCH );
+    }
+  } else if ( strcmp( arg1, CN_SWITCH ) == 0 ) {
     if ( arg2 == NULL ) {
       fprintf( stderr, "%s %s: error, too few arguments\n", cmd, CN_SWITCH );
       return 1; // error
@@ -76,94 +96,234 @@ static int GetConfigFile( const char *arg1, const char *arg2 ) {
       fprintf( stderr, "%s->?\n", refname );
     }
     exitcd = 0; // success
+  } else if ( strcmp( arg1, BATCH_SWITCH ) == 0 ) {
+    if ( arg2 == NULL ) {
+      fprintf( stderr, "%s %s: error, too few arguments\n", cmd, BATCH_SWITCH );
+      return 1; // error
+    }
+    exitcd = ConfigBatch( cmd, arg2, GetConfigItem, NULL );
   } else {
-    // get the credential
-    uint8_t *membuff1 = NULL;
-    size_t memsz = 0;
-    // here first argument is refname, get the data
+    // here first argument is refname, written to a file of the same name or stdout
     refname = arg1;
-    int retval = rdkconfig_get( &membuff1, &memsz, refname );
-    if ( retval != RDKCONFIG_OK ) {
-      fprintf( stderr, "%s: error, unable to get\n", cmd );
-      return exitcd;
-    }
-    // check if output should go to stdout
-    if ( arg2 != NULL && strcmp( arg2, "stdout" ) == 0 ) {
-      refname = "/dev/stdout";
+    exitcd = GetConfigItem( refname, ( arg2 != NULL && strcmp( arg2, BATCH_STDOUT ) == 0 ) ? BATCH_STDOUT : refname );
+  }
+  return exitcd;
+}
+
+// get credential refname into file path, or to stdout if path is "stdout"
+static int GetConfigItem( const char *refname, const char *path ) {
+  const char *cmd = CMD_GCF;
+  int exitcd = 1; // default to error
+  // check if output should go to stdout
+  int tostdout = ( strcmp( path, BATCH_STDOUT ) == 0 );
+  // written to a temporary file renamed over path on success, so a failed get leaves an existing file as it was
+  char tmppath[PATH_MAX];
+  if ( !tostdout && snprintf( tmppath, sizeof(tmppath), "%s.tmp", path ) >= (int)sizeof(tmppath) ) {
+    fprintf( stderr, "%s: error, path too long\n", cmd );
+    return exitcd;
+  }
+  int wrfd = tostdout ? STDOUT_FILENO : open( tmppath, O_WRONLY|O_CREAT|O_TRUNC, 0600 );
+  if ( wrfd < 0 ) {
+    fprintf( stderr, "%s: error, unable to open\n", cmd );
+    return exitcd;
+  }
+  // get the data and write it a chunk at a time, any size
+  if ( rdkconfig_getToFd( refname, wrfd ) == RDKCONFIG_OK ) {
+    exitcd = 0; // sucess
+  } else {
+    fprintf( stderr, "%s: error, unable to get\n", cmd );
+  }
+  if ( !tostdout ) {
+    if ( close( wrfd ) != 0 && exitcd == 0 ) {
+      fprintf( stderr, "%s: error, unable to write\n", cmd );
+      exitcd = 1;
     }
-    // write data
-    FILE *wrfp = fopen( refname, "wb" );
-    if ( wrfp != NULL ) {
-      size_t wrsz = fwrite( membuff1, 1, memsz, wrfp );
-      fclose( wrfp );
-      if ( wrsz != memsz ) {
-        fprintf( stderr, "%s: error, unable to write (%zu!=%zu)\n", cmd, wrsz, memsz );
-      } else {
-        exitcd = 0; // sucess
-      }
-    } else {
-      fprintf( stderr, "%s: error, unable to open\n", cmd );
+    if ( exitcd == 0 && rename( tmppath, path ) != 0 ) {
+      fprintf( stderr, "%s: error, unable to replace\n", cmd );
+      exitcd = 1;
     }
-    // free up the memory
-    if ( rdkconfig_free( &membuff1, memsz ) != RDKCONFIG_OK ) {
-      fprintf( stderr, "%s: mem error\n", cmd );
+    if ( exitcd != 0 ) {
+      unlink( tmppath ); // no partial file
     }
   }
   return exitcd;
 }
-#define CREDSZ_LG 33000
 //
 // SAVE CONFIG FILE
 //
 // SaveConfigFile <refname>
-static int SaveConfigFile( const char *refname ) {
+// SaveConfigFile --cn <listfile>
+// SaveConfigFile --batch <manifest>
+static int SaveConfigFile( const char *arg1, const char *arg2 ) {
   const char *cmd = CMD_SCF;
-  if ( refname == NULL ) {
+  if ( arg1 == NULL ) {
     fprintf( stderr, "%s: error, null argument\n", cmd );
     return 1;
   }
+  if ( strcmp( arg1, BATCH_SWITCH ) == 0 ) {
+    if ( arg2 == NULL ) {
+      fprintf( stderr, "%s %s: error, too few arguments\n", cmd, BATCH_SWITCH );
+      return 1; // error
+    }
+    return ConfigBatch( cmd, arg2, NULL, SaveConfigGroup );
+  }
+  if ( strcmp( arg1, CN_SWITCH ) == 0 ) {
+    if ( arg2 == NULL ) {
+      fprintf( stderr, "%s %s: error, too few arguments\n", cmd, CN_SWITCH );
+      return 1; // error
+    }
+    // list lines are "<refname> <credname>", the map is rebuilt from it
+    return savecrednames( arg2 );
+  }
+  // the plain file has the name of the credential
+  return SaveConfigItem( arg1, arg1 );
+}
+
+// save credential refname from the plain file path
+static int SaveConfigItem( const char *refname, const char *path ) {
+  const char *cmd = CMD_SCF;
   int exitcd = 1; // default to error
   // open the plain file
-  FILE *rdfp = fopen( refname, "rb" );
-  if ( rdfp != NULL ) {
-    // can't read size from stdin so just allocate large space
-    uint8_t *membuff1 = calloc( CREDSZ_LG+1, 1 ); 
-    if ( membuff1 != NULL ) {
-      size_t rdsz = fread( membuff1, 1, CREDSZ_LG, rdfp );
-      fclose( rdfp );
-      // check for overflow
-      if ( rdsz >= CREDSZ_LG ) {
-        fprintf( stderr, "%s: error, unable to read\n", cmd );
-      } else {
-        // encrypt from memory buffer; write to credential in refname 
-        int retval = rdkconfig_set( refname, membuff1, rdsz );
-        if ( retval == RDKCONFIG_OK ) {
-          exitcd = 0; // success
-        } else {
-          fprintf( stderr, "%s: error, unable to set\n", cmd );
-        }
-      }
-      // always wipe and free buffer
-      if ( rdkconfig_free( &membuff1, rdsz ) != RDKCONFIG_OK ) {
-        fprintf( stderr, "%s: mem free error\n", cmd );
-        // but this does create error exit code
-      }
+  int rdfd = open( path, O_RDONLY );
+  if ( rdfd >= 0 ) {
+    // encrypt from the file a chunk at a time, any size; write to credential in refname
+    int retval = rdkconfig_setFromFd( refname, rdfd );
+    close( rdfd );
+    if ( retval == RDKCONFIG_OK ) {
+      exitcd = 0; // success
     } else {
-      fprintf( stderr, "%s: mem error\n", cmd );
-      fclose( rdfp );
+      fprintf( stderr, "%s: error, unable to set\n", cmd );
     }
   } else {
-    fprintf( stderr, "%s: error, unable to open %s\n", cmd, refname );
+    fprintf( stderr, "%s: error, unable to open %s\n", cmd, path );
   }
   return exitcd;
 }
 
-//MOCK
-#define UTCREDNAME "utstcredname1"
-char *getcredname( char *credname, unsigned int credname_sz, const char *refname ) {
-  strncpy( credname, UTCREDNAME, credname_sz ); // this doesn't do any overflow checking
-  return credname;
+// save credentials refnames[i] from the plain files paths[i] in one backend update, status[i] for each
+static int SaveConfigGroup( const char **refnames, const char **paths, size_t n, int status[] ) {
+  const char *cmd = CMD_SCF;
+  int fds[BATCH_GROUPMAX] = { 0 };
+  if ( n > BATCH_GROUPMAX ) return 1;
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    fds[indx] = open( paths[indx], O_RDONLY );
+    if ( fds[indx] < 0 ) {
+      fprintf( stderr, "%s: error, unable to open %s\n", cmd, paths[indx] );
+    }
+  }
+  // a credential without an open file is not stored, its status is a failure
+  int retval = rdkconfig_setManyFromFd( refnames, fds, n, status );
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    if ( fds[indx] >= 0 ) close( fds[indx] );
+  }
+  return ( retval == RDKCONFIG_OK ) ? 0 : 1;
+}
+
+//
+// BATCH
+//
+// manifest lines: <refname> [<path>]
+//   path is the output file for GetConfigFile, or "stdout", and the plain file for SaveConfigFile;
+//   without a path, it is refname as for a single credential
+//   blank lines and lines starting with # are skipped; names and paths have no white space
+// all credentials are done in one process, so the backend is set up once; with group, as for SaveConfigFile,
+// up to BATCH_GROUPMAX credentials are given to the backend at once, e.g. one store update for the lot
+// each is reported on stderr with its status and time, then the totals
+// returns 0 if every credential was done, 1 otherwise
+static int ConfigBatch( const char *cmd, const char *manifest, int (*item)( const char *refname, const char *path ),
+                        int (*group)( const char **refnames, const char **paths, size_t n, int status[] ) ) {
+  FILE *mfp = ( strcmp( manifest, "-" ) == 0 ) ? stdin : fopen( manifest, "r" );
+  if ( mfp == NULL ) {
+    fprintf( stderr, "%s: error, unable to open %s\n", cmd, manifest );
+    return 1;
+  }
+  char line[PATH_MAX*2];
+  unsigned int lineno = 0, okcnt = 0, failcnt = 0;
+  struct timespec ts0, ts1, tsall;
+  // group of lines waiting for the backend
+  const char *refnames[BATCH_GROUPMAX], *paths[BATCH_GROUPMAX];
+  unsigned int linenos[BATCH_GROUPMAX];
+  int status[BATCH_GROUPMAX];
+  size_t groupcnt = 0;
+  int eof = 0;
+  clock_gettime( CLOCK_MONOTONIC, &tsall );
+  while ( !eof ) {
+    eof = ( fgets( line, sizeof(line), mfp ) == NULL );
+    const char *refname = NULL, *path = NULL;
+    if ( !eof ) {
+      lineno++;
+      char *save = NULL;
+      refname = strtok_r( line, " \t\r\n", &save );
+      if ( refname == NULL || refname[0] == '#' ) {
+        continue;
+      }
+      path = strtok_r( NULL, " \t\r\n", &save );
+      if ( path == NULL ) {
+        path = refname;
+      }
+      if ( strtok_r( NULL, " \t\r\n", &save ) != NULL ) {
+        fprintf( stderr, "%s: line %u: %s: FAIL, too many fields\n", cmd, lineno, refname );
+        failcnt++;
+        continue;
+      }
+    }
+    if ( group == NULL ) {
+      if ( eof ) break;
+      clock_gettime( CLOCK_MONOTONIC, &ts0 );
+      int exitcd = item( refname, path );
+      clock_gettime( CLOCK_MONOTONIC, &ts1 );
+      long usec = ( ts1.tv_sec - ts0.tv_sec ) * 1000000L + ( ts1.tv_nsec - ts0.tv_nsec ) / 1000;
+      fprintf( stderr, "%s: line %u: %s %s: %s (%ld us)\n", cmd, lineno, refname, path, exitcd == 0 ? "OK" : "FAIL", usec );
+      if ( exitcd == 0 ) {
+        okcnt++;
+      } else {
+        failcnt++;
+      }
+      continue;
+    }
+    if ( !eof ) {
+      refnames[groupcnt] = strdup( refname );
+      paths[groupcnt] = strdup( path );
+      linenos[groupcnt++] = lineno;
+    }
+    if ( groupcnt == 0 || ( !eof && groupcnt < BATCH_GROUPMAX ) ) {
+      continue;
+    }
+    // the group is done at once, its time is shared by its credentials
+    clock_gettime( CLOCK_MONOTONIC, &ts0 );
+    size_t indx;
+    for ( indx = 0; indx < groupcnt && refnames[indx] != NULL && paths[indx] != NULL; indx++ );
+    if ( indx < groupcnt ) {
+      fprintf( stderr, "%s: error, out of memory\n", cmd );
+      for ( indx = 0; indx < groupcnt; indx++ ) status[indx] = 1;
+    } else {
+      group( refnames, paths, groupcnt, status );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &ts1 );
+    long usec = ( ts1.tv_sec - ts0.tv_sec ) * 1000000L + ( ts1.tv_nsec - ts0.tv_nsec ) / 1000;
+    for ( indx = 0; indx < groupcnt; indx++ ) {
+      fprintf( stderr, "%s: line %u: %s %s: %s\n", cmd, linenos[indx], refnames[indx] ? refnames[indx] : "?",
+               paths[indx] ? paths[indx] : "?", status[indx] == 0 ? "OK" : "FAIL" );
+      if ( status[indx] == 0 ) {
+        okcnt++;
+      } else {
+        failcnt++;
+      }
+      free( (char *)refnames[indx] );
+      free( (char *)paths[indx] );
+    }
+    fprintf( stderr, "%s: %zu in one update (%ld us)\n", cmd, groupcnt, usec );
+    groupcnt = 0;
+  }
+  if ( mfp != stdin ) {
+    fclose( mfp );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &ts1 );
+  long usec = ( ts1.tv_sec - tsall.tv_sec ) * 1000000L + ( ts1.tv_nsec - tsall.tv_nsec ) / 1000;
+  fprintf( stderr, "%s: %u ok, %u failed (%ld us)\n", cmd, okcnt, failcnt, usec );
+  return ( failcnt == 0 ) ? 0 : 1;
 }
+
 #if ! defined(UNIT_TESTS)
 // GetConfigFile/SaveConfigFile
 int main( int argc, char *argv[] ) {
@@ -177,54 +337,94 @@ int main( int argc, char *argv[] ) {
 
 #include "unit_test.h"
 
+// getcredname -- MOCK
+#define UTCREDNAME "utstcredname1"
+char *getcredname( char *credname, unsigned int credname_sz, const char *refname ) {
+  strncpy( credname, UTCREDNAME, credname_sz ); // this doesn't do any overflow checking
+  return credname;
+}
+
+// getcrednames_dump -- MOCK
+int getcrednames_dump( FILE *fp ) {
+  fprintf( fp, "utstcred->%s\n", UTCREDNAME );
+  return 1;
+}
+
+static int runcnt_savecrednames = 0; // number of runs
+// savecrednames -- MOCK
+int savecrednames( const char *listpath ) {
+  runcnt_savecrednames++;
+  return ( access( listpath, F_OK ) == 0 ) ? 0 : 1;
+}
+
 static int runcnt_rdkconfig_get = 0; // number of successful runs
-// rdkconfig_get( &membuff1, &memsz, refname ) -- MOCK
-int rdkconfig_get( uint8_t **sbuff, size_t *sbuffsz, const char *refname ) {
-fprintf(stderr,"rdkconfig_get mock\n");
-  *sbuffsz = 40;
-  *sbuff = calloc( 1, *sbuffsz );
-  memset( *sbuff, 'g', (*sbuffsz)-1 );
-  memcpy( *sbuff, refname, strlen(refname) );
+static size_t ut_getsz = 40;         // size of credential returned
+// rdkconfig_getToFd( refname, wrfd ) -- MOCK
+// credential is refname, then 'g' up to ut_getsz-1 bytes, then a null
+// a refname starting with "utstmissing" fails after writing part of it
+int rdkconfig_getToFd( const char *refname, int fd ) {
+  if ( strncmp( refname, "utstmissing", 11 ) == 0 ) {
+    if ( write( fd, "partial", 7 ) < 0 ) return RDKCONFIG_FAIL;
+    return RDKCONFIG_FAIL;
+  }
+  uint8_t chunk[1000];
+  size_t namelen = strlen( refname );
+  for ( size_t done = 0; done < ut_getsz; ) {
+    size_t len = ( ut_getsz - done < sizeof(chunk) ) ? ut_getsz - done : sizeof(chunk);
+    for ( size_t indx = 0; indx < len; indx++ ) {
+      size_t pos = done + indx;
+      chunk[indx] = ( pos < namelen ) ? refname[pos] : ( pos == ut_getsz-1 ) ? '\0' : 'g';
+    }
+    if ( write( fd, chunk, len ) != len ) return RDKCONFIG_FAIL;
+    done += len;
+  }
   runcnt_rdkconfig_get++;
   return RDKCONFIG_OK;
 }
 
 static int runcnt_rdkconfig_set = 0; // number of successful runs
-// rdkconfig_set( refname, membuff1, rdsz ) -- MOCK
-int rdkconfig_set( const char *refname, uint8_t *sbuff, size_t sbuffsz ) {
-fprintf(stderr,"rdkconfig_set mock\n");
+static size_t ut_setsz = 0;          // size of last credential set
+// rdkconfig_setFromFd( refname, rdfd ) -- MOCK
+// checks the credential is as rdkconfig_getToFd mock writes it
+int rdkconfig_setFromFd( const char *refname, int fd ) {
   int retval = RDKCONFIG_OK;
-  int indx;
-  // not very efficient, but if any of these fail, then return fail
-  for ( indx=0; indx<strlen(refname); indx++ ) {
-    if ( sbuff[indx] != refname[indx] ) {
-      retval = RDKCONFIG_FAIL;
-    }
-  }
-  for ( ; indx<(sbuffsz-1); indx++ ) {
-    if ( sbuff[indx] != 'g' ) {
-      retval = RDKCONFIG_FAIL;
-      break;
+  uint8_t chunk[1000];
+  size_t namelen = strlen( refname ), pos = 0;
+  uint8_t last = 0xff;
+  int nulls = 0;
+  ssize_t rdsz;
+  while ( ( rdsz = read( fd, chunk, sizeof(chunk) ) ) > 0 ) {
+    for ( size_t indx = 0; indx < rdsz; indx++, pos++ ) {
+      if ( chunk[indx] == '\0' ) {
+        nulls++;
+      } else if ( chunk[indx] != ( ( pos < namelen ) ? refname[pos] : 'g' ) ) {
+        retval = RDKCONFIG_FAIL;
+      }
+      last = chunk[indx];
     }
   }
-  if ( sbuff[indx] != '\0' ) retval = RDKCONFIG_FAIL;
+  // null only at end
+  if ( rdsz < 0 || nulls != 1 || last != '\0' ) retval = RDKCONFIG_FAIL;
+  ut_setsz = pos;
   if ( retval == RDKCONFIG_OK ) runcnt_rdkconfig_set++;
 
   return retval;
 }
 
-// rdkconfig_free( &membuff1, memsz ) -- MOCK
-int rdkconfig_free( uint8_t **sbuff, size_t sbuffsz ) {
-  if ( sbuff == NULL ) return RDKCONFIG_FAIL;
-  if ( *sbuff == NULL ) {
-    return RDKCONFIG_OK; // ok if pointer is null
+static int runcnt_rdkconfig_setmany = 0; // number of runs
+// rdkconfig_setManyFromFd( refnames, fds, n, status ) -- MOCK
+int rdkconfig_setManyFromFd( const char **refnames, const int *fds, size_t n, int status[] ) {
+  int retval = RDKCONFIG_OK;
+  runcnt_rdkconfig_setmany++;
+  for ( size_t indx = 0; indx < n; indx++ ) {
+    status[indx] = ( fds[indx] < 0 ) ? RDKCONFIG_FAIL : rdkconfig_setFromFd( refnames[indx], fds[indx] );
+    if ( status[indx] != RDKCONFIG_OK ) retval = RDKCONFIG_FAIL;
   }
-  free( *sbuff );
-  *sbuff = NULL;
-  return RDKCONFIG_OK;
+  return retval;
 }
 
 #define UTTSTFILE "utstfile1"
+#define UTMANIFEST "utstmanifest"
 
 static int utmain( int argc, char *argv[] ) {
 
@@ -237,6 +437,7 @@ static int utmain( int argc, char *argv[] ) {
   fprintf( stderr, "UNIT TEST - GetConfigFile\n" );
   UT_INTCMP( runcnt_rdkconfig_get, 0 );
   UT_INTCMP( GetConfigFile( "--cn", "utstcred" ), RDKCONFIG_OK );
+  UT_INTCMP( GetConfigFile( "--cn-dump", NULL ), RDKCONFIG_OK );
   UT_DOESNTEXIST( UTTSTFILE );
   UT_INTCMP( GetConfigFile( UTTSTFILE, "stdout" ), RDKCONFIG_OK );
   UT_INTCMP( runcnt_rdkconfig_get, 1 );
@@ -244,14 +445,75 @@ static int utmain( int argc, char *argv[] ) {
   UT_INTCMP( GetConfigFile( UTTSTFILE, NULL ), RDKCONFIG_OK );
   UT_INTCMP( runcnt_rdkconfig_get, 2 );
   UT_EXISTS( UTTSTFILE );
+  UT_DOESNTEXIST( UTTSTFILE ".tmp" );
+
+  fprintf( stderr, "UNIT TEST - GetConfigFile failed get keeps the file -- expect errors\n" );
+  FILE *keepfp = fopen( "utstmissing", "w" );
+  assert( keepfp != NULL );
+  fputs( "plain", keepfp );
+  fclose( keepfp );
+  UT_INTCMP( GetConfigFile( "utstmissing", NULL ), RDKCONFIG_FAIL );
+  UT_DOESNTEXIST( "utstmissing.tmp" );
+  char keepbuf[16] = { 0 };
+  keepfp = fopen( "utstmissing", "r" );
+  assert( keepfp != NULL );
+  UT_INTCMP( fread( keepbuf, 1, sizeof(keepbuf)-1, keepfp ), 5 );
+  fclose( keepfp );
+  UT_INTCMP( strcmp( keepbuf, "plain" ), 0 );
+  unlink( "utstmissing" );
 
   fprintf( stderr, "UNIT TEST - SaveConfigFile argument tests -- expect errors\n" );
-  UT_INTCMP( SaveConfigFile( NULL ), RDKCONFIG_FAIL );
+  UT_INTCMP( SaveConfigFile( NULL, NULL ), RDKCONFIG_FAIL );
+  UT_INTCMP( SaveConfigFile( "--batch", NULL ), RDKCONFIG_FAIL );
+  UT_INTCMP( SaveConfigFile( "--cn", NULL ), RDKCONFIG_FAIL );
+  UT_INTCMP( runcnt_savecrednames, 0 );
 
   fprintf( stderr, "UNIT TEST - SaveConfigFile\n" );
   UT_INTCMP( runcnt_rdkconfig_set, 0 );
-  UT_INTCMP( SaveConfigFile( UTTSTFILE ), RDKCONFIG_OK );
+  UT_INTCMP( SaveConfigFile( UTTSTFILE, NULL ), RDKCONFIG_OK );
   UT_INTCMP( runcnt_rdkconfig_set, 1 );
+  UT_INTCMP( ut_setsz, 40 );
+
+  fprintf( stderr, "UNIT TEST - GetConfigFile/SaveConfigFile larger than 33000\n" );
+  ut_getsz = 100000;
+  UT_INTCMP( GetConfigFile( UTTSTFILE, NULL ), RDKCONFIG_OK );
+  UT_INTCMP( SaveConfigFile( UTTSTFILE, NULL ), RDKCONFIG_OK );
+  UT_INTCMP( runcnt_rdkconfig_set, 2 );
+  UT_INTCMP( ut_setsz, 100000 );
+  unlink( UTTSTFILE );
+
+  fprintf( stderr, "UNIT TEST - GetConfigFile/SaveConfigFile --batch -- expect errors\n" );
+  ut_getsz = 40;
+  FILE *mfp = fopen( UTMANIFEST, "w" );
+  assert( mfp != NULL );
+  fprintf( mfp, "# boot credentials\n\n%s\n%s %s\n%s %s extra\n", UTTSTFILE, UTTSTFILE "b", UTTSTFILE "c",
+           UTTSTFILE, UTTSTFILE );
+  fclose( mfp );
+  UT_INTCMP( GetConfigFile( "--batch", NULL ), RDKCONFIG_FAIL );
+  UT_INTCMP( GetConfigFile( "--batch", "./nomanifest" ), RDKCONFIG_FAIL );
+  UT_INTCMP( GetConfigFile( "--batch", UTMANIFEST ), RDKCONFIG_FAIL ); // extra field
+  UT_INTCMP( runcnt_rdkconfig_get, 5 );
+  UT_EXISTS( UTTSTFILE );
+  UT_EXISTS( UTTSTFILE "c" );
+  UT_DOESNTEXIST( UTTSTFILE "b" );
+  // saved from the files just written, utstfile1b from utstfile1c
+  UT_INTCMP( SaveConfigFile( "--batch", UTMANIFEST ), RDKCONFIG_FAIL ); // extra field
+  UT_INTCMP( runcnt_rdkconfig_set, 4 );
+  UT_INTCMP( runcnt_rdkconfig_setmany, 1 ); // one update for the manifest
+  mfp = fopen( UTMANIFEST, "w" );
+  assert( mfp != NULL );
+  fprintf( mfp, "%s\n%s %s\n", UTTSTFILE, UTTSTFILE "b", UTTSTFILE "c" );
+  fclose( mfp );
+  UT_INTCMP( GetConfigFile( "--batch", UTMANIFEST ), RDKCONFIG_OK );
+  UT_INTCMP( runcnt_rdkconfig_get, 7 );
+  UT_INTCMP( SaveConfigFile( "--cn", UTMANIFEST ), RDKCONFIG_OK );
+  UT_INTCMP( runcnt_savecrednames, 1 );
+  unlink( UTTSTFILE "c" );
+  UT_INTCMP( SaveConfigFile( "--batch", UTMANIFEST ), RDKCONFIG_FAIL ); // utstfile1c missing
+  UT_INTCMP( runcnt_rdkconfig_set, 5 );
+  UT_INTCMP( runcnt_rdkconfig_setmany, 2 );
+  unlink( UTTSTFILE );
+  unlink( UTMANIFEST );
 
   fprintf( stderr, "UNIT TEST - GetSaveConfigFile - SUCCESS\n" );
 
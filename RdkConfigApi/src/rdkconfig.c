@@ -19,9 +19,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
 #include "rdkconfig.h"
+#include "rdkconfig_arena.h"
 
-#ifndef TEST_RDK_CERTS
+// with RDKCONFIG_STORE, get and set are in rdkconfig_store.c
+#if !defined(TEST_RDK_CERTS) && !defined(RDKCONFIG_STORE)
 // rdkconfig_get - get credential by reference name, allocate space, fill buffer
 // return new buffer and size of data (actual memory buffer may be larger)
 // return value: RDKCONFIG_OK or RDKCONFIG_FAIL
@@ -42,6 +46,7 @@ int rdkconfig_getStr( char **sbuff, size_t *sbuffsz, const char *refname ) {
 }
 #endif
 
+#ifndef RDKCONFIG_STORE
 // rdkconfig_set - store credential by reference name
 // return value: RDKCONFIG_OK or RDKCONFIG_FAIL
 // (for string data, the null terminator does not need to be included in sbuffsz as long as
@@ -51,21 +56,154 @@ int rdkconfig_set( const char *refname, uint8_t *sbuff, size_t sbuffsz ) {
         printf("rdkconfig_set not implemented yet\n");
 	return RDKCONFIG_FAIL;
 }
+#endif
+
+#ifndef RDKCONFIG_STORE
+// rdkconfig_getInto - get credential by reference name into caller buffer
+// built on rdkconfig_get, so it works with any backend that has it; the temporary copy is wiped
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len ) {
+	if ( buf == NULL || len == NULL )
+		return RDKCONFIG_FAIL;
+	uint8_t *sbuff = NULL;
+	size_t sbuffsz = 0;
+	*len = 0;
+	if ( rdkconfig_get( &sbuff, &sbuffsz, refname ) != RDKCONFIG_OK )
+		return RDKCONFIG_FAIL;
+	int retval = RDKCONFIG_FAIL;
+	if ( sbuffsz <= cap ) {
+		memcpy( buf, sbuff, sbuffsz );
+		retval = RDKCONFIG_OK;
+	}
+	*len = sbuffsz;
+	rdkconfig_free( &sbuff, sbuffsz );
+	return retval;
+}
+#endif
+
+#ifndef RDKCONFIG_STORE
+// rdkconfig_getMany - get n credentials by reference name in one call
+// built on rdkconfig_getStr, so it works with any backend that has it, one backend call per credential
+// return value: RDKCONFIG_OK if every credential was found, otherwise RDKCONFIG_FAIL
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] ) {
+	if ( ( refnames == NULL || out == NULL ) && n != 0 )
+		return RDKCONFIG_FAIL;
+	int retval = RDKCONFIG_OK;
+	for ( size_t idx = 0; idx < n; idx++ ) {
+		char *strbuff = NULL;
+		size_t strbuffsz = 0;
+		out[idx].buf = NULL;
+		out[idx].len = 0;
+		out[idx].status = RDKCONFIG_FAIL;
+		if ( refnames[idx] != NULL && rdkconfig_getStr( &strbuff, &strbuffsz, refnames[idx] ) == RDKCONFIG_OK ) {
+			out[idx].buf = (uint8_t *)strbuff;
+			out[idx].len = strbuffsz - 1;
+			out[idx].status = RDKCONFIG_OK;
+		} else {
+			retval = RDKCONFIG_FAIL;
+		}
+	}
+	return retval;
+}
+#endif
+
+// rdkconfig_freeMany - wipe and free the n buffers returned by rdkconfig_getMany
+int rdkconfig_freeMany( rdkconfig_buf_t out[], size_t n ) {
+	if ( out == NULL )
+		return ( n == 0 ) ? RDKCONFIG_OK : RDKCONFIG_FAIL;
+	for ( size_t idx = 0; idx < n; idx++ ) {
+		rdkconfig_free( &out[idx].buf, out[idx].len + 1 );
+		out[idx].len = 0;
+	}
+	return RDKCONFIG_OK;
+}
 
-//memwipe - fix this to always wipe without getting optimized out
-static void memwipe( volatile void *mem, size_t sz ) {
-  memset( (void *)mem, 0, sz );
+#ifndef RDKCONFIG_STORE
+// rdkconfig_getToFd - get credential by reference name and write the data to file descriptor fd
+// built on rdkconfig_get, the whole credential is held in memory
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getToFd( const char *refname, int fd ) {
+	if ( refname == NULL || fd < 0 )
+		return RDKCONFIG_FAIL;
+	uint8_t *sbuff = NULL;
+	size_t sbuffsz = 0;
+	if ( rdkconfig_get( &sbuff, &sbuffsz, refname ) != RDKCONFIG_OK )
+		return RDKCONFIG_FAIL;
+	int retval = RDKCONFIG_OK;
+	for ( size_t done = 0; done < sbuffsz; ) {
+		ssize_t wrsz = write( fd, sbuff + done, sbuffsz - done );
+		if ( wrsz < 0 && errno == EINTR )
+			continue;
+		if ( wrsz <= 0 ) {
+			retval = RDKCONFIG_FAIL;
+			break;
+		}
+		done += wrsz;
+	}
+	rdkconfig_free( &sbuff, sbuffsz );
+	return retval;
 }
 
-// rdkconfig_free - wipe and free buffer
+// rdkconfig_setFromFd - store credential by reference name, data read from file descriptor fd to end of file
+// built on rdkconfig_set, the whole credential is read into memory; the buffer doubles as it fills
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_setFromFd( const char *refname, int fd ) {
+	if ( refname == NULL || fd < 0 )
+		return RDKCONFIG_FAIL;
+	size_t cap = 4096, len = 0;
+	uint8_t *sbuff = rdkconfig_arenaAlloc( cap );
+	while ( sbuff != NULL ) {
+		if ( len == cap ) {
+			uint8_t *bigger = rdkconfig_arenaAlloc( cap * 2 );
+			if ( bigger != NULL )
+				memcpy( bigger, sbuff, len );
+			rdkconfig_arenaFree( sbuff, cap ); // wipes the old copy
+			sbuff = bigger;
+			cap *= 2;
+			continue;
+		}
+		ssize_t rdsz = read( fd, sbuff + len, cap - len );
+		if ( rdsz < 0 && errno == EINTR )
+			continue;
+		if ( rdsz < 0 ) {
+			rdkconfig_arenaFree( sbuff, cap );
+			return RDKCONFIG_FAIL;
+		}
+		if ( rdsz == 0 )
+			break;
+		len += rdsz;
+	}
+	if ( sbuff == NULL )
+		return RDKCONFIG_FAIL;
+	int retval = rdkconfig_set( refname, sbuff, len );
+	rdkconfig_arenaFree( sbuff, cap );
+	return retval;
+}
+
+// rdkconfig_setManyFromFd - store n credentials in one call, refnames[i] read from fds[i] to end of file
+// built on rdkconfig_setFromFd, one backend call per credential
+// return value: RDKCONFIG_OK if every credential was stored, otherwise RDKCONFIG_FAIL
+int rdkconfig_setManyFromFd( const char **refnames, const int *fds, size_t n, int status[] ) {
+	if ( ( refnames == NULL || fds == NULL || status == NULL ) && n != 0 )
+		return RDKCONFIG_FAIL;
+	int retval = RDKCONFIG_OK;
+	for ( size_t idx = 0; idx < n; idx++ ) {
+		status[idx] = rdkconfig_setFromFd( refnames[idx], fds[idx] );
+		if ( status[idx] != RDKCONFIG_OK )
+			retval = RDKCONFIG_FAIL;
+	}
+	return retval;
+}
+#endif
+
+// rdkconfig_free - wipe and free buffer, from the arena or the heap
 int rdkconfig_free( uint8_t **sbuff, size_t sbuffsz ) {
 	if ( sbuff == NULL ) 
 		return RDKCONFIG_FAIL;
         if ( *sbuff == NULL ) {
                 return RDKCONFIG_OK; // ok if pointer is null
         }
-        memwipe(*sbuff, sbuffsz);
-        free( *sbuff );
+        rdkconfig_arenaFree( *sbuff, sbuffsz ); // wipes, arena slots are kept for reuse
         *sbuff = NULL;
         return RDKCONFIG_OK;
 }	
@@ -96,9 +234,70 @@ static int utmain( int argc, char *argv[] ) {
   UT_INTCMP( rdkconfig_set( refname2, sbuffraw, sbuffrawsz ), RDKCONFIG_FAIL ); 
   UT_INTCMP( rdkconfig_get( &sbuffdec, &sbuffdecsz, refname2 ), RDKCONFIG_FAIL);
   UT_INTCMP( rdkconfig_getStr( &strbuffdec, &sbuffdecsz, refname2 ), RDKCONFIG_FAIL);
+  uint8_t intobuff[20];
+  UT_INTCMP( rdkconfig_getInto( refname2, intobuff, sizeof(intobuff), &sbuffdecsz ), RDKCONFIG_FAIL);
+  UT_INTCMP( sbuffdecsz, 0 );
+  UT_INTCMP( rdkconfig_getInto( refname2, NULL, 0, &sbuffdecsz ), RDKCONFIG_FAIL);
   UT_INTCMP( rdkconfig_free( &sbuffraw, sbuffrawsz ), RDKCONFIG_OK );
   UT_INTCMP( rdkconfig_freeStr( &strbuffraw, sbuffrawsz ), RDKCONFIG_OK );
   UT_INTCMP( rdkconfig_free( NULL, 0 ), RDKCONFIG_FAIL );
+  const char *refnames[2] = { refname2, NULL };
+  rdkconfig_buf_t many[2];
+  UT_INTCMP( rdkconfig_getMany( refnames, 2, many ), RDKCONFIG_FAIL );
+  UT_INTCMP( many[0].status, RDKCONFIG_FAIL );
+  UT_INTCMP( (long)many[1].buf, 0 );
+  UT_INTCMP( rdkconfig_freeMany( many, 2 ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_getMany( NULL, 0, NULL ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_getMany( NULL, 1, many ), RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_getToFd( refname2, STDOUT_FILENO ), RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_getToFd( refname2, -1 ), RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_setFromFd( refname2, -1 ), RDKCONFIG_FAIL );
+  int setfds[2] = { -1, -1 }, setstatus[2];
+  UT_INTCMP( rdkconfig_setManyFromFd( refnames, setfds, 2, setstatus ), RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[0], RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_setManyFromFd( NULL, NULL, 0, NULL ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - rdkconfig arena\n" );
+  rdkconfigArenaCounters_t before, after;
+  rdkconfig_getArenaCounters( &before );
+  if ( before.arenaBytes == 0 ) {
+    fprintf( stderr, "UNIT TEST - arena not locked, skipped\n" );
+  } else {
+    // released slot is wiped and reused
+    sbuffraw = rdkconfig_arenaAlloc( 10 );
+    UT_INTDIFF( (long)sbuffraw, 0 );
+    uint8_t *firstbuff = sbuffraw;
+    memset( sbuffraw, 'p', 10 );
+    UT_INTCMP( rdkconfig_free( &sbuffraw, 10 ), RDKCONFIG_OK );
+    UT_INTCMP( (long)sbuffraw, 0 );
+    UT_INTCMP( firstbuff[0], 0 );
+    sbuffraw = rdkconfig_arenaAlloc( 20 );
+    UT_INTCMP( (long)sbuffraw, (long)firstbuff );
+    UT_INTCMP( rdkconfig_free( &sbuffraw, 20 ), RDKCONFIG_OK );
+    rdkconfig_getArenaCounters( &after );
+    UT_INTCMP( after.arenaAllocs - before.arenaAllocs, 2 );
+    UT_INTCMP( after.reuses - before.reuses, 1 );
+    UT_INTCMP( after.inUse, 0 );
+    // too large, from heap
+    sbuffraw = rdkconfig_arenaAlloc( 5000 );
+    UT_INTDIFF( (long)sbuffraw, 0 );
+    UT_INTCMP( rdkconfig_free( &sbuffraw, 5000 ), RDKCONFIG_OK );
+    // class full, from heap
+    uint8_t *many[33];
+    for ( int idx = 0; idx < 33; idx++ ) {
+      many[idx] = rdkconfig_arenaAlloc( 16 );
+      UT_INTDIFF( (long)many[idx], 0 );
+    }
+    rdkconfig_getArenaCounters( &after );
+    UT_INTCMP( after.heapAllocs - before.heapAllocs, 2 );
+    UT_INTCMP( after.inUse, 32 );
+    UT_INTCMP( after.highWater, 32 );
+    for ( int idx = 0; idx < 33; idx++ ) {
+      UT_INTCMP( rdkconfig_free( &many[idx], 16 ), RDKCONFIG_OK );
+    }
+    rdkconfig_getArenaCounters( &after );
+    UT_INTCMP( after.inUse, 0 );
+  }
   fprintf( stderr, "UNIT TEST - rdkconfig - SUCCESS\n" );
   return 0;
 }
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// secure arena for credential buffers
+//
+// one mapping, made on first use: a region of fixed size slots for each size class, with a
+// guard page before and after each region; the regions are locked in memory and left out of core dumps
+// slots are wiped with explicit_bzero when released and kept for the next credential,
+// so credential churn does not go through the general heap
+// buffers too large for the largest class, or when a class is full, come from the heap;
+// if the arena can't be mapped or locked, all buffers come from the heap
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "rdkconfig.h"
+#include "rdkconfig_arena.h"
+
+#define ARENA_CLASSES 4
+#define ARENA_SLOTMAX 32   // slots of a class fit in a 32 bit mask
+
+// size classes, smallest first; passcodes fit the first class
+static const size_t arena_classSz[ARENA_CLASSES] = { 64, 256, 1024, 4096 };
+static const unsigned int arena_classCnt[ARENA_CLASSES] = { 32, 16, 8, 4 };
+
+typedef struct {
+  uint8_t *base;       // first slot
+  size_t len;          // slots, page rounded
+  uint32_t used;       // slots in use
+  uint32_t touched;    // slots used at least once, to count reuse
+} arenaclass_t;
+
+typedef struct {
+  uint8_t *map;        // whole mapping including guard pages, NULL if unavailable
+  size_t mapsz;
+  size_t lockedsz;
+  arenaclass_t cls[ARENA_CLASSES];
+  rdkconfigArenaCounters_t counters;
+} arena_t;
+
+static arena_t arena;
+static pthread_mutex_t arena_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t arena_once = PTHREAD_ONCE_INIT;
+
+static void arena_init( void );
+static int arena_class( size_t sz );
+
+// rdkconfig_arenaAlloc - allocate a zeroed buffer of at least sz bytes
+void *rdkconfig_arenaAlloc( size_t sz ) {
+  pthread_once( &arena_once, arena_init );
+  pthread_mutex_lock( &arena_mutex );
+  arena.counters.allocs++;
+  int cidx = arena.map != NULL ? arena_class( sz ) : -1;
+  if ( cidx >= 0 ) {
+    arenaclass_t *cls = &arena.cls[cidx];
+    uint32_t all = arena_classCnt[cidx] == 32 ? 0xffffffffu : ( 1u << arena_classCnt[cidx] ) - 1;
+    uint32_t avail = all & ~cls->used;
+    if ( avail != 0 ) {
+      unsigned int sidx = __builtin_ctz( avail );
+      cls->used |= 1u << sidx;
+      if ( cls->touched & ( 1u << sidx ) ) {
+        arena.counters.reuses++;
+      }
+      cls->touched |= 1u << sidx;
+      arena.counters.arenaAllocs++;
+      if ( ++arena.counters.inUse > arena.counters.highWater ) {
+        arena.counters.highWater = arena.counters.inUse;
+      }
+      pthread_mutex_unlock( &arena_mutex );
+      return cls->base + sidx * arena_classSz[cidx]; // slots are wiped on release
+    }
+  }
+  arena.counters.heapAllocs++;
+  pthread_mutex_unlock( &arena_mutex );
+  return calloc( 1, sz ? sz : 1 );
+}
+
+// rdkconfig_arenaFree - wipe and release a buffer
+void rdkconfig_arenaFree( void *buff, size_t sz ) {
+  if ( buff == NULL ) {
+    return;
+  }
+  uint8_t *ptr = buff;
+  pthread_mutex_lock( &arena_mutex );
+  if ( arena.map != NULL && ptr >= arena.map && ptr < arena.map + arena.mapsz ) {
+    for ( int cidx = 0; cidx < ARENA_CLASSES; cidx++ ) {
+      arenaclass_t *cls = &arena.cls[cidx];
+      if ( ptr < cls->base || ptr >= cls->base + cls->len ) continue;
+      size_t off = ptr - cls->base;
+      unsigned int sidx = off / arena_classSz[cidx];
+      if ( off % arena_classSz[cidx] != 0 || sidx >= arena_classCnt[cidx] || !( cls->used & ( 1u << sidx ) ) ) {
+        break;
+      }
+      explicit_bzero( ptr, arena_classSz[cidx] ); // whole slot, sz may be less than was written
+      cls->used &= ~( 1u << sidx );
+      arena.counters.inUse--;
+      pthread_mutex_unlock( &arena_mutex );
+      return;
+    }
+    pthread_mutex_unlock( &arena_mutex );
+    fprintf( stderr, "rdkconfig: error, bad arena buffer\n" );
+    return;
+  }
+  pthread_mutex_unlock( &arena_mutex );
+  explicit_bzero( buff, sz );
+  free( buff );
+}
+
+// rdkconfig_getArenaCounters - get credential buffer counters
+void rdkconfig_getArenaCounters( rdkconfigArenaCounters_t *counters ) {
+  if ( counters == NULL ) {
+    return;
+  }
+  pthread_once( &arena_once, arena_init );
+  pthread_mutex_lock( &arena_mutex );
+  *counters = arena.counters;
+  counters->arenaBytes = arena.lockedsz;
+  pthread_mutex_unlock( &arena_mutex );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+
+// arena_init - map the regions between guard pages and lock them; arena.map stays NULL on failure
+static void arena_init( void ) {
+  size_t pagesz = sysconf( _SC_PAGESIZE );
+  size_t mapsz = pagesz, lockedsz = 0;
+  for ( int cidx = 0; cidx < ARENA_CLASSES; cidx++ ) {
+    size_t len = ( arena_classSz[cidx] * arena_classCnt[cidx] + pagesz - 1 ) & ~( pagesz - 1 );
+    arena.cls[cidx].len = len;
+    mapsz += len + pagesz;
+    lockedsz += len;
+  }
+  uint8_t *map = mmap( NULL, mapsz, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0 );
+  if ( map == MAP_FAILED ) {
+    fprintf( stderr, "rdkconfig: arena unavailable, using heap\n" );
+    return;
+  }
+  uint8_t *region = map + pagesz;
+  for ( int cidx = 0; cidx < ARENA_CLASSES; cidx++ ) {
+    arena.cls[cidx].base = region;
+    if ( mprotect( region, arena.cls[cidx].len, PROT_READ|PROT_WRITE ) != 0 ||
+         mlock( region, arena.cls[cidx].len ) != 0 ) {
+      fprintf( stderr, "rdkconfig: arena can't be locked, using heap\n" );
+      munmap( map, mapsz );
+      memset( arena.cls, 0, sizeof(arena.cls) );
+      return;
+    }
+#ifdef MADV_DONTDUMP
+    madvise( region, arena.cls[cidx].len, MADV_DONTDUMP );
+#endif
+#ifdef MADV_WIPEONFORK
+    madvise( region, arena.cls[cidx].len, MADV_WIPEONFORK );
+#endif
+    region += arena.cls[cidx].len + pagesz; // guard page after each region
+  }
+  arena.map = map;
+  arena.mapsz = mapsz;
+  arena.lockedsz = lockedsz;
+}
+
+// arena_class - smallest size class that fits sz, -1 if none
+static int arena_class( size_t sz ) {
+  for ( int cidx = 0; cidx < ARENA_CLASSES; cidx++ ) {
+    if ( sz <= arena_classSz[cidx] ) return cidx;
+  }
+  return -1;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2024 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __RDKCONFIG_ARENA__
+#define __RDKCONFIG_ARENA__
+
+#include <stddef.h>
+
+// secure arena for credential buffers, internal to rdkconfig
+// backends allocate the buffers they return with rdkconfig_arenaAlloc, rdkconfig_free releases them
+
+// rdkconfig_arenaAlloc - allocate a zeroed buffer of at least sz bytes
+// from the locked arena if it has a free slot of a size class that fits, otherwise from the heap
+// return buffer or NULL
+void *rdkconfig_arenaAlloc( size_t sz );
+
+// rdkconfig_arenaFree - wipe and release a buffer
+// an arena slot is wiped whole and kept for reuse; other buffers, e.g. from malloc, are wiped for sz and freed
+void rdkconfig_arenaFree( void *buff, size_t sz );
+
+#endif // __RDKCONFIG_ARENA__
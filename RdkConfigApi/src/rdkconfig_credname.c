@@ -0,0 +1,472 @@
+/*
+ * Copyright 2024 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// refname to credname map
+//
+// map file: header, index of slots, entries
+//   the index is an open addressing hash table of refname hashes, so a lookup maps the file,
+//   probes the index and compares one entry
+//   entries are in the order of the list the map was built from, so a dump is one pass over them
+//   savecrednames writes a new map file and renames it over the old one
+// the mapping is kept until the map file changes
+// path can be changed with an environment variable, see below
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rdkconfig_credname.h"
+
+#define CN_PATH "/opt/secure/rdkconfig/credname.map"
+#define CN_PATH_ENV "RDKCONFIG_CREDMAP"
+
+#define CN_MAGIC "RDKCN001"
+#define CN_MINSLOTS 16
+#define CN_NAMEMAX 255
+#define CN_PATHMAX 256
+#define CN_LINEMAX 1024
+#define CN_ALIGN 8
+#define CN_PAD(len) ( ( CN_ALIGN - ( (len) % CN_ALIGN ) ) % CN_ALIGN )
+
+typedef struct {
+  char magic[8];
+  uint32_t nslots;     // index slots, power of 2
+  uint32_t count;      // entries
+  uint64_t size;       // file size, to catch a truncated file
+  uint64_t entoff;     // first entry, entries run to the end of the file
+} cnhdr_t;
+
+typedef struct {
+  uint64_t hash;       // hash of refname, 0 for an empty slot
+  uint64_t off;        // entry offset in file
+} cnslot_t;
+
+typedef struct {
+  uint16_t reflen;
+  uint16_t cnlen;
+  // followed by refname, '\0', credname, '\0', padded to CN_ALIGN
+} cnent_t;
+
+#define CN_ENTSZ(reflen,cnlen) ( sizeof(cnent_t) + (reflen) + 1 + (cnlen) + 1 )
+
+// mapped map file, reused until the file changes
+typedef struct {
+  uint8_t *map;
+  size_t mapsz;
+  dev_t dev;
+  ino_t ino;
+  struct timespec mtim;
+} cncache_t;
+
+static cncache_t cn_cache;
+static pthread_mutex_t cn_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const char *cn_path( void );
+static uint64_t cn_hash( const char *refname, size_t reflen );
+static void cn_unmap( void );
+static int cn_map( void );
+static const cnent_t *cn_entry( uint64_t off );
+static const cnent_t *cn_find( const char *refname );
+
+// getcredname - look up the credname of refname, copy it null terminated into credname
+// return credname, or NULL if not found or it does not fit in credname_sz
+char *getcredname( char *credname, unsigned int credname_sz, const char *refname ) {
+  if ( credname == NULL || credname_sz == 0 || refname == NULL ) {
+    return NULL;
+  }
+  char *retval = NULL;
+  pthread_mutex_lock( &cn_mutex );
+  const cnent_t *ent = ( cn_map() == 0 ) ? cn_find( refname ) : NULL;
+  if ( ent != NULL && ent->cnlen < credname_sz ) {
+    memcpy( credname, (const char *)( ent + 1 ) + ent->reflen + 1, ent->cnlen + 1 );
+    retval = credname;
+  }
+  pthread_mutex_unlock( &cn_mutex );
+  return retval;
+}
+
+// getcrednames_dump - write every "refname->credname" of the map to fp, one per line, in list order
+// return number of lines, or -1 if the map can't be read
+int getcrednames_dump( FILE *fp ) {
+  if ( fp == NULL ) {
+    return -1;
+  }
+  int count = -1;
+  pthread_mutex_lock( &cn_mutex );
+  if ( cn_map() == 0 ) {
+    const cnhdr_t *hdr = (const cnhdr_t *)cn_cache.map;
+    uint64_t off = hdr->entoff;
+    const cnent_t *ent;
+    count = 0;
+    while ( off < hdr->size && ( ent = cn_entry( off ) ) != NULL ) {
+      const char *refname = (const char *)( ent + 1 );
+      fprintf( fp, "%s->%s\n", refname, refname + ent->reflen + 1 );
+      count++;
+      off += CN_ENTSZ( ent->reflen, ent->cnlen ) + CN_PAD( CN_ENTSZ( ent->reflen, ent->cnlen ) );
+    }
+    if ( off != hdr->size || (uint32_t)count != hdr->count ) {
+      fprintf( stderr, "rdkconfig: error, bad credname map %s\n", cn_path() );
+      count = -1;
+    }
+  }
+  pthread_mutex_unlock( &cn_mutex );
+  return count;
+}
+
+// savecrednames - build the map file from listpath, lines of "<refname> <credname>"
+// blank lines and lines starting with # are skipped; the map is replaced as a whole
+// return 0 on success, 1 on error
+int savecrednames( const char *listpath ) {
+  if ( listpath == NULL ) {
+    return 1;
+  }
+  FILE *lfp = fopen( listpath, "r" );
+  if ( lfp == NULL ) {
+    fprintf( stderr, "savecrednames: error, unable to open %s\n", listpath );
+    return 1;
+  }
+  // read the list, entries are laid out as they come
+  int retval = 1;
+  char line[CN_LINEMAX];
+  uint8_t *ents = NULL;
+  size_t entsz = 0, entcap = 0;
+  uint32_t count = 0, lineno = 0;
+  while ( fgets( line, sizeof(line), lfp ) != NULL ) {
+    lineno++;
+    char *save = NULL;
+    const char *refname = strtok_r( line, " \t\r\n", &save );
+    if ( refname == NULL || refname[0] == '#' ) {
+      continue;
+    }
+    const char *credname = strtok_r( NULL, " \t\r\n", &save );
+    size_t reflen = strlen( refname ), cnlen = credname ? strlen( credname ) : 0;
+    if ( credname == NULL || strtok_r( NULL, " \t\r\n", &save ) != NULL || reflen > CN_NAMEMAX || cnlen > CN_NAMEMAX ) {
+      fprintf( stderr, "savecrednames: error, bad line %u\n", lineno );
+      goto done;
+    }
+    size_t len = CN_ENTSZ( reflen, cnlen ) + CN_PAD( CN_ENTSZ( reflen, cnlen ) );
+    if ( entsz + len > entcap ) {
+      size_t newcap = entcap ? entcap * 2 : 4096;
+      while ( newcap < entsz + len ) newcap *= 2;
+      uint8_t *newents = realloc( ents, newcap );
+      if ( newents == NULL ) goto done;
+      ents = newents;
+      entcap = newcap;
+    }
+    cnent_t *ent = (cnent_t *)( ents + entsz );
+    memset( ent, 0, len );
+    ent->reflen = reflen;
+    ent->cnlen = cnlen;
+    memcpy( ent + 1, refname, reflen );
+    memcpy( (char *)( ent + 1 ) + reflen + 1, credname, cnlen );
+    entsz += len;
+    count++;
+  }
+
+  // index at most half full
+  uint32_t nslots = CN_MINSLOTS;
+  while ( nslots < count * 2 ) nslots <<= 1;
+  cnslot_t *slots = calloc( nslots, sizeof(cnslot_t) );
+  if ( slots == NULL ) goto done;
+  cnhdr_t hdr;
+  memset( &hdr, 0, sizeof(hdr) );
+  memcpy( hdr.magic, CN_MAGIC, sizeof(hdr.magic) );
+  hdr.nslots = nslots;
+  hdr.count = count;
+  hdr.entoff = sizeof(hdr) + (uint64_t)nslots * sizeof(cnslot_t);
+  hdr.size = hdr.entoff + entsz;
+  for ( size_t off = 0; off < entsz; ) {
+    const cnent_t *ent = (const cnent_t *)( ents + off );
+    const char *refname = (const char *)( ent + 1 );
+    uint64_t hash = cn_hash( refname, ent->reflen );
+    uint32_t sidx = (uint32_t)hash & ( nslots - 1 );
+    for ( ; slots[sidx].hash != 0; sidx = ( sidx + 1 ) & ( nslots - 1 ) ) {
+      const cnent_t *other = (const cnent_t *)( ents + slots[sidx].off - hdr.entoff );
+      if ( slots[sidx].hash == hash && strcmp( (const char *)( other + 1 ), refname ) == 0 ) {
+        fprintf( stderr, "savecrednames: error, %s listed twice\n", refname );
+        free( slots );
+        goto done;
+      }
+    }
+    slots[sidx].hash = hash;
+    slots[sidx].off = hdr.entoff + off;
+    off += CN_ENTSZ( ent->reflen, ent->cnlen ) + CN_PAD( CN_ENTSZ( ent->reflen, ent->cnlen ) );
+  }
+
+  // write new file, then replace the old one
+  const char *path = cn_path();
+  char tmppath[CN_PATHMAX+8];
+  snprintf( tmppath, sizeof(tmppath), "%s.tmp", path );
+  FILE *wfp = fopen( tmppath, "wb" );
+  if ( wfp == NULL ) {
+    fprintf( stderr, "savecrednames: error, unable to create %s\n", tmppath );
+    free( slots );
+    goto done;
+  }
+  int wrerr = ( fwrite( &hdr, sizeof(hdr), 1, wfp ) != 1 );
+  wrerr |= ( fwrite( slots, sizeof(cnslot_t), nslots, wfp ) != nslots );
+  wrerr |= ( entsz > 0 && fwrite( ents, entsz, 1, wfp ) != 1 );
+  wrerr |= ( fflush( wfp ) != 0 || fsync( fileno( wfp ) ) != 0 );
+  wrerr |= ( fclose( wfp ) != 0 );
+  free( slots );
+  if ( wrerr != 0 || rename( tmppath, path ) != 0 ) {
+    fprintf( stderr, "savecrednames: error, unable to write %s\n", path );
+    unlink( tmppath );
+    goto done;
+  }
+  retval = 0;
+
+done:
+  fclose( lfp );
+  free( ents );
+  return retval;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+
+// cn_path - map file path, from environment or default
+static const char *cn_path( void ) {
+  const char *path = getenv( CN_PATH_ENV );
+  if ( path == NULL || *path == '\0' || strlen( path ) > CN_PATHMAX ) {
+    path = CN_PATH;
+  }
+  return path;
+}
+
+// cn_hash - FNV-1a of refname, never 0, which marks an empty slot
+static uint64_t cn_hash( const char *refname, size_t reflen ) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for ( size_t idx = 0; idx < reflen; idx++ ) {
+    hash ^= (uint8_t)refname[idx];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash ? hash : 1;
+}
+
+// cn_unmap - drop the mapped map file; caller holds cn_mutex
+static void cn_unmap( void ) {
+  if ( cn_cache.map != NULL ) {
+    munmap( cn_cache.map, cn_cache.mapsz );
+  }
+  memset( &cn_cache, 0, sizeof(cn_cache) );
+}
+
+// cn_map - map the map file, unless it is mapped and has not changed; caller holds cn_mutex
+// one stat per call when nothing changed; return 0 on success
+static int cn_map( void ) {
+  struct stat st;
+  const char *path = cn_path();
+  if ( stat( path, &st ) != 0 ) {
+    cn_unmap();
+    return 1;
+  }
+  if ( cn_cache.map != NULL && st.st_dev == cn_cache.dev && st.st_ino == cn_cache.ino &&
+       (size_t)st.st_size == cn_cache.mapsz && st.st_mtim.tv_sec == cn_cache.mtim.tv_sec &&
+       st.st_mtim.tv_nsec == cn_cache.mtim.tv_nsec ) {
+    return 0;
+  }
+  cn_unmap();
+  int fd = open( path, O_RDONLY|O_CLOEXEC );
+  if ( fd < 0 ) return 1;
+  if ( fstat( fd, &st ) != 0 || (size_t)st.st_size < sizeof(cnhdr_t) ) {
+    close( fd );
+    return 1;
+  }
+  void *map = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+  close( fd );
+  if ( map == MAP_FAILED ) return 1;
+  // check header and index fit the file, entries are checked when used
+  const cnhdr_t *hdr = (const cnhdr_t *)map;
+  if ( memcmp( hdr->magic, CN_MAGIC, sizeof(hdr->magic) ) != 0 || hdr->size != (uint64_t)st.st_size ||
+       hdr->nslots == 0 || ( hdr->nslots & ( hdr->nslots - 1 ) ) != 0 ||
+       hdr->entoff != sizeof(cnhdr_t) + (uint64_t)hdr->nslots * sizeof(cnslot_t) || hdr->entoff > hdr->size ) {
+    fprintf( stderr, "rdkconfig: error, bad credname map %s\n", path );
+    munmap( map, st.st_size );
+    return 1;
+  }
+  cn_cache.map = map;
+  cn_cache.mapsz = st.st_size;
+  cn_cache.dev = st.st_dev;
+  cn_cache.ino = st.st_ino;
+  cn_cache.mtim = st.st_mtim;
+  return 0;
+}
+
+// cn_entry - entry at off if it fits the file and its names are terminated, otherwise NULL
+static const cnent_t *cn_entry( uint64_t off ) {
+  const cnhdr_t *hdr = (const cnhdr_t *)cn_cache.map;
+  if ( off < hdr->entoff || off > hdr->size || hdr->size - off < sizeof(cnent_t) || ( off % CN_ALIGN ) != 0 ) {
+    return NULL;
+  }
+  const cnent_t *ent = (const cnent_t *)( cn_cache.map + off );
+  if ( hdr->size - off < CN_ENTSZ( ent->reflen, ent->cnlen ) ) {
+    return NULL;
+  }
+  const char *refname = (const char *)( ent + 1 );
+  if ( refname[ent->reflen] != '\0' || refname[ent->reflen + 1 + ent->cnlen] != '\0' ) {
+    return NULL;
+  }
+  return ent;
+}
+
+// cn_find - probe the index for refname, return its entry or NULL
+static const cnent_t *cn_find( const char *refname ) {
+  const cnhdr_t *hdr = (const cnhdr_t *)cn_cache.map;
+  const cnslot_t *slots = (const cnslot_t *)( hdr + 1 );
+  size_t reflen = strlen( refname );
+  uint64_t hash = cn_hash( refname, reflen );
+  uint32_t mask = hdr->nslots - 1;
+  for ( uint32_t probe = 0, sidx = (uint32_t)hash & mask; probe < hdr->nslots; probe++, sidx = ( sidx + 1 ) & mask ) {
+    const cnslot_t *slot = &slots[sidx];
+    if ( slot->hash == 0 ) break;
+    if ( slot->hash != hash ) continue;
+    const cnent_t *ent = cn_entry( slot->off );
+    if ( ent == NULL ) break; // corrupt index
+    if ( ent->reflen == reflen && memcmp( ent + 1, refname, reflen ) == 0 ) {
+      return ent;
+    }
+  }
+  return NULL;
+}
+
+#ifdef UNIT_TESTS
+static int utmain( int argc, char *argv[] );
+
+int main( int argc, char *argv[] ) {
+  return utmain( argc, argv );
+}
+
+#include <time.h>
+#include "unit_test.h"
+
+#define UTMAP "./ut/tmp/credname.map"
+#define UTLIST "./ut/tmp/credname.lst"
+#define UTDUMP "./ut/tmp/credname.dump"
+#define UTMANY 500
+#define UTGETS 100000
+
+static int ut_cmp( const char *refname, const char *exp ) {
+  char credname[64];
+  const char *cn = getcredname( credname, sizeof(credname), refname );
+  if ( cn == NULL ) return exp == NULL ? 0 : 1;
+  return exp == NULL ? 1 : strcmp( cn, exp );
+}
+
+static int utmain( int argc, char *argv[] ) {
+  fprintf( stderr, "\nUNIT TEST - rdkconfig credname\n" );
+  setenv( CN_PATH_ENV, UTMAP, 1 );
+  unlink( UTMAP );
+  char credname[64];
+
+  fprintf( stderr, "UNIT TEST - no map -- expect errors\n" );
+  UT_INTCMP( (long)getcredname( credname, sizeof(credname), "utstcred" ), 0 );
+  UT_INTCMP( getcrednames_dump( stderr ), -1 );
+  UT_INTCMP( savecrednames( "./ut/tmp/nolist" ), 1 );
+  UT_INTCMP( savecrednames( NULL ), 1 );
+  UT_DOESNTEXIST( UTMAP );
+
+  fprintf( stderr, "UNIT TEST - build and look up\n" );
+  FILE *fp = fopen( UTLIST, "w" );
+  assert( fp != NULL );
+  fprintf( fp, "# test list\n\nutstcred kabcdefghijklmnop1\nutstcred2\tkabcdefghijklmnop2\n" );
+  for ( int idx = 0; idx < UTMANY; idx++ ) {
+    fprintf( fp, "utstmany%d k%016d\n", idx, idx * 7 );
+  }
+  fclose( fp );
+  UT_INTCMP( savecrednames( UTLIST ), 0 );
+  UT_EXISTS( UTMAP );
+  UT_INT0( ut_cmp( "utstcred", "kabcdefghijklmnop1" ) );
+  UT_INT0( ut_cmp( "utstcred2", "kabcdefghijklmnop2" ) );
+  UT_INT0( ut_cmp( "utstcred3", NULL ) );
+  UT_INT0( ut_cmp( "utstcre", NULL ) );
+  UT_INT0( ut_cmp( "utstmany499", "k0000000000003493" ) );
+  UT_INTCMP( (long)getcredname( credname, 18, "utstcred" ), 0 ); // does not fit
+  UT_INTCMP( (long)getcredname( credname, 19, "utstcred" ), (long)credname );
+  UT_INTCMP( (long)getcredname( NULL, 19, "utstcred" ), 0 );
+  UT_INTCMP( (long)getcredname( credname, 19, NULL ), 0 );
+
+  fprintf( stderr, "UNIT TEST - dump\n" );
+  fp = fopen( UTDUMP, "w+" );
+  assert( fp != NULL );
+  UT_INTCMP( getcrednames_dump( fp ), UTMANY + 2 );
+  rewind( fp );
+  char line[128];
+  UT_INTDIFF( (long)fgets( line, sizeof(line), fp ), 0 );
+  UT_INT0( strcmp( line, "utstcred->kabcdefghijklmnop1\n" ) );
+  fclose( fp );
+  UT_INTCMP( getcrednames_dump( NULL ), -1 );
+
+  struct timespec ts0, ts1;
+  clock_gettime( CLOCK_MONOTONIC, &ts0 );
+  for ( int idx = 0; idx < UTGETS; idx++ ) {
+    snprintf( line, sizeof(line), "utstmany%d", idx % UTMANY );
+    assert( getcredname( credname, sizeof(credname), line ) != NULL );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &ts1 );
+  fprintf( stderr, "UNIT TEST - %d lookups of %d refs, %ld ns/lookup\n", UTGETS, UTMANY,
+           ( ( ts1.tv_sec - ts0.tv_sec ) * 1000000000L + ( ts1.tv_nsec - ts0.tv_nsec ) ) / UTGETS );
+
+  fprintf( stderr, "UNIT TEST - rebuild, bad lists -- expect errors\n" );
+  fp = fopen( UTLIST, "w" );
+  assert( fp != NULL );
+  fprintf( fp, "utstcred kabcdefghijklmnopX\n" );
+  fclose( fp );
+  UT_INTCMP( savecrednames( UTLIST ), 0 );
+  UT_INT0( ut_cmp( "utstcred", "kabcdefghijklmnopX" ) ); // new map is picked up
+  UT_INT0( ut_cmp( "utstcred2", NULL ) );
+  fp = fopen( UTLIST, "w" );
+  assert( fp != NULL );
+  fprintf( fp, "utstcred kabcdefghijklmnopY\nutstcred kabcdefghijklmnopZ\n" );
+  fclose( fp );
+  UT_INTCMP( savecrednames( UTLIST ), 1 ); // listed twice
+  fp = fopen( UTLIST, "w" );
+  assert( fp != NULL );
+  fprintf( fp, "utstcred\n" );
+  fclose( fp );
+  UT_INTCMP( savecrednames( UTLIST ), 1 ); // no credname
+  UT_INT0( ut_cmp( "utstcred", "kabcdefghijklmnopX" ) ); // old map kept
+  fp = fopen( UTLIST, "w" );
+  assert( fp != NULL );
+  fclose( fp );
+  UT_INTCMP( savecrednames( UTLIST ), 0 ); // empty map
+  UT_INT0( ut_cmp( "utstcred", NULL ) );
+  UT_INTCMP( getcrednames_dump( stderr ), 0 );
+
+  fprintf( stderr, "UNIT TEST - bad map -- expect errors\n" );
+  fp = fopen( UTMAP, "r+" );
+  assert( fp != NULL );
+  fputc( 'X', fp );
+  fclose( fp );
+  UT_INT0( ut_cmp( "utstcred", NULL ) );
+  UT_INTCMP( getcrednames_dump( stderr ), -1 );
+
+  unlink( UTMAP );
+  unlink( UTLIST );
+  unlink( UTDUMP );
+  fprintf( stderr, "UNIT TEST - rdkconfig credname - SUCCESS\n" );
+  return 0;
+}
+
+#endif // UNIT_TESTS
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2024 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __RDKCONFIG_CREDNAME__
+#define __RDKCONFIG_CREDNAME__
+
+#include <stdio.h>
+
+// refname to credname map, internal to rdkconfig and its cli
+// the map file is built from a list by savecrednames, see rdkconfig_credname.c
+
+// getcredname - look up the credname of refname, copy it null terminated into credname
+// return credname, or NULL if not found or it does not fit in credname_sz
+char *getcredname( char *credname, unsigned int credname_sz, const char *refname );
+
+// getcrednames_dump - write every "refname->credname" of the map to fp, one per line, in list order
+// return number of lines, or -1 if the map can't be read
+int getcrednames_dump( FILE *fp );
+
+// savecrednames - build the map file from listpath, lines of "<refname> <credname>"
+// blank lines and lines starting with # are skipped; the map is replaced as a whole
+// return 0 on success, 1 on error
+int savecrednames( const char *listpath );
+
+#endif // __RDKCONFIG_CREDNAME__
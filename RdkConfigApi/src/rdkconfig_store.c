@@ -0,0 +1,1115 @@
+/*
+ * Copyright 2024 Comcast Cable Communications Management, LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// reference rdkconfig backend; credentials sealed with AES-256-GCM in one local store file
+//
+// store file: header, index of slots, records
+//   the index is an open addressing hash table of refname hashes, so a get maps the file,
+//   probes the index and decrypts one record
+//   each record has the refname in the clear, used as additional authenticated data,
+//   so a record can't be moved to another refname
+//   rdkconfig_set writes a new store file and renames it over the old one
+//   the header has a key check, an empty message sealed with the key, so a set with another key
+//   fails rather than leave records sealed with two keys
+// key: 32 bytes, from the key file, or if it can't be read, from a "user" key in the kernel keyring;
+//   the key of the mapped store is kept in an arena slot, locked and left out of core dumps
+// paths and key description can be changed with environment variables, see below
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <sys/syscall.h>
+#include <linux/keyctl.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include "rdkconfig.h"
+#include "rdkconfig_arena.h"
+
+#define STORE_PATH "/opt/secure/rdkconfig/credstore.bin"
+#define STORE_KEYFILE "/opt/secure/rdkconfig/credstore.key"
+#define STORE_KEYDESC "rdkconfig:credstore"
+#define STORE_PATH_ENV "RDKCONFIG_STORE"
+#define STORE_KEYFILE_ENV "RDKCONFIG_STORE_KEY"
+#define STORE_KEYDESC_ENV "RDKCONFIG_STORE_KEYDESC"
+
+#define STORE_MAGIC "RDKCS002"
+#define STORE_KEYSZ 32
+#define STORE_IVSZ 12
+#define STORE_TAGSZ 16
+#define STORE_MINSLOTS 16
+#define STORE_NAMEMAX 256
+#define STORE_DATAMAX UINT32_MAX   // record data length is 32 bits
+#define STORE_CHUNK 4096           // streamed data, the largest arena class
+#define STORE_PATHMAX 256
+#define STORE_ALIGN 8
+#define STORE_PAD(len) ( ( STORE_ALIGN - ( (len) % STORE_ALIGN ) ) % STORE_ALIGN )
+
+typedef struct {
+  char magic[8];
+  uint32_t nslots;     // index slots, power of 2
+  uint32_t count;      // records
+  uint64_t size;       // file size, to catch a truncated file
+  uint8_t kciv[STORE_IVSZ];    // key check, see store_keyCheck
+  uint8_t kctag[STORE_TAGSZ];
+} storehdr_t;
+
+typedef struct {
+  uint64_t hash;       // hash of refname, 0 for an empty slot
+  uint64_t off;        // record offset in file
+  uint64_t len;        // record length, records start on STORE_ALIGN
+} storeslot_t;
+
+typedef struct {
+  uint32_t namelen;
+  uint32_t datalen;
+  uint8_t iv[STORE_IVSZ];
+  uint8_t tag[STORE_TAGSZ];
+  // followed by refname and ciphertext
+} storerec_t;
+
+// mapped store and its key, reused until the store file changes
+typedef struct {
+  uint8_t *map;
+  size_t mapsz;
+  dev_t dev;
+  ino_t ino;
+  struct timespec mtim;
+  uint8_t *key;        // STORE_KEYSZ bytes, arena slot
+} storecache_t;
+
+// a credential to store, see store_put
+typedef struct {
+  const char *refname;
+  const uint8_t *sbuff;        // data, if fd is -1
+  size_t sbuffsz;
+  int fd;                      // data read to end of file, or -1
+  int status;                  // RDKCONFIG_OK once stored
+  uint64_t hash;
+  const uint8_t *replaced;     // old record of refname, left out of the new store
+} storeput_t;
+
+static storecache_t store_cache;
+static pthread_mutex_t store_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const char *store_path( void );
+static uint64_t store_hash( const char *refname, size_t namelen );
+static void store_wipe( volatile void *mem, size_t sz );
+static int store_loadKey( uint8_t *key );
+static int store_keyCheck( const uint8_t *key, storehdr_t *hdr, int seal );
+static void store_unmap( void );
+static int store_map( void );
+static const storerec_t *store_find( const uint8_t *map, const char *refname );
+static int store_get( const char *refname, uint8_t **sbuff, size_t extra, uint8_t *buf, size_t cap, size_t *datalen );
+static int store_decrypt( EVP_CIPHER_CTX *ctx, const storerec_t *rec, uint8_t *buff );
+static int store_put( storeput_t *items, size_t n );
+static uint64_t store_seal( EVP_CIPHER_CTX *ctx, const uint8_t *key, int fd, uint64_t off, const storeput_t *item,
+                            uint8_t *chunk, uint8_t *cipher );
+static void store_slot( storeslot_t *slots, uint32_t nslots, uint64_t hash, uint64_t off, uint64_t len );
+static int store_stream( EVP_CIPHER_CTX *ctx, const storerec_t *rec, uint8_t *chunk, int fd );
+static ssize_t store_read( int fd, uint8_t *buf, size_t cap );
+static int store_write( int fd, const void *data, size_t len );
+
+// rdkconfig_get - get credential by reference name, allocate space, fill buffer
+// return new buffer and size of data (actual memory buffer may be larger)
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_get( uint8_t **sbuff, size_t *sbuffsz, const char *refname ) {
+  if ( sbuff == NULL || sbuffsz == NULL || refname == NULL ) {
+    return RDKCONFIG_FAIL;
+  }
+  return store_get( refname, sbuff, 0, NULL, 0, sbuffsz );
+}
+
+// rdkconfig_getStr - get credential by reference name, allocate space, fill buffer, add null terminator
+// return new buffer and size of data including null terminator (actual memory buffer may be larger)
+// (after retrieved credential will come a '\0', null terminator)
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getStr( char **sbuff, size_t *sbuffsz, const char *refname ) {
+  if ( sbuff == NULL || sbuffsz == NULL || refname == NULL ) {
+    return RDKCONFIG_FAIL;
+  }
+  size_t datalen = 0;
+  if ( store_get( refname, (uint8_t **)sbuff, 1, NULL, 0, &datalen ) != RDKCONFIG_OK ) {
+    return RDKCONFIG_FAIL;
+  }
+  (*sbuff)[datalen] = '\0';
+  *sbuffsz = datalen + 1;
+  return RDKCONFIG_OK;
+}
+
+// rdkconfig_getInto - get credential by reference name into caller buffer, no allocation
+// fills up to cap bytes of buf, no null terminator is added; returns size of data in len
+// if the data does not fit, len is the size needed and buf is not filled, otherwise on failure len is 0
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getInto( const char *refname, uint8_t *buf, size_t cap, size_t *len ) {
+  if ( refname == NULL || buf == NULL || len == NULL ) {
+    return RDKCONFIG_FAIL;
+  }
+  return store_get( refname, NULL, 0, buf, cap, len );
+}
+
+// rdkconfig_getMany - get n credentials by reference name in one call
+// the store is checked and mapped and its key loaded once for the set, one cipher context decrypts every record
+// return value: RDKCONFIG_OK if every credential was found, otherwise RDKCONFIG_FAIL, see status of each
+int rdkconfig_getMany( const char **refnames, size_t n, rdkconfig_buf_t out[] ) {
+  if ( ( refnames == NULL || out == NULL ) && n != 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+  int retval = RDKCONFIG_OK;
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    out[idx].buf = NULL;
+    out[idx].len = 0;
+    out[idx].status = RDKCONFIG_FAIL;
+  }
+  if ( n == 0 ) {
+    return RDKCONFIG_OK;
+  }
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  pthread_mutex_lock( &store_mutex );
+  if ( ctx == NULL || store_map() != RDKCONFIG_OK ) {
+    pthread_mutex_unlock( &store_mutex );
+    EVP_CIPHER_CTX_free( ctx );
+    return RDKCONFIG_FAIL;
+  }
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    const storerec_t *rec = refnames[idx] ? store_find( store_cache.map, refnames[idx] ) : NULL;
+    uint8_t *buff = rec ? rdkconfig_arenaAlloc( rec->datalen + 1 ) : NULL;
+    if ( buff == NULL ) {
+      retval = RDKCONFIG_FAIL;
+      continue;
+    }
+    if ( store_decrypt( ctx, rec, buff ) != RDKCONFIG_OK ) {
+      fprintf( stderr, "rdkconfig: error, unable to decrypt %s\n", refnames[idx] );
+      rdkconfig_arenaFree( buff, rec->datalen );
+      retval = RDKCONFIG_FAIL;
+      continue;
+    }
+    buff[rec->datalen] = '\0';
+    out[idx].buf = buff;
+    out[idx].len = rec->datalen;
+    out[idx].status = RDKCONFIG_OK;
+  }
+  pthread_mutex_unlock( &store_mutex );
+  EVP_CIPHER_CTX_free( ctx );
+  return retval;
+}
+
+// rdkconfig_getToFd - get credential by reference name and write the data to file descriptor fd
+// the record is authenticated before any of it is written, then decrypted again a chunk at a time as it is written
+// other gets wait while fd is written
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_getToFd( const char *refname, int fd ) {
+  if ( refname == NULL || fd < 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+  int retval = RDKCONFIG_FAIL;
+  const storerec_t *rec = NULL;
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  uint8_t *chunk = rdkconfig_arenaAlloc( STORE_CHUNK );
+  pthread_mutex_lock( &store_mutex );
+  if ( ctx != NULL && chunk != NULL && store_map() == RDKCONFIG_OK ) {
+    rec = store_find( store_cache.map, refname );
+  }
+  if ( rec != NULL ) {
+    if ( store_stream( ctx, rec, chunk, -1 ) != RDKCONFIG_OK ) {
+      fprintf( stderr, "rdkconfig: error, unable to decrypt %s\n", refname );
+    } else if ( store_stream( ctx, rec, chunk, fd ) != RDKCONFIG_OK ) {
+      fprintf( stderr, "rdkconfig: error, unable to write %s\n", refname );
+    } else {
+      retval = RDKCONFIG_OK;
+    }
+  }
+  pthread_mutex_unlock( &store_mutex );
+  EVP_CIPHER_CTX_free( ctx );
+  rdkconfig_arenaFree( chunk, STORE_CHUNK );
+  return retval;
+}
+
+// rdkconfig_set - store credential by reference name
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+// (for string data, the null terminator does not need to be included in sbuffsz as long as
+//   it is retrieved using rdkconfig_getStr)
+int rdkconfig_set( const char *refname, uint8_t *sbuff, size_t sbuffsz ) {
+  if ( refname == NULL || ( sbuff == NULL && sbuffsz != 0 ) ) {
+    return RDKCONFIG_FAIL;
+  }
+  if ( sbuffsz > STORE_DATAMAX ) {
+    fprintf( stderr, "rdkconfig_set: error, bad size\n" );
+    return RDKCONFIG_FAIL;
+  }
+  storeput_t item = { .refname = refname, .sbuff = sbuff, .sbuffsz = sbuffsz, .fd = -1 };
+  return store_put( &item, 1 );
+}
+
+// rdkconfig_setFromFd - store credential by reference name, data read from file descriptor fd to end of file
+// the data is read and sealed a chunk at a time, so its size does not change the memory used
+// return value: RDKCONFIG_OK or RDKCONFIG_FAIL
+int rdkconfig_setFromFd( const char *refname, int fd ) {
+  if ( refname == NULL || fd < 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+  storeput_t item = { .refname = refname, .fd = fd };
+  return store_put( &item, 1 );
+}
+
+// rdkconfig_setManyFromFd - store n credentials, refnames[i] read from fds[i] to end of file, in one update
+// the store is locked, its key loaded and a new store file written once for the set
+// return value: RDKCONFIG_OK if every credential was stored, otherwise RDKCONFIG_FAIL, see status of each
+int rdkconfig_setManyFromFd( const char **refnames, const int *fds, size_t n, int status[] ) {
+  if ( ( refnames == NULL || fds == NULL || status == NULL ) && n != 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+  if ( n == 0 ) {
+    return RDKCONFIG_OK;
+  }
+  storeput_t *items = calloc( n, sizeof(storeput_t) );
+  if ( items == NULL ) {
+    for ( size_t idx = 0; idx < n; idx++ ) status[idx] = RDKCONFIG_FAIL;
+    return RDKCONFIG_FAIL;
+  }
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    items[idx].refname = ( fds[idx] >= 0 ) ? refnames[idx] : NULL; // no data, not stored
+    items[idx].fd = fds[idx];
+  }
+  int retval = store_put( items, n );
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    status[idx] = items[idx].status;
+  }
+  free( items );
+  return retval;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// INTERNAL STATIC FUNCTIONS
+
+// store_put - seal the items as records and write a new store file with them, one rewrite for the set
+// an item's data is its sbuff of sbuffsz bytes, or if its fd is not -1, read from fd to end of file
+// each new record is sealed a chunk at a time as it is written, then the old records not replaced are copied;
+// the header and index go in last, when their length is known
+// an item that can't be sealed, e.g. its fd can't be read, is left out with status RDKCONFIG_FAIL;
+// if the store can't be written, every item fails; returns RDKCONFIG_OK if every item was stored
+static int store_put( storeput_t *items, size_t n ) {
+  const char *path = store_path();
+  char tmppath[STORE_PATHMAX+8], lockpath[STORE_PATHMAX+8];
+  snprintf( tmppath, sizeof(tmppath), "%s.tmp", path );
+  snprintf( lockpath, sizeof(lockpath), "%s.lock", path );
+
+  // check names; a refname listed twice is only stored the first time
+  size_t valid = 0;
+  int anyfd = 0;
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    storeput_t *item = &items[idx];
+    item->status = RDKCONFIG_FAIL;
+    item->replaced = NULL;
+    if ( item->refname == NULL ) continue; // nothing to store
+    size_t namelen = strlen( item->refname );
+    if ( namelen == 0 || namelen > STORE_NAMEMAX ) {
+      fprintf( stderr, "rdkconfig_set: error, bad size\n" );
+      continue;
+    }
+    item->hash = store_hash( item->refname, namelen );
+    size_t prev;
+    for ( prev = 0; prev < idx; prev++ ) {
+      if ( items[prev].status == RDKCONFIG_OK && items[prev].hash == item->hash && strcmp( items[prev].refname, item->refname ) == 0 ) {
+        break;
+      }
+    }
+    if ( prev < idx ) {
+      fprintf( stderr, "rdkconfig_set: error, %s listed twice\n", item->refname );
+      continue;
+    }
+    item->status = RDKCONFIG_OK; // for now, to be sealed
+    anyfd |= ( item->fd >= 0 );
+    valid++;
+  }
+  if ( valid == 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+
+  int retval = RDKCONFIG_FAIL;
+  uint8_t *key = rdkconfig_arenaAlloc( STORE_KEYSZ );
+  uint8_t cipher[STORE_CHUNK];
+  uint8_t *chunk = NULL;
+  EVP_CIPHER_CTX *ctx = NULL;
+  storeslot_t *slots = NULL;
+  int tmpfd = -1;
+
+  pthread_mutex_lock( &store_mutex );
+  // serialize writers across processes; readers only see complete files
+  int lockfd = open( lockpath, O_RDWR|O_CREAT|O_CLOEXEC, 0600 );
+  if ( lockfd < 0 || flock( lockfd, LOCK_EX ) != 0 ) {
+    fprintf( stderr, "rdkconfig_set: error, unable to lock store\n" );
+    goto done;
+  }
+  // the key is read again on each set, in case it was changed
+  store_unmap();
+  if ( key == NULL || store_loadKey( key ) != RDKCONFIG_OK ) {
+    fprintf( stderr, "rdkconfig_set: error, no store key\n" );
+    goto done;
+  }
+  // old records are copied without a decrypt, so the store must be sealed with this key
+  if ( store_map() != RDKCONFIG_OK && errno != ENOENT ) {
+    fprintf( stderr, "rdkconfig_set: error, %s\n", errno == EKEYREJECTED ? "key does not match store" : "unable to read store" );
+    goto done;
+  }
+  // size new index for the old records plus the new ones, at most half full
+  const storehdr_t *oldhdr = (const storehdr_t *)store_cache.map;
+  const storeslot_t *oldslots = oldhdr ? (const storeslot_t *)(oldhdr + 1) : NULL;
+  uint32_t oldslotcnt = oldhdr ? oldhdr->nslots : 0;
+  uint64_t count = valid;
+  for ( uint32_t oidx = 0; oidx < oldslotcnt; oidx++ ) {
+    if ( oldslots[oidx].hash != 0 ) count++;
+  }
+  uint32_t nslots = STORE_MINSLOTS;
+  while ( nslots < count * 2 ) nslots <<= 1;
+  slots = calloc( nslots, sizeof(storeslot_t) );
+  ctx = EVP_CIPHER_CTX_new();
+  chunk = anyfd ? rdkconfig_arenaAlloc( STORE_CHUNK ) : NULL;
+  if ( slots == NULL || ctx == NULL || ( anyfd && chunk == NULL ) ) goto done;
+
+  tmpfd = open( tmppath, O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0600 );
+  if ( tmpfd < 0 ) {
+    fprintf( stderr, "rdkconfig_set: error, unable to create store\n" );
+    goto done;
+  }
+  // new records first, after the index; one that can't be sealed is overwritten by the next, or cut off
+  static const uint8_t pad[STORE_ALIGN];
+  uint64_t off = sizeof(storehdr_t) + (uint64_t)nslots * sizeof(storeslot_t);
+  uint32_t used = 0;
+  size_t sealed = 0;
+  int wrerr = 0;
+  for ( size_t idx = 0; idx < n && wrerr == 0; idx++ ) {
+    storeput_t *item = &items[idx];
+    if ( item->status != RDKCONFIG_OK ) continue;
+    uint64_t newlen = store_seal( ctx, key, tmpfd, off, item, chunk, cipher );
+    if ( newlen == 0 ) {
+      fprintf( stderr, "rdkconfig_set: error, unable to seal %s\n", item->refname );
+      item->status = RDKCONFIG_FAIL;
+      continue;
+    }
+    if ( store_cache.map != NULL ) {
+      item->replaced = (const uint8_t *)store_find( store_cache.map, item->refname );
+    }
+    store_slot( slots, nslots, item->hash, off, newlen );
+    wrerr |= lseek( tmpfd, off + newlen, SEEK_SET ) < 0 || store_write( tmpfd, pad, STORE_PAD( newlen ) );
+    off += newlen + STORE_PAD( newlen );
+    used++;
+    sealed++;
+  }
+
+  // old records are copied as they are, no decrypt needed; only those replaced by a sealed record are left out,
+  // so a credential whose new data can't be read keeps its old record
+  wrerr |= ( lseek( tmpfd, off, SEEK_SET ) < 0 );
+  for ( uint32_t oidx = 0; oidx < oldslotcnt && wrerr == 0 && sealed != 0; oidx++ ) {
+    if ( oldslots[oidx].hash == 0 ) continue;
+    if ( oldslots[oidx].off > oldhdr->size || oldslots[oidx].len > oldhdr->size - oldslots[oidx].off ) {
+      fprintf( stderr, "rdkconfig_set: error, bad store file %s\n", path );
+      unlink( tmppath );
+      goto done;
+    }
+    const uint8_t *rec = store_cache.map + oldslots[oidx].off;
+    size_t idx;
+    for ( idx = 0; idx < n; idx++ ) {
+      if ( items[idx].status == RDKCONFIG_OK && items[idx].hash == oldslots[oidx].hash && items[idx].replaced == rec ) break;
+    }
+    if ( idx < n ) continue;
+    store_slot( slots, nslots, oldslots[oidx].hash, off, oldslots[oidx].len );
+    wrerr |= store_write( tmpfd, rec, oldslots[oidx].len );
+    wrerr |= store_write( tmpfd, pad, STORE_PAD( oldslots[oidx].len ) );
+    off += oldslots[oidx].len + STORE_PAD( oldslots[oidx].len );
+    used++;
+  }
+  if ( wrerr == 0 && sealed == 0 ) {
+    unlink( tmppath ); // nothing new, the store is left as it is
+    goto done;
+  }
+
+  storehdr_t hdr;
+  memset( &hdr, 0, sizeof(hdr) );
+  memcpy( hdr.magic, STORE_MAGIC, sizeof(hdr.magic) );
+  hdr.nslots = nslots;
+  hdr.count = used;
+  hdr.size = off;
+  wrerr = wrerr || ftruncate( tmpfd, off ) != 0 || store_keyCheck( key, &hdr, 1 ) != RDKCONFIG_OK ||
+          lseek( tmpfd, 0, SEEK_SET ) < 0 || store_write( tmpfd, &hdr, sizeof(hdr) ) ||
+          store_write( tmpfd, slots, (size_t)nslots * sizeof(storeslot_t) );
+  if ( wrerr != 0 || fsync( tmpfd ) != 0 ) {
+    fprintf( stderr, "rdkconfig_set: error, unable to write store\n" );
+    unlink( tmppath );
+    goto done;
+  }
+  if ( rename( tmppath, path ) != 0 ) {
+    fprintf( stderr, "rdkconfig_set: error, unable to replace store\n" );
+    unlink( tmppath );
+    goto done;
+  }
+  retval = RDKCONFIG_OK;
+
+done:
+  store_unmap(); // next get maps the new file
+  if ( tmpfd >= 0 ) close( tmpfd );
+  if ( lockfd >= 0 ) close( lockfd ); // releases flock
+  pthread_mutex_unlock( &store_mutex );
+  rdkconfig_arenaFree( key, STORE_KEYSZ );
+  EVP_CIPHER_CTX_free( ctx );
+  rdkconfig_arenaFree( chunk, STORE_CHUNK );
+  free( slots );
+  int stored = ( retval == RDKCONFIG_OK );
+  for ( size_t idx = 0; idx < n; idx++ ) {
+    if ( !stored ) {
+      items[idx].status = RDKCONFIG_FAIL; // nothing was stored
+    } else if ( items[idx].status != RDKCONFIG_OK ) {
+      retval = RDKCONFIG_FAIL;
+    }
+  }
+  return retval;
+} // store_put( )
+
+// store_seal - seal item as a new record at off in fd; refname then the data sealed with a new random iv,
+// refname is authenticated; the record header goes in last, when the data length is known
+// caller holds store_mutex; returns the length of the record, or 0 on error
+static uint64_t store_seal( EVP_CIPHER_CTX *ctx, const uint8_t *key, int fd, uint64_t off, const storeput_t *item,
+                            uint8_t *chunk, uint8_t *cipher ) {
+  size_t namelen = strlen( item->refname );
+  storerec_t newrec;
+  memset( &newrec, 0, sizeof(newrec) );
+  newrec.namelen = namelen;
+  uint64_t datalen = 0;
+  int outl = 0;
+  if ( RAND_bytes( newrec.iv, STORE_IVSZ ) != 1 ||
+       EVP_EncryptInit_ex( ctx, EVP_aes_256_gcm(), NULL, key, newrec.iv ) != 1 ||
+       EVP_EncryptUpdate( ctx, NULL, &outl, (const uint8_t *)item->refname, namelen ) != 1 ||
+       lseek( fd, off + sizeof(newrec), SEEK_SET ) < 0 || store_write( fd, item->refname, namelen ) ) {
+    return 0;
+  }
+  for ( ;; ) {
+    const uint8_t *in = chunk;
+    size_t inlen = 0;
+    if ( item->fd < 0 ) {
+      in = item->sbuff + datalen;
+      inlen = ( item->sbuffsz - datalen < STORE_CHUNK ) ? item->sbuffsz - datalen : STORE_CHUNK;
+    } else {
+      ssize_t rdsz = store_read( item->fd, chunk, STORE_CHUNK );
+      if ( rdsz < 0 ) {
+        fprintf( stderr, "rdkconfig_set: error, unable to read data\n" );
+        return 0;
+      }
+      inlen = rdsz;
+    }
+    if ( inlen == 0 ) break;
+    if ( datalen + inlen > STORE_DATAMAX ) {
+      fprintf( stderr, "rdkconfig_set: error, bad size\n" );
+      return 0;
+    }
+    if ( EVP_EncryptUpdate( ctx, cipher, &outl, in, inlen ) != 1 || store_write( fd, cipher, outl ) ) {
+      return 0;
+    }
+    datalen += inlen;
+  }
+  if ( item->fd >= 0 ) {
+    store_wipe( chunk, STORE_CHUNK );
+  }
+  newrec.datalen = datalen;
+  if ( EVP_EncryptFinal_ex( ctx, cipher, &outl ) != 1 ||
+       EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_GET_TAG, STORE_TAGSZ, newrec.tag ) != 1 ||
+       lseek( fd, off, SEEK_SET ) < 0 || store_write( fd, &newrec, sizeof(newrec) ) ) {
+    return 0;
+  }
+  return sizeof(newrec) + namelen + datalen;
+}
+
+// store_path - store file path, from environment or default
+static const char *store_path( void ) {
+  const char *path = getenv( STORE_PATH_ENV );
+  if ( path == NULL || *path == '\0' || strlen( path ) > STORE_PATHMAX ) {
+    path = STORE_PATH;
+  }
+  return path;
+}
+
+// store_hash - FNV-1a of refname, never 0 since 0 marks an empty slot
+static uint64_t store_hash( const char *refname, size_t namelen ) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for ( size_t idx = 0; idx < namelen; idx++ ) {
+    hash ^= (uint8_t)refname[idx];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash ? hash : 1;
+}
+
+// store_wipe - wipe memory without getting optimized out
+static void store_wipe( volatile void *mem, size_t sz ) {
+  volatile uint8_t *ptr = (volatile uint8_t *)mem;
+  while ( sz-- ) *ptr++ = 0;
+}
+
+// store_loadKey - read key from key file, or from the kernel keyring
+static int store_loadKey( uint8_t *key ) {
+  const char *keyfile = getenv( STORE_KEYFILE_ENV );
+  if ( keyfile == NULL || *keyfile == '\0' ) keyfile = STORE_KEYFILE;
+  int fd = open( keyfile, O_RDONLY|O_CLOEXEC );
+  if ( fd >= 0 ) {
+    uint8_t buf[STORE_KEYSZ+1];
+    ssize_t rdsz = read( fd, buf, sizeof(buf) );
+    close( fd );
+    if ( rdsz == STORE_KEYSZ ) {
+      memcpy( key, buf, STORE_KEYSZ );
+    }
+    store_wipe( buf, sizeof(buf) );
+    if ( rdsz == STORE_KEYSZ ) return RDKCONFIG_OK;
+    fprintf( stderr, "rdkconfig: error, key file is not %d bytes\n", STORE_KEYSZ );
+    return RDKCONFIG_FAIL;
+  }
+  const char *keydesc = getenv( STORE_KEYDESC_ENV );
+  if ( keydesc == NULL || *keydesc == '\0' ) keydesc = STORE_KEYDESC;
+  long keyid = syscall( SYS_request_key, "user", keydesc, NULL, 0 );
+  if ( keyid < 0 ) {
+    return RDKCONFIG_FAIL;
+  }
+  uint8_t buf[STORE_KEYSZ+1];
+  long rdsz = syscall( SYS_keyctl, KEYCTL_READ, keyid, buf, sizeof(buf) );
+  if ( rdsz == STORE_KEYSZ ) {
+    memcpy( key, buf, STORE_KEYSZ );
+  }
+  store_wipe( buf, sizeof(buf) );
+  return rdsz == STORE_KEYSZ ? RDKCONFIG_OK : RDKCONFIG_FAIL;
+}
+
+// store_keyCheck - seal an empty message, the magic as authenticated data, with key into hdr;
+// or if seal is 0, check the one in hdr opens with key
+static int store_keyCheck( const uint8_t *key, storehdr_t *hdr, int seal ) {
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  uint8_t final[STORE_TAGSZ];
+  int outl = 0, retval = RDKCONFIG_FAIL;
+  if ( ctx == NULL ) {
+    return RDKCONFIG_FAIL;
+  }
+  if ( seal ) {
+    if ( RAND_bytes( hdr->kciv, STORE_IVSZ ) == 1 &&
+         EVP_EncryptInit_ex( ctx, EVP_aes_256_gcm(), NULL, key, hdr->kciv ) == 1 &&
+         EVP_EncryptUpdate( ctx, NULL, &outl, (const uint8_t *)hdr->magic, sizeof(hdr->magic) ) == 1 &&
+         EVP_EncryptFinal_ex( ctx, final, &outl ) == 1 &&
+         EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_GET_TAG, STORE_TAGSZ, hdr->kctag ) == 1 ) {
+      retval = RDKCONFIG_OK;
+    }
+  } else {
+    if ( EVP_DecryptInit_ex( ctx, EVP_aes_256_gcm(), NULL, key, hdr->kciv ) == 1 &&
+         EVP_DecryptUpdate( ctx, NULL, &outl, (const uint8_t *)hdr->magic, sizeof(hdr->magic) ) == 1 &&
+         EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_SET_TAG, STORE_TAGSZ, hdr->kctag ) == 1 &&
+         EVP_DecryptFinal_ex( ctx, final, &outl ) == 1 ) {
+      retval = RDKCONFIG_OK;
+    }
+  }
+  EVP_CIPHER_CTX_free( ctx );
+  return retval;
+}
+
+// store_unmap - drop the mapped store and its key; caller holds store_mutex
+static void store_unmap( void ) {
+  if ( store_cache.map != NULL ) {
+    munmap( store_cache.map, store_cache.mapsz );
+  }
+  rdkconfig_arenaFree( store_cache.key, STORE_KEYSZ );
+  store_wipe( &store_cache, sizeof(store_cache) );
+  store_cache.map = NULL;
+  store_cache.key = NULL;
+}
+
+// store_map - map the store file, unless it is mapped and has not changed; caller holds store_mutex
+// one stat per call when nothing changed; errno is ENOENT if there is no store file,
+// ENOKEY if there is no key and EKEYREJECTED if the key does not match the store
+static int store_map( void ) {
+  struct stat st;
+  const char *path = store_path();
+  if ( stat( path, &st ) != 0 ) {
+    int err = errno;
+    store_unmap();
+    errno = err;
+    return RDKCONFIG_FAIL;
+  }
+  if ( store_cache.map != NULL && st.st_dev == store_cache.dev && st.st_ino == store_cache.ino &&
+       (size_t)st.st_size == store_cache.mapsz && st.st_mtim.tv_sec == store_cache.mtim.tv_sec &&
+       st.st_mtim.tv_nsec == store_cache.mtim.tv_nsec ) {
+    return RDKCONFIG_OK;
+  }
+  store_unmap();
+  errno = EINVAL;
+  int fd = open( path, O_RDONLY|O_CLOEXEC );
+  if ( fd < 0 ) return RDKCONFIG_FAIL;
+  if ( fstat( fd, &st ) != 0 || (size_t)st.st_size < sizeof(storehdr_t) ) {
+    close( fd );
+    errno = EINVAL;
+    return RDKCONFIG_FAIL;
+  }
+  void *map = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+  close( fd );
+  if ( map == MAP_FAILED ) return RDKCONFIG_FAIL;
+  // check header and index fit the file, records are checked when used
+  const storehdr_t *hdr = (const storehdr_t *)map;
+  if ( memcmp( hdr->magic, STORE_MAGIC, sizeof(hdr->magic) ) != 0 || hdr->size != (uint64_t)st.st_size ||
+       hdr->nslots == 0 || ( hdr->nslots & ( hdr->nslots - 1 ) ) != 0 ||
+       sizeof(storehdr_t) + (uint64_t)hdr->nslots * sizeof(storeslot_t) > hdr->size ) {
+    fprintf( stderr, "rdkconfig: error, bad store file %s\n", path );
+    munmap( map, st.st_size );
+    errno = EINVAL;
+    return RDKCONFIG_FAIL;
+  }
+  uint8_t *key = rdkconfig_arenaAlloc( STORE_KEYSZ );
+  if ( key == NULL || store_loadKey( key ) != RDKCONFIG_OK ) {
+    munmap( map, st.st_size );
+    rdkconfig_arenaFree( key, STORE_KEYSZ );
+    errno = ENOKEY;
+    return RDKCONFIG_FAIL;
+  }
+  if ( store_keyCheck( key, (storehdr_t *)hdr, 0 ) != RDKCONFIG_OK ) {
+    fprintf( stderr, "rdkconfig: error, key does not match store %s\n", path );
+    munmap( map, st.st_size );
+    rdkconfig_arenaFree( key, STORE_KEYSZ );
+    errno = EKEYREJECTED;
+    return RDKCONFIG_FAIL;
+  }
+  store_cache.key = key;
+  store_cache.map = map;
+  store_cache.mapsz = st.st_size;
+  store_cache.dev = st.st_dev;
+  store_cache.ino = st.st_ino;
+  store_cache.mtim = st.st_mtim;
+  return RDKCONFIG_OK;
+}
+
+// store_find - probe the index for refname, return its record or NULL
+static const storerec_t *store_find( const uint8_t *map, const char *refname ) {
+  const storehdr_t *hdr = (const storehdr_t *)map;
+  const storeslot_t *slots = (const storeslot_t *)(hdr + 1);
+  size_t namelen = strlen( refname );
+  uint64_t hash = store_hash( refname, namelen );
+  uint32_t mask = hdr->nslots - 1;
+  for ( uint32_t probe = 0, sidx = (uint32_t)hash & mask; probe < hdr->nslots; probe++, sidx = ( sidx + 1 ) & mask ) {
+    const storeslot_t *slot = &slots[sidx];
+    if ( slot->hash == 0 ) break;
+    if ( slot->hash != hash ) continue;
+    if ( slot->off > hdr->size || slot->len > hdr->size - slot->off || slot->len < sizeof(storerec_t) ||
+         ( slot->off % STORE_ALIGN ) != 0 ) {
+      break; // corrupt index
+    }
+    const storerec_t *rec = (const storerec_t *)( map + slot->off );
+    if ( sizeof(storerec_t) + (uint64_t)rec->namelen + rec->datalen != slot->len ) {
+      break; // corrupt record
+    }
+    if ( rec->namelen == namelen && memcmp( rec + 1, refname, namelen ) == 0 ) {
+      return rec;
+    }
+  }
+  return NULL;
+}
+
+// store_get - look up refname and decrypt its record
+// into a new buffer in sbuff with extra bytes after the data, or if sbuff is NULL, into buf of cap bytes
+// datalen is the size of the data, also when it does not fit in buf
+static int store_get( const char *refname, uint8_t **sbuff, size_t extra, uint8_t *buf, size_t cap, size_t *datalen ) {
+  int retval = RDKCONFIG_FAIL;
+  uint8_t *buff = NULL;
+  EVP_CIPHER_CTX *ctx = NULL;
+  const storerec_t *rec = NULL;
+  *datalen = 0;
+  pthread_mutex_lock( &store_mutex );
+  if ( store_map() != RDKCONFIG_OK ) goto done;
+  rec = store_find( store_cache.map, refname );
+  if ( rec == NULL ) goto done;
+  if ( sbuff == NULL && rec->datalen > cap ) {
+    *datalen = rec->datalen;
+    rec = NULL;
+    goto done;
+  }
+  buff = sbuff ? rdkconfig_arenaAlloc( rec->datalen + extra ) : buf;
+  ctx = EVP_CIPHER_CTX_new();
+  if ( buff == NULL || ctx == NULL || store_decrypt( ctx, rec, buff ) != RDKCONFIG_OK ) {
+    fprintf( stderr, "rdkconfig: error, unable to decrypt %s\n", refname );
+    goto done;
+  }
+  *datalen = rec->datalen;
+  if ( sbuff != NULL ) *sbuff = buff;
+  buff = NULL;
+  retval = RDKCONFIG_OK;
+
+done:
+  pthread_mutex_unlock( &store_mutex );
+  EVP_CIPHER_CTX_free( ctx );
+  if ( buff != NULL ) { // data is not returned if the tag does not match
+    if ( sbuff != NULL ) {
+      rdkconfig_arenaFree( buff, rec->datalen );
+    } else {
+      store_wipe( buff, rec->datalen );
+    }
+  }
+  return retval;
+}
+
+// store_decrypt - decrypt record rec into buff and check its tag, with the mapped store's key
+// caller holds store_mutex; ctx can be reused for the next record
+static int store_decrypt( EVP_CIPHER_CTX *ctx, const storerec_t *rec, uint8_t *buff ) {
+  const uint8_t *name = (const uint8_t *)( rec + 1 );
+  const uint8_t *cipher = name + rec->namelen;
+  int outl = 0;
+  if ( EVP_DecryptInit_ex( ctx, EVP_aes_256_gcm(), NULL, store_cache.key, rec->iv ) != 1 ||
+       EVP_DecryptUpdate( ctx, NULL, &outl, name, rec->namelen ) != 1 ||
+       EVP_DecryptUpdate( ctx, buff, &outl, cipher, rec->datalen ) != 1 ||
+       EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_SET_TAG, STORE_TAGSZ, (void *)rec->tag ) != 1 ||
+       EVP_DecryptFinal_ex( ctx, buff + outl, &outl ) != 1 ) {
+    return RDKCONFIG_FAIL;
+  }
+  return RDKCONFIG_OK;
+}
+
+// store_slot - put a record in the index, linear probing from its hash
+static void store_slot( storeslot_t *slots, uint32_t nslots, uint64_t hash, uint64_t off, uint64_t len ) {
+  uint32_t sidx = (uint32_t)hash & ( nslots - 1 );
+  while ( slots[sidx].hash != 0 ) sidx = ( sidx + 1 ) & ( nslots - 1 );
+  slots[sidx].hash = hash;
+  slots[sidx].off = off;
+  slots[sidx].len = len;
+}
+
+// store_stream - decrypt record rec a chunk at a time through chunk, of STORE_CHUNK bytes, and check its tag
+// each chunk is written to fd, or if fd is -1 only the tag is checked; chunk is left wiped
+// caller holds store_mutex
+static int store_stream( EVP_CIPHER_CTX *ctx, const storerec_t *rec, uint8_t *chunk, int fd ) {
+  const uint8_t *name = (const uint8_t *)( rec + 1 );
+  const uint8_t *cipher = name + rec->namelen;
+  int outl = 0, wrerr = 0;
+  if ( EVP_DecryptInit_ex( ctx, EVP_aes_256_gcm(), NULL, store_cache.key, rec->iv ) != 1 ||
+       EVP_DecryptUpdate( ctx, NULL, &outl, name, rec->namelen ) != 1 ) {
+    return RDKCONFIG_FAIL;
+  }
+  for ( size_t done = 0, inlen = 0; done < rec->datalen && wrerr == 0; done += inlen ) {
+    inlen = ( rec->datalen - done < STORE_CHUNK ) ? rec->datalen - done : STORE_CHUNK;
+    if ( EVP_DecryptUpdate( ctx, chunk, &outl, cipher + done, inlen ) != 1 ) {
+      wrerr = 1;
+    } else if ( fd >= 0 ) {
+      wrerr = store_write( fd, chunk, outl );
+    }
+  }
+  store_wipe( chunk, STORE_CHUNK );
+  if ( wrerr != 0 ||
+       EVP_CIPHER_CTX_ctrl( ctx, EVP_CTRL_GCM_SET_TAG, STORE_TAGSZ, (void *)rec->tag ) != 1 ||
+       EVP_DecryptFinal_ex( ctx, chunk, &outl ) != 1 ) {
+    return RDKCONFIG_FAIL;
+  }
+  return RDKCONFIG_OK;
+}
+
+// store_read - read from fd until cap bytes or end of file, return bytes read or -1
+static ssize_t store_read( int fd, uint8_t *buf, size_t cap ) {
+  size_t len = 0;
+  while ( len < cap ) {
+    ssize_t rdsz = read( fd, buf + len, cap - len );
+    if ( rdsz < 0 && errno == EINTR ) continue;
+    if ( rdsz < 0 ) return -1;
+    if ( rdsz == 0 ) break;
+    len += rdsz;
+  }
+  return len;
+}
+
+// store_write - write all of data, return 0 on success
+static int store_write( int fd, const void *data, size_t len ) {
+  const uint8_t *ptr = data;
+  while ( len > 0 ) {
+    ssize_t wrsz = write( fd, ptr, len );
+    if ( wrsz < 0 && errno == EINTR ) continue;
+    if ( wrsz <= 0 ) return 1;
+    ptr += wrsz;
+    len -= wrsz;
+  }
+  return 0;
+}
+
+#ifdef UNIT_TESTS
+static int utmain( int argc, char *argv[] );
+
+int main( int argc, char *argv[] ) {
+  return utmain( argc, argv );
+}
+
+#include <time.h>
+#include "unit_test.h"
+
+#define UTSTORE "./ut/tmp/credstore.bin"
+#define UTKEY "./ut/tmp/credstore.key"
+#define UTKEYDESC "rdkconfig:utcredstore"
+#define UTMANY 200
+#define UTGETS 10000
+#define UTPLAIN "./ut/tmp/plain.bin"
+#define UTBIG ( 1024*1024 + 123 )
+
+static int ut_fileFd( const char *path, int flags ) {
+  int fd = open( path, flags, 0600 );
+  assert( fd >= 0 );
+  return fd;
+}
+
+static void ut_writeKey( uint8_t fill ) {
+  uint8_t key[STORE_KEYSZ];
+  memset( key, fill, sizeof(key) );
+  FILE *fp = fopen( UTKEY, "wb" );
+  assert( fp != NULL );
+  UT_INTCMP( fwrite( key, 1, sizeof(key), fp ), sizeof(key) );
+  fclose( fp );
+}
+
+static int ut_getCmp( const char *refname, const char *exp ) {
+  char *str = NULL;
+  size_t strsz = 0;
+  if ( rdkconfig_getStr( &str, &strsz, refname ) != RDKCONFIG_OK ) return RDKCONFIG_FAIL;
+  int retval = ( strsz == strlen( exp ) + 1 && strcmp( str, exp ) == 0 ) ? RDKCONFIG_OK : RDKCONFIG_FAIL;
+  rdkconfig_freeStr( &str, strsz );
+  return retval;
+}
+
+static int utmain( int argc, char *argv[] ) {
+  fprintf( stderr, "\nUNIT TEST - rdkconfig store\n" );
+  setenv( STORE_PATH_ENV, UTSTORE, 1 );
+  setenv( STORE_KEYFILE_ENV, UTKEY, 1 );
+  setenv( STORE_KEYDESC_ENV, UTKEYDESC, 1 );
+  unlink( UTSTORE );
+  unlink( UTKEY );
+  uint8_t *buff = NULL;
+  size_t buffsz = 0;
+
+  fprintf( stderr, "UNIT TEST - no key, no store -- expect errors\n" );
+  UT_INTCMP( rdkconfig_set( "utstcreds", (uint8_t *)"secret", 6 ), RDKCONFIG_FAIL );
+  UT_DOESNTEXIST( UTSTORE );
+  ut_writeKey( 0x5a );
+  UT_INTCMP( rdkconfig_get( &buff, &buffsz, "utstcreds" ), RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_set( "", (uint8_t *)"secret", 6 ), RDKCONFIG_FAIL );
+  UT_INTCMP( rdkconfig_set( NULL, (uint8_t *)"secret", 6 ), RDKCONFIG_FAIL );
+
+  fprintf( stderr, "UNIT TEST - set and get\n" );
+  UT_INTCMP( rdkconfig_set( "utstcreds", (uint8_t *)"secret", 6 ), RDKCONFIG_OK );
+  UT_EXISTS( UTSTORE );
+  UT_INTCMP( rdkconfig_set( "utstcreds2", (uint8_t *)"secret2", 7 ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_set( "utstempty", NULL, 0 ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_get( &buff, &buffsz, "utstcreds" ), RDKCONFIG_OK );
+  UT_INTCMP( buffsz, 6 );
+  UT_INT0( memcmp( buff, "secret", 6 ) );
+  UT_INTCMP( rdkconfig_free( &buff, buffsz ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds2", "secret2" ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstempty", "" ), RDKCONFIG_OK );
+  uint8_t into[8];
+  UT_INTCMP( rdkconfig_getInto( "utstcreds2", into, sizeof(into), &buffsz ), RDKCONFIG_OK );
+  UT_INTCMP( buffsz, 7 );
+  UT_INT0( memcmp( into, "secret2", 7 ) );
+  UT_INTCMP( rdkconfig_getInto( "utstcreds2", into, 6, &buffsz ), RDKCONFIG_FAIL );
+  UT_INTCMP( buffsz, 7 );
+  UT_INTCMP( rdkconfig_getInto( "utstcreds3", into, sizeof(into), &buffsz ), RDKCONFIG_FAIL );
+  UT_INTCMP( buffsz, 0 );
+  UT_INTCMP( ut_getCmp( "utstcreds3", "" ), RDKCONFIG_FAIL );
+  UT_INTCMP( ut_getCmp( "utstcred", "" ), RDKCONFIG_FAIL );
+  const char *refnames[4] = { "utstcreds2", "utstcreds3", "utstempty", "utstcreds" };
+  rdkconfig_buf_t many[4];
+  UT_INTCMP( rdkconfig_getMany( refnames, 4, many ), RDKCONFIG_FAIL );
+  UT_INTCMP( many[0].status, RDKCONFIG_OK );
+  UT_INTCMP( many[0].len, 7 );
+  UT_INT0( strcmp( (char *)many[0].buf, "secret2" ) );
+  UT_INTCMP( many[1].status, RDKCONFIG_FAIL );
+  UT_INTCMP( (long)many[1].buf, 0 );
+  UT_INTCMP( many[2].status, RDKCONFIG_OK );
+  UT_INTCMP( many[2].len, 0 );
+  UT_INT0( strcmp( (char *)many[3].buf, "secret" ) );
+  UT_INTCMP( rdkconfig_freeMany( many, 4 ), RDKCONFIG_OK );
+  UT_INTCMP( (long)many[0].buf, 0 );
+  UT_INTCMP( rdkconfig_getMany( refnames + 2, 2, many ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_freeMany( many, 2 ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - replace\n" );
+  UT_INTCMP( rdkconfig_set( "utstcreds", (uint8_t *)"newsecret", 9 ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds2", "secret2" ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - many, index grows\n" );
+  char refname[32], data[32];
+  for ( int idx = 0; idx < UTMANY; idx++ ) {
+    snprintf( refname, sizeof(refname), "utstmany%d", idx );
+    snprintf( data, sizeof(data), "data%d", idx * 7 );
+    UT_INTCMP( rdkconfig_set( refname, (uint8_t *)data, strlen( data ) ), RDKCONFIG_OK );
+  }
+  for ( int idx = 0; idx < UTMANY; idx++ ) {
+    snprintf( refname, sizeof(refname), "utstmany%d", idx );
+    snprintf( data, sizeof(data), "data%d", idx * 7 );
+    UT_INTCMP( ut_getCmp( refname, data ), RDKCONFIG_OK );
+  }
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+
+  struct timespec ts0, ts1;
+  clock_gettime( CLOCK_MONOTONIC, &ts0 );
+  for ( int idx = 0; idx < UTGETS; idx++ ) {
+    UT_INTCMP( rdkconfig_get( &buff, &buffsz, "utstmany100" ), RDKCONFIG_OK );
+    rdkconfig_free( &buff, buffsz );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &ts1 );
+  fprintf( stderr, "UNIT TEST - %d gets, %ld ns/get\n", UTGETS,
+           ( ( ts1.tv_sec - ts0.tv_sec ) * 1000000000L + ( ts1.tv_nsec - ts0.tv_nsec ) ) / UTGETS );
+  clock_gettime( CLOCK_MONOTONIC, &ts0 );
+  for ( int idx = 0; idx < UTGETS; idx++ ) {
+    UT_INTCMP( rdkconfig_getInto( "utstmany100", (uint8_t *)data, sizeof(data), &buffsz ), RDKCONFIG_OK );
+  }
+  clock_gettime( CLOCK_MONOTONIC, &ts1 );
+  fprintf( stderr, "UNIT TEST - %d getIntos, %ld ns/getInto\n", UTGETS,
+           ( ( ts1.tv_sec - ts0.tv_sec ) * 1000000000L + ( ts1.tv_nsec - ts0.tv_nsec ) ) / UTGETS );
+  rdkconfigArenaCounters_t counters;
+  rdkconfig_getArenaCounters( &counters );
+  UT_INTCMP( counters.inUse, counters.arenaBytes ? 1 : 0 ); // key of the mapped store
+  fprintf( stderr, "UNIT TEST - arena allocs %lu, reuses %lu, heap %lu, high water %lu\n",
+           counters.arenaAllocs, counters.reuses, counters.heapAllocs, counters.highWater );
+
+  fprintf( stderr, "UNIT TEST - streamed, larger than memory buffers\n" );
+  uint8_t *big = malloc( UTBIG );
+  assert( big != NULL );
+  for ( size_t idx = 0; idx < UTBIG; idx++ ) big[idx] = (uint8_t)( idx * 31 + ( idx >> 12 ) );
+  int fd = ut_fileFd( UTPLAIN, O_RDWR|O_CREAT|O_TRUNC );
+  UT_INTCMP( write( fd, big, UTBIG ), UTBIG );
+  lseek( fd, 0, SEEK_SET );
+  UT_INTCMP( rdkconfig_setFromFd( "utstbig", fd ), RDKCONFIG_OK );
+  close( fd );
+  fd = ut_fileFd( UTPLAIN, O_RDWR|O_CREAT|O_TRUNC );
+  UT_INTCMP( rdkconfig_getToFd( "utstbig", fd ), RDKCONFIG_OK );
+  UT_INTCMP( lseek( fd, 0, SEEK_END ), UTBIG );
+  close( fd );
+  UT_INTCMP( rdkconfig_get( &buff, &buffsz, "utstbig" ), RDKCONFIG_OK );
+  UT_INTCMP( buffsz, UTBIG );
+  UT_INT0( memcmp( buff, big, UTBIG ) );
+  rdkconfig_free( &buff, buffsz );
+  UT_INTCMP( rdkconfig_set( "utstbig2", big, UTBIG ), RDKCONFIG_OK );
+  fd = ut_fileFd( UTPLAIN, O_RDWR|O_CREAT|O_TRUNC );
+  UT_INTCMP( rdkconfig_getToFd( "utstbig2", fd ), RDKCONFIG_OK );
+  UT_INTCMP( pread( fd, big, UTBIG, 0 ), UTBIG );
+  close( fd );
+  UT_INTCMP( rdkconfig_get( &buff, &buffsz, "utstbig2" ), RDKCONFIG_OK );
+  UT_INT0( memcmp( buff, big, UTBIG ) );
+  rdkconfig_free( &buff, buffsz );
+  free( big );
+  UT_INTCMP( rdkconfig_getToFd( "utstbig3", STDOUT_FILENO ), RDKCONFIG_FAIL );
+
+  fprintf( stderr, "UNIT TEST - set many in one update -- expect errors\n" );
+  fd = ut_fileFd( UTPLAIN, O_RDWR|O_CREAT|O_TRUNC );
+  UT_INTCMP( write( fd, "batch1", 6 ), 6 );
+  close( fd );
+  const char *setnames[5] = { "utstbatch1", "utstbatch2", "utstbatch1", "utstbatch3", "utstcreds" };
+  int setfds[5], setstatus[5];
+  setfds[0] = ut_fileFd( UTPLAIN, O_RDONLY );
+  setfds[1] = ut_fileFd( "./ut/tmp", O_RDONLY ); // a directory, can't be read
+  setfds[2] = ut_fileFd( UTPLAIN, O_RDONLY );
+  setfds[3] = -1;
+  setfds[4] = ut_fileFd( UTPLAIN, O_RDONLY );
+  UT_INTCMP( rdkconfig_setManyFromFd( setnames, setfds, 5, setstatus ), RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[0], RDKCONFIG_OK );
+  UT_INTCMP( setstatus[1], RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[2], RDKCONFIG_FAIL ); // listed twice
+  UT_INTCMP( setstatus[3], RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[4], RDKCONFIG_OK );
+  for ( int idx = 0; idx < 5; idx++ ) {
+    if ( setfds[idx] >= 0 ) close( setfds[idx] );
+  }
+  UT_INTCMP( ut_getCmp( "utstbatch1", "batch1" ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds", "batch1" ), RDKCONFIG_OK ); // replaced
+  UT_INTCMP( ut_getCmp( "utstbatch2", "" ), RDKCONFIG_FAIL );
+  UT_INTCMP( ut_getCmp( "utstmany100", "data700" ), RDKCONFIG_OK );
+  UT_INTCMP( rdkconfig_set( "utstcreds", (uint8_t *)"newsecret", 9 ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+  // a replace that can't be sealed keeps the old record, while the rest of the batch is stored
+  const char *keepnames[2] = { "utstcreds", "utstbatch4" };
+  setfds[0] = ut_fileFd( "./ut/tmp", O_RDONLY ); // a directory, can't be read
+  setfds[1] = ut_fileFd( UTPLAIN, O_RDONLY );
+  UT_INTCMP( rdkconfig_setManyFromFd( keepnames, setfds, 2, setstatus ), RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[0], RDKCONFIG_FAIL );
+  UT_INTCMP( setstatus[1], RDKCONFIG_OK );
+  close( setfds[0] );
+  close( setfds[1] );
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstbatch4", "batch1" ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - tampered store -- expect errors\n" );
+  pthread_mutex_lock( &store_mutex );
+  UT_INTCMP( store_map(), RDKCONFIG_OK );
+  const storerec_t *rec = store_find( store_cache.map, "utstcreds2" );
+  assert( rec != NULL );
+  off_t recoff = (const uint8_t *)rec - store_cache.map;
+  uint32_t namelen = rec->namelen;
+  store_unmap();
+  pthread_mutex_unlock( &store_mutex );
+  fd = open( UTSTORE, O_RDWR );
+  assert( fd >= 0 );
+  uint8_t byte;
+  off_t cipheroff = recoff + sizeof(storerec_t) + namelen;
+  UT_INTCMP( pread( fd, &byte, 1, cipheroff ), 1 );
+  byte ^= 1;
+  UT_INTCMP( pwrite( fd, &byte, 1, cipheroff ), 1 );
+  close( fd );
+  UT_INTCMP( ut_getCmp( "utstcreds2", "secret2" ), RDKCONFIG_FAIL );
+  memset( into, 'x', sizeof(into) );
+  UT_INTCMP( rdkconfig_getInto( "utstcreds2", into, sizeof(into), &buffsz ), RDKCONFIG_FAIL );
+  UT_INTCMP( into[0], 0 ); // wiped
+  fd = ut_fileFd( UTPLAIN, O_RDWR|O_CREAT|O_TRUNC );
+  UT_INTCMP( rdkconfig_getToFd( "utstcreds2", fd ), RDKCONFIG_FAIL );
+  UT_INTCMP( lseek( fd, 0, SEEK_END ), 0 ); // nothing written
+  close( fd );
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - wrong key -- expect errors\n" );
+  struct stat st0, st1;
+  UT_INT0( stat( UTSTORE, &st0 ) );
+  ut_writeKey( 0xa5 );
+  UT_INTCMP( rdkconfig_set( "utstcreds3", (uint8_t *)"secret3", 7 ), RDKCONFIG_FAIL ); // not sealed with two keys
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_FAIL );
+  UT_INTCMP( ut_getCmp( "utstcreds3", "secret3" ), RDKCONFIG_FAIL );
+  UT_INT0( stat( UTSTORE, &st1 ) );
+  UT_INTCMP( st1.st_ino, st0.st_ino ); // store not replaced
+  ut_writeKey( 0x5a );
+  UT_INTCMP( rdkconfig_set( "utstcreds3", (uint8_t *)"secret3", 7 ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds", "newsecret" ), RDKCONFIG_OK );
+  UT_INTCMP( ut_getCmp( "utstcreds3", "secret3" ), RDKCONFIG_OK );
+
+  fprintf( stderr, "UNIT TEST - key from keyring\n" );
+  uint8_t key[STORE_KEYSZ];
+  memset( key, 0x5a, sizeof(key) );
+  long keyid = syscall( SYS_add_key, "user", UTKEYDESC, key, sizeof(key), KEY_SPEC_PROCESS_KEYRING );
+  if ( keyid >= 0 ) {
+    unlink( UTKEY );
+    UT_INTCMP( rdkconfig_set( "utstcreds4", (uint8_t *)"secret4", 7 ), RDKCONFIG_OK );
+    UT_INTCMP( ut_getCmp( "utstcreds3", "secret3" ), RDKCONFIG_OK );
+    UT_INTCMP( ut_getCmp( "utstcreds4", "secret4" ), RDKCONFIG_OK );
+    syscall( SYS_keyctl, KEYCTL_INVALIDATE, keyid );
+  } else {
+    fprintf( stderr, "UNIT TEST - no keyring, skipped\n" );
+  }
+
+  unlink( UTSTORE );
+  unlink( UTKEY );
+  unlink( UTSTORE ".lock" );
+  unlink( UTPLAIN );
+  fprintf( stderr, "UNIT TEST - rdkconfig store - SUCCESS\n" );
+  return 0;
+}
+
+#endif // UNIT_TESTS
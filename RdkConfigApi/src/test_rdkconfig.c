@@ -24,11 +24,13 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "rdkconfig.h"
+#include "rdkconfig_arena.h"
 
 /*
  Contract:
  - rdkconfig_get: allocate buffer with exact data length and return RDKCONFIG_OK
- - rdkconfig_getStr: allocate buffer including null terminator (via strdup) and return RDKCONFIG_OK
+ - rdkconfig_getStr: allocate buffer including null terminator and return RDKCONFIG_OK
+ - buffers come from the rdkconfig arena, see rdkconfig_arena.h
  - Caller must free with rdkconfig_free / rdkconfig_freeStr
  - On error, return RDKCONFIG_FAIL and do not modify outputs
 */
@@ -41,7 +43,7 @@ int rdkconfig_get(uint8_t **sbuff, size_t *sbuffsz, const char *refname) {
         return RDKCONFIG_FAIL;
     }
     size_t value_len = strlen(kTestValue);
-    uint8_t *out_buffer = (uint8_t *)malloc(value_len);
+    uint8_t *out_buffer = (uint8_t *)rdkconfig_arenaAlloc(value_len);
     if (!out_buffer) {
         return RDKCONFIG_FAIL;
     }
@@ -56,10 +58,11 @@ int rdkconfig_getStr(char **strbuff, size_t *strbuffsz, const char *refname) {
     if (!strbuff || !strbuffsz) {
         return RDKCONFIG_FAIL;
     }
-    char *out_string = strdup(kTestValue);
+    char *out_string = (char *)rdkconfig_arenaAlloc(strlen(kTestValue) + 1);
     if (!out_string) {
         return RDKCONFIG_FAIL;
     }
+    strcpy(out_string, kTestValue);
     *strbuff = out_string;
     *strbuffsz = strlen(kTestValue) + 1;
     return RDKCONFIG_OK;
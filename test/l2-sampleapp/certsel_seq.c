@@ -31,9 +31,12 @@ typedef struct rdkcertselector_s {
   char certCredRef[PARAM_MAX+1];
   char certPass[PARAM_MAX+1];
   char hrotEngine[ENGINE_MAX+1];
-  uint16_t certIndx;
+  uint32_t certIndx;
   uint16_t state;
-  unsigned long certStat[LIST_MAX];  // 0 if ok, file date if cert found to be bad
+  uint32_t certStatCnt;
+  unsigned long *certStat;  // per candidate, 0 if ok, file date if cert found to be bad
+  void *certPrint;          // per candidate, fingerprint of the cert when marked bad
+  void *certTable;
   long reserved1;
 } rdkcertselector_t;
 
@@ -87,7 +90,7 @@ int run_seq3cs()
         L2_TST( certGetAndSet( seq3cs, CURL_SUCCESS, FILESCHEME UTCERT2, UTPASS2, NO_RETRY ) );
         //first renewed, uses first
         sleep( 1 ); // delay so file time is "old"
-        UT_SYSTEM0( "touch " UTCERT1 ); // first renewed
+        UT_SYSTEM0( "echo renewed >> " UTCERT1 ); // first renewed, content changed
         L2_TST( certGetAndSet( seq3cs, CURL_SUCCESS, FILESCHEME UTCERT1, UTPASS1, NO_RETRY ) );
         //uses first
         L2_TST( certGetAndSet( seq3cs, CURL_SUCCESS, FILESCHEME UTCERT1, UTPASS1, NO_RETRY ) );
@@ -107,7 +110,7 @@ int run_seq4cs()
         L2_TST( certGetAndSet( seq4cs, CURLERR_LOCALCERT, FILESCHEME UTCERT2, UTPASS2, TRY_ANOTHER ) );
         L2_TST( certGetAndSet( seq4cs, CURL_SUCCESS, FILESCHEME UTCERT3, UTPASS3, NO_RETRY ) );
         // 2) second restored, use second
-        UT_SYSTEM0( "touch " UTCERT2 );
+        UT_SYSTEM0( "echo renewed >> " UTCERT2 );
         L2_TST( certGetAndSet( seq4cs, CURL_SUCCESS, FILESCHEME UTCERT2, UTPASS2, NO_RETRY ) );
         // 3) next try skips first, uses second
         L2_TST( certGetAndSet( seq4cs, CURL_SUCCESS, FILESCHEME UTCERT2, UTPASS2, NO_RETRY ) );
@@ -161,7 +164,7 @@ int run_seq6cs()
         L2_TST(certGetAndSet(seq6cs, CURL_SUCCESS, FILESCHEME UTCERT3, UTPASS3, NO_RETRY ));
 
         sleep( 1 );
-        UT_SYSTEM0( "touch " UTCERT1 ); //first renewed				
+        UT_SYSTEM0( "echo renewed >> " UTCERT1 ); //first renewed				
         L2_TST(certGetAndSet( seq6cs, CURL_SUCCESS, FILESCHEME UTCERT1, UTPASS1, NO_RETRY ) );
 
         rdkcertselector_free( &seq6cs );
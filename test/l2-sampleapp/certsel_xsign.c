@@ -261,7 +261,7 @@ int run_seq15cs()
  * Step 1: noresponder → CERTSTATUS(91) / TRY_ANOTHER
  * Step 2: fallback to valid cert → SUCCESS / NO_RETRY
  * Step 3: noresponder stays skipped → valid cert reused
- * Step 4: touch noresponder file (simulates cert renewal after responder recovery)
+ * Step 4: rewrite noresponder file (simulates cert renewal after responder recovery)
  * Step 5: noresponder cert reused → SUCCESS / NO_RETRY
  * ──────────────────────────────────────────────────────────────────────────*/
 int run_seq16cs()
@@ -277,9 +277,9 @@ int run_seq16cs()
         /* noresponder cert still skipped */
         L2_TST(certGetAndSet(seq16cs, CURL_SUCCESS, FILESCHEME OCSPCERT_VALID, OCSPPASS_VALID, NO_RETRY));
 
-        /* responder recovers — simulate cert renewal by updating file timestamp */
+        /* responder recovers — simulate cert renewal by changing the file content */
         sleep(1);
-        UT_SYSTEM0("touch " OCSPCERT_NORESP);
+        UT_SYSTEM0("echo renewed >> " OCSPCERT_NORESP);
 
         /* noresponder cert is now fresh — selector reselects it */
         L2_TST(certGetAndSet(seq16cs, CURL_SUCCESS, FILESCHEME OCSPCERT_NORESP, OCSPPASS_NORESP, NO_RETRY));
@@ -300,7 +300,7 @@ int run_seq16cs()
  * Step 2: bridge expires mid-session       → ISSUER(80) / TRY_ANOTHER
  * Step 3: fallback to new-root cert        → SUCCESS / NO_RETRY
  * Step 4: expxs cert stays skipped         → new-root cert reused
- * Step 5: touch expxs (simulate reissuance of bundle with fresh bridge)
+ * Step 5: rewrite expxs (simulate reissuance of bundle with fresh bridge)
  * Step 6: expxs cert freshened             → SUCCESS / NO_RETRY
  * ──────────────────────────────────────────────────────────────────────────*/
 int run_seq17cs()
@@ -321,7 +321,7 @@ int run_seq17cs()
 
         /* simulate bundle reissuance with fresh bridge */
         sleep(1);
-        UT_SYSTEM0("touch " XSCERT_EXPXS);
+        UT_SYSTEM0("echo renewed >> " XSCERT_EXPXS);
 
         /* expxs cert freshened — reselected */
         L2_TST(certGetAndSet(seq17cs, CURL_SUCCESS, FILESCHEME XSCERT_EXPXS, XSPASS_EXPXS, NO_RETRY));
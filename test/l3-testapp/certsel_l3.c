@@ -21,7 +21,7 @@
  *
  * Unlike the L2 sampleapp (which feeds synthetic curl error codes),
  * this testapp makes real TLS connections using libcurl.  The cert-selector
- * API (rdkcertselector_getCert / rdkcertselector_setCurlStatus) is exercised
+ * API (rdkcertselector_perform, over getCert / setCurlStatus) is exercised
  * with the actual CURLcode returned by the live handshake, validating the
  * full stack: certsel → libcurl → mock-xconf TLS server.
  *
@@ -36,17 +36,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <curl/curl.h>
 
-/* curl/curl.h transitively includes <linux/limits.h>, which defines PATH_MAX
- * as 4096.  rdkcertselector.h redefines PATH_MAX as 128 for its own object
- * length limits.  Drop the system definition here so the header's redefinition
- * is clean and does not trip -Werror.  This keeps the fix local to the L3
- * testapp and leaves the shared production header (and the L1 gtest build)
- * untouched. */
-#undef PATH_MAX
-
-#include "../../CertSelector/include/rdkcertselector.h"
+/* rdkcertselector_curl.h includes curl/curl.h and drops its PATH_MAX before
+ * rdkcertselector.h redefines it for its own object length limits. */
+#include "../../CertSelector/include/rdkcertselector_curl.h"
 #include "certsel_l3.h"
 
 /* ── rdkconfig mock ─────────────────────────────────────────────────────────
@@ -94,21 +87,24 @@ static size_t discard_cb(void *ptr, size_t size, size_t nmemb, void *userdata)
 }
 
 /*
- * do_mtls_curl() — perform a real mTLS connection using a PKCS#12 client cert.
+ * do_mtls_curl() — perform a real mTLS connection with the client certs
+ * selected by certsel.
  *
  * The server certificate is verified against the system trust store (updated by
  * native-platform/certs.sh with Test-CRL-Root and Test-XS-NewRoot).
+ * rdkcertselector_perform() applies a cert and its passphrase to the handle,
+ * performs the request, feeds the CURLcode back to certsel and tries the next
+ * cert of the group after a cert error, on the same handle.
  *
+ * @param cs           Cert selector handle
  * @param url          Target HTTPS URL
- * @param p12_path     Absolute path to PKCS#12 bundle (no "file://" prefix)
- * @param pass         PKCS#12 passphrase
  * @param ocsp_check   Non-zero to request OCSP stapling verification
  *
- * Returns the raw CURLcode (CURLE_OK == 0 means the handshake and request
- * succeeded; any other value means failure).
+ * Returns the raw CURLcode of the last attempt (CURLE_OK == 0 means the
+ * handshake and request succeeded; any other value means failure).
  */
-static unsigned int do_mtls_curl(const char *url, const char *p12_path,
-                                  const char *pass, int ocsp_check)
+static unsigned int do_mtls_curl(rdkcertselector_h cs, const char *url,
+                                  int ocsp_check)
 {
     CURL *curl = curl_easy_init();
     if (!curl) {
@@ -117,19 +113,22 @@ static unsigned int do_mtls_curl(const char *url, const char *p12_path,
     }
 
     curl_easy_setopt(curl, CURLOPT_URL,           url);
-    curl_easy_setopt(curl, CURLOPT_SSLCERT,       p12_path);
-    curl_easy_setopt(curl, CURLOPT_SSLCERTTYPE,   "P12");
-    curl_easy_setopt(curl, CURLOPT_KEYPASSWD,     pass);
     curl_easy_setopt(curl, CURLOPT_FAILONERROR,   1L);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discard_cb);
     if (ocsp_check)
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYSTATUS, 1L);
 
-    CURLcode rc = curl_easy_perform(curl);
+    long http_code = 0;
+    CURLcode rc = rdkcertselector_perform(cs, curl, &http_code);
     if (rc != CURLE_OK)
         fprintf(stderr, "[l3] curl error %u: %s\n",
                 (unsigned int)rc, curl_easy_strerror(rc));
 
+    rdkcertselectorPerformCounters_t perf;
+    rdkcertselector_getPerformCounters(&perf);
+    fprintf(stdout, "[l3] http=%ld attempts=%lu retries=%lu max_attempt_us=%lu\n",
+            http_code, perf.attempts, perf.retries, perf.maxAttemptUsec);
+
     curl_easy_cleanup(curl);
     return (unsigned int)rc;
 }
@@ -137,9 +136,10 @@ static unsigned int do_mtls_curl(const char *url, const char *p12_path,
 /* ── Generic certsel + libcurl scenario ─────────────────────────────────────
  *
  * 1. rdkcertselector_new()  — reads @cfg, locates first cert for @group.
- * 2. rdkcertselector_getCert() — returns cert URI ("file:///...") and password.
- * 3. do_mtls_curl()         — makes the real TLS connection.
- * 4. rdkcertselector_setCurlStatus() — feeds the real CURLcode back to certsel.
+ * 2. do_mtls_curl()         — makes the real TLS connection with
+ *                             rdkcertselector_perform(), which applies the cert,
+ *                             feeds the real CURLcode back to certsel and retries
+ *                             with the next cert after a cert error.
  *
  * Returns the raw CURLcode from libcurl (CURLE_OK == 0 on success) so the
  * Python driver can assert on the specific error code.
@@ -153,28 +153,12 @@ static int run_l3_scenario(const char *cfg, const char *hrot,
         return 1;
     }
 
-    char *uri  = NULL;
-    char *pass = NULL;
-    rdkcertselectorStatus_t st = rdkcertselector_getCert(cs, &uri, &pass);
-    if (st != certselectorOk) {
-        fprintf(stderr, "[l3] getCert failed: %d (cfg=%s grp=%s)\n",
-                (int)st, cfg, group);
-        rdkcertselector_free(&cs);
-        return 1;
-    }
+    fprintf(stdout, "[l3] connecting: url=%s cfg=%s grp=%s\n", url, cfg, group);
 
-    /* certsel returns the URI with the "file://" scheme; strip it for libcurl */
-    const char *p12_path = uri;
-    if (strncmp(uri, "file://", 7) == 0)
-        p12_path = uri + 7;
-
-    fprintf(stdout, "[l3] connecting: url=%s cert=%s\n", url, p12_path);
-
-    unsigned int curl_rc = do_mtls_curl(url, p12_path, pass, 0 /* no OCSP */);
+    unsigned int curl_rc = do_mtls_curl(cs, url, 0 /* no OCSP */);
     fprintf(stdout, "[l3] curl rc=%u (%s)\n", curl_rc,
             curl_rc == 0 ? "CURLE_OK" : curl_easy_strerror((CURLcode)curl_rc));
 
-    rdkcertselector_setCurlStatus(cs, curl_rc, url);
     rdkcertselector_free(&cs);
 
     /* Return the raw CURLcode so the Python driver can assert on the specific
@@ -252,29 +236,9 @@ int run_l3_ocsp_nostaple(void)
         return 1;
     }
 
-    char *uri = NULL, *pass = NULL;
-    if (rdkcertselector_getCert(cs, &uri, &pass) != certselectorOk) {
-        rdkcertselector_free(&cs);
-        return 1;
-    }
-    const char *p12_path = (strncmp(uri, "file://", 7) == 0) ? uri + 7 : uri;
-
-    CURL *curl = curl_easy_init();
-    if (!curl) { rdkcertselector_free(&cs); return 1; }
+    unsigned int rc = do_mtls_curl(cs, L3_MTLS_URL, 1 /* OCSP */);
+    fprintf(stdout, "[l3] ocsp_nostaple rc=%u (expected non-zero)\n", rc);
 
-    curl_easy_setopt(curl, CURLOPT_URL,               L3_MTLS_URL);
-    curl_easy_setopt(curl, CURLOPT_SSLCERT,           p12_path);
-    curl_easy_setopt(curl, CURLOPT_SSLCERTTYPE,       "P12");
-    curl_easy_setopt(curl, CURLOPT_KEYPASSWD,         pass);
-    curl_easy_setopt(curl, CURLOPT_FAILONERROR,        1L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYSTATUS,   1L);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,      discard_cb);
-
-    CURLcode rc = curl_easy_perform(curl);
-    fprintf(stdout, "[l3] ocsp_nostaple rc=%u (expected non-zero)\n", (unsigned int)rc);
-
-    rdkcertselector_setCurlStatus(cs, (unsigned int)rc, L3_MTLS_URL);
-    curl_easy_cleanup(curl);
     rdkcertselector_free(&cs);
 
     /* Return the raw CURLcode; the negative control expects a non-zero